@@ -0,0 +1,51 @@
+// Luzes point/spot em clusters (LightClusters no CPU). Incluir no .pxs de um
+// material iluminado e somar ClusteredLighting(...) a
+// DirectionalLighting (scene_lights.hlsli).
+//
+// O vertex shader precisa passar a posicao e a normal em view space; screenUV
+// e a posicao do fragmento na tela em [0, 1], origem embaixo a esquerda (GL).
+#ifndef CLUSTERED_LIGHTING_HLSLI
+#define CLUSTERED_LIGHTING_HLSLI
+
+cbuffer ClusterData : register(b3) {
+    uint4 ClusterGridSize; // x, y, z, numero de luzes
+    float4 ClusterDepth;   // near, far, escala e bias do slice
+};
+
+// 3 texels por luz: (posicao, alcance) (cor * intensidade, cos interno) (direcao, cos externo)
+Buffer<float4> ClusterLights : register(t4);
+Buffer<uint2> ClusterGrid : register(t5); // (offset, count) em ClusterLightIndices
+Buffer<uint> ClusterLightIndices : register(t6);
+
+float3 ClusteredLighting(float3 viewPosition, float3 viewNormal, float2 screenUV) {
+    float3 result = float3(0.0, 0.0, 0.0);
+    if (ClusterGridSize.w == 0) return result;
+
+    // Mesmo slice exponencial do CPU: log(z) * escala + bias
+    float depth = max(-viewPosition.z, ClusterDepth.x);
+    uint slice = (uint)clamp(log(depth) * ClusterDepth.z + ClusterDepth.w, 0.0,
+                             (float)(ClusterGridSize.z - 1));
+    uint2 tile = min((uint2)(saturate(screenUV) * ClusterGridSize.xy), ClusterGridSize.xy - 1);
+    uint2 cluster = ClusterGrid[(slice * ClusterGridSize.y + tile.y) * ClusterGridSize.x + tile.x];
+
+    float3 normal = normalize(viewNormal);
+    for (uint i = 0; i < cluster.y; i++) {
+        uint light = ClusterLightIndices[cluster.x + i] * 3;
+        float4 positionRange = ClusterLights[light];
+        float4 colorCosInner = ClusterLights[light + 1];
+        float4 directionCosOuter = ClusterLights[light + 2];
+
+        float3 toLight = positionRange.xyz - viewPosition;
+        float distance = length(toLight);
+        float3 direction = toLight / max(distance, 0.0001);
+
+        // Cai a zero no alcance; point tem cone de -1, entao o smoothstep da 1
+        float falloff = saturate(1.0 - distance / positionRange.w);
+        float cone = smoothstep(directionCosOuter.w, colorCosInner.w,
+                                dot(-direction, directionCosOuter.xyz));
+        result += colorCosInner.rgb * saturate(dot(normal, direction)) * falloff * falloff * cone;
+    }
+    return result;
+}
+
+#endif // CLUSTERED_LIGHTING_HLSLI
@@ -0,0 +1,186 @@
+// Carga de imagens: caminho antigo (stbi_load com 4 canais, uma imagem por vez,
+// copia para o buffer de upload) contra o ImagePipeline (um job por imagem,
+// conversao SIMD em faixas de linhas direto no destino), para um skybox de 6
+// faces RGB e um atlas RGBA, com 1..N threads. Depois, as conversoes isoladas
+// com e sem SIMD.
+//
+// Uso: image_bench [--size N] [--runs R] [--premultiply]
+#define CLASS_NAME "ImageBench"
+#include "log_macros.hpp"
+
+#include "image_pipeline.hpp"
+#include "job_system.hpp"
+#include "renderer/image_writer.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Ruido suave: o PNG e "stored", entao o conteudo nao muda o custo do inflate
+std::vector<uint8_t> makePixels(int size, int channels, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> pixels((size_t)size * size * channels);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            uint8_t* p = &pixels[((size_t)y * size + x) * channels];
+            p[0] = (uint8_t)(x * 255 / size);
+            p[1] = (uint8_t)(y * 255 / size);
+            p[2] = (uint8_t)(rng() & 0xFF);
+            if (channels == 4) p[3] = (uint8_t)((x ^ y) & 0xFF);
+        }
+    }
+    return pixels;
+}
+
+struct ImageSet {
+    const char* name;
+    std::vector<std::string> paths;
+    std::vector<std::vector<uint8_t>> destinations; // faz o papel do PBO / staging
+};
+
+ImageSet makeSet(const char* name, const std::string& dir, int count, int size, int channels) {
+    ImageSet set{name, {}, {}};
+    for (int i = 0; i < count; i++) {
+        std::string path = dir + "/" + name + std::to_string(i) + ".png";
+        ImageWriter::writePNG(path, size, size, makePixels(size, channels, (uint32_t)i), channels);
+        set.paths.push_back(path);
+        set.destinations.emplace_back((size_t)size * size * 4);
+    }
+    return set;
+}
+
+double legacyLoad(ImageSet& set) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < set.paths.size(); i++) {
+        int w, h, channels;
+        unsigned char* data = stbi_load(set.paths[i].c_str(), &w, &h, &channels, 4);
+        if (!data) std::exit(1);
+        std::memcpy(set.destinations[i].data(), data, (size_t)w * h * 4);
+        stbi_image_free(data);
+    }
+    return msSince(start);
+}
+
+double pipelineLoad(ImageSet& set, const ImagePipeline::ConvertOptions& options,
+                    Yume::JobSystem* jobs) {
+    auto start = Clock::now();
+    std::vector<ImagePipeline::DecodeTarget> targets(set.paths.size());
+    for (size_t i = 0; i < targets.size(); i++) {
+        targets[i].path = set.paths[i];
+        ImagePipeline::probe(targets[i].path, targets[i].info);
+        targets[i].pixels = set.destinations[i].data();
+    }
+    if (ImagePipeline::decode(targets, options, jobs) != targets.size()) std::exit(1);
+    return msSince(start);
+}
+
+template <typename Fn> double best(int runs, Fn&& fn) {
+    double result = 1e30;
+    for (int i = 0; i < runs; i++) result = std::min(result, fn());
+    return result;
+}
+
+// GB/s de pixels RGBA processados
+template <typename Fn> double throughput(size_t pixels, int runs, Fn&& fn) {
+    double ms = best(runs, [&] {
+        auto start = Clock::now();
+        fn();
+        return msSince(start);
+    });
+    return pixels * 4.0 / (ms * 1e6);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int size = 1024;
+    int runs = 5;
+    ImagePipeline::ConvertOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = std::max(16, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--premultiply") == 0) {
+            options.premultiplyAlpha = true;
+        }
+    }
+
+    std::string dir = (std::filesystem::temp_directory_path() / "yume_image_bench").string();
+    std::filesystem::create_directories(dir);
+    std::vector<ImageSet> sets;
+    sets.push_back(makeSet("skybox_face", dir, 6, size, 3));
+    sets.push_back(makeSet("atlas", dir, 1, size * 2, 4));
+
+    unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int t = 1; t < hardware; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(hardware);
+
+    std::printf("%-12s %-22s %8s %10s %8s\n", "set", "path", "threads", "ms", "speedup");
+    for (auto& set : sets) {
+        // Aquecimento: o primeiro free de um bloco grande muda o limiar de mmap do
+        // malloc, e quem rodasse primeiro pagaria os page faults sozinho
+        legacyLoad(set);
+        pipelineLoad(set, options, nullptr);
+
+        double legacy = best(runs, [&] { return legacyLoad(set); });
+        std::printf("%-12s %-22s %8d %10.2f %8s\n", set.name, "stbi_load (legacy)", 1, legacy,
+                    "1.00x");
+
+        for (unsigned int threads : threadCounts) {
+            // init(0) usaria todos os cores; 1 thread e sem job system
+            Yume::JobSystem jobs;
+            if (threads > 1) jobs.init(threads - 1);
+            Yume::JobSystem* pool = threads > 1 ? &jobs : nullptr;
+            double ms = best(runs, [&] { return pipelineLoad(set, options, pool); });
+            std::printf("%-12s %-22s %8u %10.2f %7.2fx\n", set.name, "ImagePipeline", threads, ms,
+                        legacy / ms);
+            jobs.shutdown();
+        }
+    }
+
+    size_t pixels = (size_t)size * size;
+    std::vector<uint8_t> rgb = makePixels(size, 3, 7);
+    std::vector<uint8_t> rgba = makePixels(size, 4, 7);
+    std::vector<uint8_t> scratch(pixels * 4);
+
+    std::printf("\n%-26s %10s %10s\n", "conversion", "scalar", "simd");
+    double gbs[2][3];
+    for (int simd = 0; simd < 2; simd++) {
+        ImagePipeline::setSimdEnabled(simd == 1);
+        gbs[simd][0] = throughput(pixels, runs, [&] {
+            ImagePipeline::expandRGBToRGBA(rgb.data(), scratch.data(), pixels);
+        });
+        gbs[simd][1] = throughput(pixels, runs, [&] {
+            scratch = rgba;
+            ImagePipeline::premultiplyAlpha(scratch.data(), pixels, false);
+        });
+        gbs[simd][2] = throughput(pixels, runs, [&] {
+            scratch = rgba;
+            ImagePipeline::premultiplyAlpha(scratch.data(), pixels, true);
+        });
+    }
+    const char* names[3] = {"RGB -> RGBA", "premultiply", "premultiply (sRGB)"};
+    for (int i = 0; i < 3; i++) {
+        std::printf("%-26s %7.2f GB/s %7.2f GB/s\n", names[i], gbs[0][i], gbs[1][i]);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
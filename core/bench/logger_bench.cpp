@@ -0,0 +1,93 @@
+// Custo por chamada do logger: caminho antigo (mutex + put_time + endl por linha)
+// contra o logger assincrono, com e sem filtragem em tempo de compilacao.
+#define CLASS_NAME "LoggerBench"
+#include "log_macros.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int ITERATIONS = 200000;
+
+// Copia do Logger::log original, para comparacao
+std::ofstream g_legacyFile;
+std::mutex g_legacyMutex;
+
+void legacyLog(const char* className, const char* methodName, const char* message) {
+    std::lock_guard<std::mutex> lock(g_legacyMutex);
+    auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm{};
+    localtime_r(&time, &tm);
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    g_legacyFile << "[" << oss.str() << "] "
+                 << "[" << className << "::" << methodName << "] " << message << std::endl;
+}
+
+// Mede so o tempo das chamadas: a cada BURST chamadas espera o writer esvaziar
+// os rings (fora da medicao), para que nenhuma mensagem seja descartada.
+template <typename Fn> double nsPerCall(int threads, bool flushBursts, Fn&& fn) {
+    constexpr int BURST = (int)Logger::RING_CAPACITY / 2;
+    std::vector<double> totals(threads, 0.0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < ITERATIONS; i += BURST) {
+                auto start = std::chrono::steady_clock::now();
+                for (int j = i; j < i + BURST && j < ITERATIONS; j++) fn(t, j);
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                totals[t] += std::chrono::duration<double, std::nano>(elapsed).count();
+                if (flushBursts) Logger::flush();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    double total = 0.0;
+    for (double v : totals) total += v;
+    return total / ((double)ITERATIONS * threads);
+}
+
+void report(const char* name, int threads, double ns) {
+    std::printf("%-28s %2d thread(s) %10.1f ns/call\n", name, threads, ns);
+}
+
+} // namespace
+
+int main() {
+    std::filesystem::create_directories("logs");
+    g_legacyFile.open("logs/logger_bench_legacy.log", std::ios::out | std::ios::trunc);
+    Logger::init("logger_bench");
+
+    for (int threads : {1, 4}) {
+        report("legacy (string + endl)", threads, nsPerCall(threads, false, [](int t, int i) {
+                   legacyLog(CLASS_NAME, "main",
+                             (std::string("[INFO] ") + "Drawing sprite " + std::to_string(i) +
+                              " on thread " + std::to_string(t))
+                                 .c_str());
+               }));
+
+        report("async LOG_INFO", threads, nsPerCall(threads, true, [](int t, int i) {
+                   LOG_INFO("Drawing sprite %d on thread %d", i, t);
+               }));
+
+        report("LOG_DEBUG (compiled out)", threads, nsPerCall(threads, false, [](int t, int i) {
+                   LOG_DEBUG("Drawing sprite %d on thread %d", i, t);
+                   (void)t;
+                   (void)i;
+               }));
+    }
+
+    std::printf("dropped: %llu\n", (unsigned long long)Logger::getDroppedCount());
+    Logger::shutdown();
+    return 0;
+}
@@ -0,0 +1,541 @@
+// Benchmark headless do pipeline de frame completo (update de transforms,
+// culling, montagem da fila e submissao) sobre uma cena sintetica
+// reproduzivel. Imprime os tempos de frame como JSON para comparar commits.
+//
+// yume_bench --api opengl|vulkan|null --objects N --meshes M --materials K --sprites S
+//            [--frames F] [--warmup W] [--width W --height H] [--seed X]
+//            [--vs name.vxs --fs name.pxs] [--features LIT,TEXTURED] [--sprite-vs .. --sprite-fs .. --sprite-texture ..]
+//            [--no-cull] [--threads T] [--render-thread] [--texture-budget-mb MB]
+//            [--lights L] [--shadows C]
+//            [--out file.json]
+//            [--expect-draws N] [--expect-hash HEX] [--dump-commands file.ycmd]
+//            [--expect-no-allocs]
+//
+// Com --api null nao precisa de GPU nem de shaders compilados; as opcoes
+// --expect-* fazem o processo sair com codigo 3 quando o ultimo frame nao
+// bate (ou, com --expect-no-allocs, quando algum frame medido usou o heap
+// geral), para uso como teste de regressao em CI.
+#define CLASS_NAME "YumeBench"
+#include "log_macros.hpp"
+
+#include "camera.hpp"
+#include "frame_memory.hpp"
+#include "game_object.hpp"
+#include "job_system.hpp"
+#include "light.hpp"
+#include "logger.hpp"
+#include "material.hpp"
+#include "renderer/backends/null/null_renderer_backend.hpp"
+#include "renderer/render_thread.hpp"
+#include "renderer/renderer.hpp"
+#include "scene.hpp"
+#include "shader_cache.hpp"
+#include "stats.hpp"
+#include "texture_manager.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Conta toda alocacao do heap geral do processo (todos os threads), para
+// conferir que frames em regime nao alocam fora das arenas
+static std::atomic<uint64_t> g_heapAllocations{0};
+
+void* operator new(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Options {
+    GraphicsAPI api = GraphicsAPI::OPENGL;
+    const char* apiName = "opengl";
+    int objects = 1000;
+    int meshes = 8;
+    int materials = 4;
+    int sprites = 0;
+    int lights = 0; // point/spot dinamicos, alem da direcional
+    int shadowCascades = 0; // cascatas da direcional; 0 = sem sombra
+    int frames = 600;
+    int warmup = 60;
+    int width = 1280;
+    int height = 720;
+    unsigned int seed = 1;
+    int threads = 0; // 0 = todos os nucleos, 1 = sem workers
+    bool renderThread = false;
+    bool culling = true;
+    std::string vertexShader = "default.vxs";
+    std::string fragmentShader = "default.pxs";
+    ShaderKey features = 0; // variante dos materiais dos meshes
+    std::string spriteVertexShader = "sprite.vxs";
+    std::string spriteFragmentShader = "sprite.pxs";
+    std::string spriteTexture;
+    size_t textureBudgetMb = 0;
+    const char* outPath = nullptr;
+    long long expectDraws = -1;
+    bool expectNoAllocs = false;
+    bool checkHash = false;
+    uint64_t expectHash = 0;
+    const char* dumpPath = nullptr;
+};
+
+bool parseOptions(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto takes = [&](const char* name) {
+            if (std::strcmp(arg, name) != 0) return false;
+            if (!value) {
+                std::fprintf(stderr, "%s needs a value\n", name);
+                std::exit(2);
+            }
+            i++;
+            return true;
+        };
+
+        if (takes("--api")) {
+            opt.apiName = value;
+            if (std::strcmp(value, "opengl") == 0) {
+                opt.api = GraphicsAPI::OPENGL;
+            } else if (std::strcmp(value, "vulkan") == 0) {
+                opt.api = GraphicsAPI::VULKAN;
+            } else if (std::strcmp(value, "null") == 0) {
+                opt.api = GraphicsAPI::NULL_BACKEND;
+            } else {
+                std::fprintf(stderr, "Unknown api %s\n", value);
+                return false;
+            }
+        } else if (takes("--objects")) {
+            opt.objects = std::atoi(value);
+        } else if (takes("--meshes")) {
+            opt.meshes = std::max(1, std::atoi(value));
+        } else if (takes("--materials")) {
+            opt.materials = std::max(1, std::atoi(value));
+        } else if (takes("--sprites")) {
+            opt.sprites = std::atoi(value);
+        } else if (takes("--lights")) {
+            opt.lights = std::max(0, std::atoi(value));
+        } else if (takes("--shadows")) {
+            opt.shadowCascades = std::max(0, std::min(4, std::atoi(value)));
+        } else if (takes("--frames")) {
+            opt.frames = std::max(1, std::atoi(value));
+        } else if (takes("--warmup")) {
+            opt.warmup = std::atoi(value);
+        } else if (takes("--width")) {
+            opt.width = std::atoi(value);
+        } else if (takes("--height")) {
+            opt.height = std::atoi(value);
+        } else if (takes("--seed")) {
+            opt.seed = (unsigned int)std::strtoul(value, nullptr, 10);
+        } else if (takes("--threads")) {
+            opt.threads = std::max(0, std::atoi(value));
+        } else if (takes("--vs")) {
+            opt.vertexShader = value;
+        } else if (takes("--fs")) {
+            opt.fragmentShader = value;
+        } else if (takes("--features")) {
+            for (const char* name = value; *name;) {
+                const char* end = std::strchr(name, ',');
+                size_t length = end ? (size_t)(end - name) : std::strlen(name);
+                ShaderKey bit = ShaderFeature::fromName(std::string(name, length));
+                if (!bit) {
+                    std::fprintf(stderr, "Unknown shader feature in %s\n", value);
+                    return false;
+                }
+                opt.features |= bit;
+                name += end ? length + 1 : length;
+            }
+        } else if (takes("--sprite-vs")) {
+            opt.spriteVertexShader = value;
+        } else if (takes("--sprite-fs")) {
+            opt.spriteFragmentShader = value;
+        } else if (takes("--sprite-texture")) {
+            opt.spriteTexture = value;
+        } else if (takes("--texture-budget-mb")) {
+            opt.textureBudgetMb = (size_t)std::atoi(value);
+        } else if (takes("--out")) {
+            opt.outPath = value;
+        } else if (takes("--expect-draws")) {
+            opt.expectDraws = std::atoll(value);
+        } else if (takes("--expect-hash")) {
+            opt.checkHash = true;
+            opt.expectHash = std::strtoull(value, nullptr, 16);
+        } else if (takes("--dump-commands")) {
+            opt.dumpPath = value;
+        } else if (std::strcmp(arg, "--render-thread") == 0) {
+            opt.renderThread = true;
+        } else if (std::strcmp(arg, "--expect-no-allocs") == 0) {
+            opt.expectNoAllocs = true;
+        } else if (std::strcmp(arg, "--no-cull") == 0) {
+            opt.culling = false;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Esfera UV sem indices (o engine desenha com glDrawArrays/vkCmdDraw)
+std::shared_ptr<Mesh> createSphere(RendererBackend& backend, int segments, int rings) {
+    std::vector<float> vertices, normals;
+    auto point = [&](int ring, int seg) {
+        float theta = (float)ring / rings * 3.14159265f;
+        float phi = (float)seg / segments * 2.0f * 3.14159265f;
+        return glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                         std::sin(theta) * std::sin(phi));
+    };
+    auto push = [&](const glm::vec3& p) {
+        vertices.insert(vertices.end(), {p.x * 0.5f, p.y * 0.5f, p.z * 0.5f});
+        normals.insert(normals.end(), {p.x, p.y, p.z});
+    };
+
+    for (int r = 0; r < rings; r++) {
+        for (int s = 0; s < segments; s++) {
+            glm::vec3 a = point(r, s), b = point(r + 1, s);
+            glm::vec3 c = point(r + 1, s + 1), d = point(r, s + 1);
+            if (r > 0) {
+                push(a), push(b), push(d);
+            }
+            if (r < rings - 1) {
+                push(b), push(c), push(d);
+            }
+        }
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setVertices(vertices);
+    mesh->setNormals(normals);
+    mesh->setMeshBuffer(backend.createMeshBuffer());
+    mesh->configure();
+    return mesh;
+}
+
+std::shared_ptr<Material> createMaterial(RendererBackend& backend, const std::string& vs,
+                                         const std::string& fs, ShaderKey features,
+                                         const ColorRGBA& color) {
+    ShaderCache& shaders = *backend.getShaderCache();
+    auto material = std::make_shared<Material>();
+    material->setShaderProgram(backend.createShaderProgram());
+    material->setVertexShader(shaders.acquire(vs, ShaderType::VERTEX, features));
+    material->setFragmentShader(shaders.acquire(fs, ShaderType::FRAGMENT, features));
+    material->setBaseColor(color);
+    if (!material->init()) {
+        return nullptr;
+    }
+    return material;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        return 2;
+    }
+
+    Logger::init("bench");
+    if (opt.api != GraphicsAPI::NULL_BACKEND) {
+        SDL_Init(SDL_INIT_VIDEO); // so o fallback GL sem EGL precisa de video
+    }
+
+    Yume::JobSystem jobs;
+    if (opt.threads != 1) {
+        jobs.init(opt.threads > 1 ? opt.threads - 1 : 0);
+    }
+
+    Renderer renderer;
+    renderer.setJobSystem(&jobs);
+    if (!renderer.initBackend(opt.api) || !renderer.initHeadless(opt.width, opt.height)) {
+        std::fprintf(stderr, "Failed to create a headless %s context\n", opt.apiName);
+        return 1;
+    }
+    renderer.setCullingEnabled(opt.culling);
+    renderer.getTextureManager().setBudget(opt.textureBudgetMb * 1024 * 1024);
+    RendererBackend& backend = *renderer.getRendererBackend();
+    if (opt.checkHash && opt.api != GraphicsAPI::NULL_BACKEND) {
+        std::fprintf(stderr, "--expect-hash needs --api null\n");
+        return 2;
+    }
+
+    std::mt19937 rng(opt.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Malhas com custo crescente: 8x4, 12x6, 16x8, ... segmentos
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    for (int i = 0; i < opt.meshes; i++) {
+        int segments = 8 + 4 * i;
+        meshes.push_back(createSphere(backend, segments, segments / 2));
+    }
+
+    std::vector<std::shared_ptr<Material>> materials;
+    for (int i = 0; i < opt.materials; i++) {
+        ColorRGBA color = {unit(rng), unit(rng), unit(rng), 1.0f};
+        auto material = createMaterial(backend, opt.vertexShader, opt.fragmentShader,
+                                       opt.features, color);
+        if (!material) {
+            std::fprintf(stderr, "Material init failed for %s / %s\n", opt.vertexShader.c_str(),
+                         opt.fragmentShader.c_str());
+            return 1;
+        }
+        materials.push_back(material);
+    }
+
+    std::shared_ptr<Material> spriteMaterial;
+    TextureHandle spriteTexture;
+    if (opt.sprites > 0) {
+        spriteMaterial = createMaterial(backend, opt.spriteVertexShader, opt.spriteFragmentShader, 0,
+                                        COLOR::WHITE);
+        if (!spriteMaterial) {
+            std::fprintf(stderr, "Sprite material init failed\n");
+            return 1;
+        }
+        if (!opt.spriteTexture.empty()) {
+            spriteTexture = renderer.getTextureManager().acquire(opt.spriteTexture);
+        }
+    }
+
+    // Objetos num cubo de lado proporcional a raiz cubica da contagem; a camera fica
+    // numa face olhando para o centro, entao parte da cena cai fora do frustum.
+    int total = opt.objects + opt.sprites;
+    float extent = 1.5f * std::cbrt((float)std::max(total, 1));
+    auto randomPosition = [&]() {
+        return Vector3{(unit(rng) - 0.5f) * 2.0f * extent, (unit(rng) - 0.5f) * 2.0f * extent,
+                       (unit(rng) - 0.5f) * 2.0f * extent};
+    };
+
+    auto scene = std::make_unique<Scene>();
+    SceneStorage& storage = scene->getStorage();
+    storage.reserve(total, opt.objects, opt.sprites);
+    auto* gameObjects = new std::vector<GameObject*>();
+    gameObjects->reserve(total);
+    scene->setGameObjects(gameObjects);
+    for (int i = 0; i < total; i++) {
+        GameObject* go = scene->createGameObject();
+        Transform* transform = storage.addTransform(go);
+        transform->setPosition(randomPosition());
+        transform->setRotation({0.0f, unit(rng) * 360.0f, 0.0f});
+        transform->setScale({1.0f, 1.0f, 1.0f});
+
+        if (i < opt.objects) {
+            go->setMesh(meshes[i % meshes.size()]);
+            storage.addMeshRenderer(go)->setMaterial(materials[i % materials.size()]);
+        } else {
+            storage.addSprite(go, 1.0f, 1.0f)->setTexture(spriteTexture);
+            storage.addSpriteRenderer(go)->setMaterial(spriteMaterial);
+        }
+    }
+
+    auto* camera = new Camera();
+    camera->setViewRect((float)opt.width, (float)opt.height);
+    camera->setPosition({0.0f, 0.0f, extent * 1.1f});
+    camera->setTarget({0.0f, 0.0f, 0.0f});
+    camera->setFarDistance(extent * 4.0f);
+
+    auto* lights = new std::vector<Light>();
+    lights->push_back({LightType::DIRECTIONAL, {-0.5f, -1.0f, -0.3f}, COLOR::WHITE, 1.0f});
+    if (opt.shadowCascades > 0) {
+        // Sombra cobrindo a cena toda, vista da camera
+        lights->back().castShadows = true;
+        lights->back().shadowCascades = (uint8_t)opt.shadowCascades;
+        lights->back().shadowDistance = extent * 2.5f;
+    }
+    // Uma em cada quatro e spot; o alcance cobre alguns objetos vizinhos
+    for (int i = 0; i < opt.lights; i++) {
+        Light light = {i % 4 == 3 ? LightType::SPOT : LightType::POINT,
+                       {0.0f, -1.0f, 0.0f},
+                       {unit(rng), unit(rng), unit(rng), 1.0f},
+                       2.0f};
+        light.position = randomPosition();
+        light.range = 0.2f * extent;
+        lights->push_back(light);
+    }
+
+    scene->setCamera(camera);
+    scene->setLights(lights);
+    backend.setCamera(camera);
+
+    std::vector<double> frameMs;
+    frameMs.reserve(opt.frames);
+    double draws = 0, triangles = 0, culled = 0, shadowDraws = 0;
+    uint64_t heapAllocations = 0, maxFrameAllocations = 0;
+
+    using Clock = std::chrono::steady_clock;
+    auto runStart = Clock::now();
+    // Passo fixo: o conteudo do frame N nao depende do tempo de parede, entao o
+    // stream de comandos do backend null e reproduzivel
+    const float dt = 1.0f / 60.0f;
+    RenderThread renderThread;
+    renderThread.setRenderer(renderer, nullptr);
+    if (opt.renderThread && !renderThread.start()) {
+        return 1;
+    }
+    const int totalFrames = opt.warmup + opt.frames;
+    for (int frame = 0; frame < totalFrames; frame++) {
+        if (frame == opt.warmup) runStart = Clock::now();
+        auto start = Clock::now();
+        uint64_t allocationsBefore = g_heapAllocations.load(std::memory_order_relaxed);
+
+        jobs.parallelFor(gameObjects->size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Transform* t = (*gameObjects)[i]->getTransform();
+                Vector3 rotation = t->getRotation();
+                rotation.y += 45.0f * dt;
+                t->setRotation(rotation);
+            }
+        });
+
+        // Luzes orbitam o eixo Y: os clusters mudam todo frame
+        const float orbit = 0.25f * dt, orbitCos = std::cos(orbit), orbitSin = std::sin(orbit);
+        for (Light& light : *lights) {
+            float x = light.position.x, z = light.position.z;
+            light.position.x = x * orbitCos - z * orbitSin;
+            light.position.z = x * orbitSin + z * orbitCos;
+        }
+
+        // Sem --render-thread o submitFrame desenha na hora, como render + present
+        FramePacket& packet = renderThread.beginFrame();
+        renderer.buildFramePacket(*scene, packet);
+        renderThread.submitFrame();
+
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (frame >= totalFrames - 2) {
+            // Os contadores do ultimo frame precisam fechar com ele (--expect-draws)
+            renderThread.flush();
+        }
+        Stats::endFrame(ms);
+        FrameMemory::endFrame();
+        uint64_t frameAllocations =
+            g_heapAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+        if (frame < opt.warmup) continue;
+
+        heapAllocations += frameAllocations;
+        maxFrameAllocations = std::max(maxFrameAllocations, frameAllocations);
+        frameMs.push_back(ms);
+        const Stats::Snapshot stats = Stats::getLastFrame();
+        draws += stats[(size_t)Stat::DRAW_CALLS];
+        triangles += stats[(size_t)Stat::TRIANGLES];
+        culled += stats[(size_t)Stat::CULLED_OBJECTS];
+        shadowDraws += stats[(size_t)Stat::SHADOW_DRAWS];
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    renderThread.stop();
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (double ms : frameMs) mean += ms;
+    mean /= frameMs.size();
+    double n = (double)frameMs.size();
+
+    std::FILE* out = opt.outPath ? std::fopen(opt.outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Failed to open %s\n", opt.outPath);
+        return 1;
+    }
+    std::fprintf(out,
+                 "{\n"
+                 "  \"api\": \"%s\",\n"
+                 "  \"objects\": %d,\n"
+                 "  \"meshes\": %d,\n"
+                 "  \"materials\": %d,\n"
+                 "  \"sprites\": %d,\n"
+                 "  \"lights\": %d,\n"
+                 "  \"shadow_cascades\": %d,\n"
+                 "  \"shader_features\": %u,\n"
+                 "  \"shader_variants\": %zu,\n"
+                 "  \"culling\": %s,\n"
+                 "  \"seed\": %u,\n"
+                 "  \"threads\": %zu,\n"
+                 "  \"render_thread\": %s,\n"
+                 "  \"resolution\": [%d, %d],\n"
+                 "  \"frames\": %d,\n"
+                 "  \"frame_ms\": {\"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p95\": %.4f, "
+                 "\"p99\": %.4f, \"max\": %.4f},\n"
+                 "  \"fps\": %.2f,\n"
+                 "  \"objects_per_second\": %.0f,\n"
+                 "  \"avg_draw_calls\": %.1f,\n"
+                 "  \"avg_triangles\": %.0f,\n"
+                 "  \"avg_culled\": %.1f,\n"
+                 "  \"avg_shadow_draws\": %.1f,\n"
+                 "  \"heap_allocations\": {\"per_frame\": %.2f, \"max_frame\": %llu},\n"
+                 "  \"textures\": {\"count\": %zu, \"resident_bytes\": %zu}",
+                 opt.apiName, opt.objects, opt.meshes, opt.materials, opt.sprites, opt.lights,
+                 opt.shadowCascades, opt.features, renderer.getShaderCache().size(),
+                 opt.culling ? "true" : "false", opt.seed,
+                 std::max<size_t>(1, jobs.getWorkerCount() + 1),
+                 opt.renderThread ? "true" : "false", opt.width, opt.height,
+                 (int)frameMs.size(), mean, sorted.front(), percentile(sorted, 50),
+                 percentile(sorted, 95), percentile(sorted, 99), sorted.back(), n / seconds,
+                 total * n / seconds, draws / n, triangles / n, culled / n, shadowDraws / n,
+                 heapAllocations / n, (unsigned long long)maxFrameAllocations,
+                 renderer.getTextureManager().getTextureCount(),
+                 renderer.getTextureManager().getResidentBytes());
+
+    auto* nullBackend = dynamic_cast<NullRendererBackend*>(&backend);
+    if (nullBackend) {
+        const NullCommandList& commands = nullBackend->getLastFrameCommands();
+        std::fprintf(out,
+                     ",\n  \"command_list\": {\"commands\": %zu, \"bytes\": %zu, \"draws\": %zu, "
+                     "\"program_binds\": %zu, \"uniform_uploads\": %zu, \"hash\": \"%016" PRIx64
+                     "\"}",
+                     commands.getCommandCount(), commands.getByteSize(), commands.getDrawCount(),
+                     commands.getCount(NullOp::BIND_PROGRAM),
+                     commands.getCount(NullOp::UPLOAD_UNIFORM), commands.getHash());
+        if (opt.dumpPath) {
+            commands.save(opt.dumpPath);
+        }
+    }
+    std::fputs("\n}\n", out);
+    if (out != stdout) std::fclose(out);
+
+    int result = 0;
+    long long lastDraws = Stats::getLastFrame()[(size_t)Stat::DRAW_CALLS];
+    if (opt.expectDraws >= 0 && lastDraws != opt.expectDraws) {
+        std::fprintf(stderr, "Draw count mismatch: expected %lld, got %lld\n", opt.expectDraws,
+                     lastDraws);
+        result = 3;
+    }
+    if (opt.expectNoAllocs && heapAllocations > 0) {
+        std::fprintf(stderr,
+                     "Heap allocations in steady-state frames: %llu (max %llu in one frame)\n",
+                     (unsigned long long)heapAllocations, (unsigned long long)maxFrameAllocations);
+        result = 3;
+    }
+    if (opt.checkHash && nullBackend) {
+        uint64_t hash = nullBackend->getLastFrameCommands().getHash();
+        if (hash != opt.expectHash) {
+            std::fprintf(stderr, "Command hash mismatch: expected %016" PRIx64 ", got %016" PRIx64
+                                 "\n",
+                         opt.expectHash, hash);
+            result = 3;
+        }
+    }
+
+    scene.reset(); // antes do backend: malhas e materiais ainda usam o contexto
+    jobs.shutdown();
+    Logger::shutdown();
+    return result;
+}
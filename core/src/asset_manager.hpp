@@ -2,6 +2,7 @@
 #define ASSET_MANAGER_HPP
 
 #include "asset.hpp"
+#include "stats.hpp"
 #include <algorithm>
 #include <memory>
 #include <string>
@@ -25,7 +26,10 @@ class AssetManager {
 
         // Create new asset
         auto asset = std::make_unique<T>(path, std::forward<Args>(args)...);
-        if (!asset->load()) {
+        Stats::add(Stat::ASSET_QUEUE_DEPTH, 1);
+        bool loaded = asset->load();
+        Stats::add(Stat::ASSET_QUEUE_DEPTH, -1);
+        if (!loaded) {
             return nullptr;
         }
 
@@ -0,0 +1,93 @@
+#define CLASS_NAME "BakedTexture"
+#include "log_macros.hpp"
+
+#include "baked_texture.hpp"
+#include <algorithm>
+#include <filesystem>
+
+bool BakedTexture::isStale(const std::string& sourcePath) {
+    std::error_code sourceError, bakedError;
+    std::string bakedPath = bakedTexturePath(sourcePath);
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, sourceError);
+    auto bakedTime = std::filesystem::last_write_time(bakedPath, bakedError);
+    if (sourceError || bakedError || sourceTime <= bakedTime) {
+        return false;
+    }
+    LOG_WARN("%s is older than %s, decoding the source instead", bakedPath.c_str(),
+             sourcePath.c_str());
+    return true;
+}
+
+bool BakedTexture::readHeader(std::ifstream& file, const std::string& path) {
+    file.seekg(0, std::ios::end);
+    size_t fileSize = (size_t)file.tellg();
+    file.seekg(0);
+
+    TextureFileHeader header;
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        LOG_WARN("Baked texture too small: %s", path.c_str());
+        return false;
+    }
+    if (header.magic != TEXTURE_FILE_MAGIC || header.version != TEXTURE_FILE_VERSION ||
+        header.mipCount == 0 || header.mipCount > TEXTURE_MAX_MIPS) {
+        LOG_WARN("Invalid baked texture header: %s", path.c_str());
+        return false;
+    }
+
+    mips.resize(header.mipCount);
+    file.read(reinterpret_cast<char*>(mips.data()), mips.size() * sizeof(TextureMipEntry));
+
+    size_t dataStart = sizeof(header) + mips.size() * sizeof(TextureMipEntry);
+    if (!file || fileSize < dataStart) {
+        LOG_WARN("Truncated baked texture: %s", path.c_str());
+        return false;
+    }
+
+    // A tabela inteira e validada mesmo numa leitura parcial: os niveis que
+    // faltam vao ser lidos depois confiando nela
+    for (size_t i = 0; i < mips.size(); i++) {
+        const TextureMipEntry& mip = mips[i];
+        if (mip.offset < dataStart || (size_t)mip.offset + mip.size > fileSize ||
+            mip.size != textureMipSize(header.format, mip.width, mip.height) ||
+            (i > 0 && mip.offset != mips[i - 1].offset + mips[i - 1].size)) {
+            LOG_WARN("Corrupt mip table in baked texture: %s", path.c_str());
+            return false;
+        }
+    }
+
+    format = header.format;
+    width = header.width;
+    height = header.height;
+    return true;
+}
+
+bool BakedTexture::readLevels(std::ifstream& file, uint32_t first, uint32_t end) {
+    end = std::min(end, (uint32_t)mips.size());
+    if (first >= end) return false;
+
+    size_t begin = mips[first].offset;
+    data.resize(mips[end - 1].offset + mips[end - 1].size - begin);
+    file.seekg(begin);
+    if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) return false;
+
+    firstLevel = first;
+    levelEnd = end;
+    return true;
+}
+
+bool BakedTexture::loadTail(const std::string& path, uint32_t maxSize) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file || !readHeader(file, path)) return false;
+
+    uint32_t first = (uint32_t)mips.size() - 1;
+    while (first > 0 && std::max(mips[first - 1].width, mips[first - 1].height) <= maxSize) {
+        first--;
+    }
+    return readLevels(file, first, (uint32_t)mips.size());
+}
+
+bool BakedTexture::loadLevels(const std::string& path, uint32_t first, uint32_t end) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file || !readHeader(file, path)) return false;
+    return readLevels(file, first, end);
+}
@@ -0,0 +1,41 @@
+#ifndef BAKED_TEXTURE_HPP
+#define BAKED_TEXTURE_HPP
+
+#include "texture_format.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// A .ytex file (or a range of its mips) read into memory as-is: the backends
+// upload each mip straight from `data` with no decode or conversion. The mip
+// table is always complete, so a partial load still knows the full chain.
+struct BakedTexture {
+    TextureFormat format = TextureFormat::RGBA8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<TextureMipEntry> mips; // offsets no arquivo
+    uint32_t firstLevel = 0;           // so [firstLevel, levelEnd) estao em data
+    uint32_t levelEnd = 0;
+    std::vector<uint8_t> data;
+
+    size_t mipOffset(size_t level) const { return mips[level].offset - mips[firstLevel].offset; }
+    const uint8_t* mipData(size_t level) const { return data.data() + mipOffset(level); }
+
+    // true (com aviso) se a imagem original mudou depois do bake; sem a imagem,
+    // quando so o .ytex foi distribuido, nunca esta velho
+    static bool isStale(const std::string& sourcePath);
+
+    // false se o arquivo nao existe ou esta truncado/invalido
+    bool load(const std::string& path) { return loadLevels(path, 0, TEXTURE_MAX_MIPS); }
+    // So a cauda da cadeia: os mips com ate maxSize pixels no maior lado
+    bool loadTail(const std::string& path, uint32_t maxSize);
+    // Mips [first, end); como o mip 0 vem primeiro no arquivo, e uma leitura so
+    bool loadLevels(const std::string& path, uint32_t first, uint32_t end);
+
+  private:
+    bool readHeader(std::ifstream& file, const std::string& path);
+    bool readLevels(std::ifstream& file, uint32_t first, uint32_t end);
+};
+
+#endif // BAKED_TEXTURE_HPP
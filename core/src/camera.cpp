@@ -1,4 +1,5 @@
 #include "camera.hpp"
+#include <glm/gtc/matrix_transform.hpp>
 
 const Vector3& Camera::getPosition() const { return position; }
 
@@ -49,4 +50,31 @@ float Camera::getOrthoSize() const { return orthoSize; }
 void Camera::setViewRect(float width, float height) {
     setWidth(width);
     setHeight(height);
-}
\ No newline at end of file
+}
+
+void Camera::copyParametersFrom(const Camera& other) {
+    backgroundColor = other.backgroundColor;
+    position = other.position;
+    target = other.target;
+    fov = other.fov;
+    nearDistance = other.nearDistance;
+    farDistance = other.farDistance;
+    width = other.width;
+    height = other.height;
+    orthographic = other.orthographic;
+    orthoSize = other.orthoSize;
+}
+
+glm::mat4 Camera::getViewMatrix() const {
+    return glm::lookAt(glm::vec3(position.x, position.y, position.z),
+                       glm::vec3(target.x, target.y, target.z), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+glm::mat4 Camera::getProjectionMatrix() const {
+    if (orthographic) {
+        float aspect = getAspectRatio();
+        return glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize, orthoSize,
+                          nearDistance, farDistance);
+    }
+    return glm::perspective(glm::radians(fov), getAspectRatio(), nearDistance, farDistance);
+}
@@ -4,6 +4,7 @@
 #include "color.hpp"
 #include "skybox.hpp"
 #include "vector3.hpp"
+#include <glm/glm.hpp>
 
 class Camera {
   private:
@@ -48,6 +49,12 @@ class Camera {
     void setOrthographic(bool ortho);
     bool isOrthographic() const;
     void setViewRect(float width, float height);
+    // Copia tudo menos o skybox; usado nos snapshots que vao para o render thread
+    void copyParametersFrom(const Camera& other);
+
+    // Convencao OpenGL (clip z em [-1, 1], y para cima)
+    glm::mat4 getViewMatrix() const;
+    glm::mat4 getProjectionMatrix() const;
 };
 
 #endif // CAMERA_HPP
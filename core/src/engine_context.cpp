@@ -3,6 +3,7 @@
 Yume::Context::Context(IInput* input) : input(input) {}
 
 Yume::Context::~Context() {
+    jobs.shutdown();
     if (input) {
         delete input;
     }
@@ -10,4 +11,6 @@ Yume::Context::~Context() {
 
 Yume::IInput& Yume::Context::getInputSystem() { 
     return *input; 
-}
\ No newline at end of file
+}
+
+Yume::JobSystem& Yume::Context::getJobSystem() { return jobs; }
\ No newline at end of file
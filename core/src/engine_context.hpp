@@ -2,6 +2,7 @@
 #define ENGINE_CONTEXT_HPP
 
 #include "input/i_input.hpp"
+#include "job_system.hpp"
 
 namespace Yume {
 class Context {
@@ -9,8 +10,11 @@ class Context {
     Context(IInput* input);
     ~Context();
     IInput* input;
+    JobSystem jobs;
 
     IInput& getInputSystem();
+    // Precisa de jobs.init() antes do primeiro uso; sem isso tudo roda inline
+    JobSystem& getJobSystem();
 };
 } // namespace Yume
 
@@ -0,0 +1,39 @@
+#include "frame_memory.hpp"
+#include <atomic>
+
+namespace {
+
+std::atomic<uint64_t> g_frame{0};
+std::atomic<size_t> g_arenaSize{256 * 1024};
+
+struct ThreadArenas {
+    LinearArena arenas[FrameMemory::FRAMES_IN_FLIGHT];
+    uint64_t frame = UINT64_MAX;
+
+    ThreadArenas()
+        : arenas{LinearArena(g_arenaSize.load(std::memory_order_relaxed)),
+                 LinearArena(g_arenaSize.load(std::memory_order_relaxed))} {}
+};
+
+thread_local ThreadArenas t_arenas;
+
+} // namespace
+
+LinearArena& FrameMemory::scratch() {
+    uint64_t frame = g_frame.load(std::memory_order_acquire);
+    LinearArena& arena = t_arenas.arenas[frame % FRAMES_IN_FLIGHT];
+    if (t_arenas.frame != frame) {
+        // Primeiro uso neste frame: o conteudo e de pelo menos dois frames atras
+        t_arenas.frame = frame;
+        arena.reset();
+    }
+    return arena;
+}
+
+void FrameMemory::endFrame() { g_frame.fetch_add(1, std::memory_order_acq_rel); }
+
+uint64_t FrameMemory::getFrame() { return g_frame.load(std::memory_order_acquire); }
+
+void FrameMemory::setArenaSize(size_t bytes) {
+    g_arenaSize.store(bytes, std::memory_order_relaxed);
+}
@@ -0,0 +1,32 @@
+#ifndef FRAME_MEMORY_HPP
+#define FRAME_MEMORY_HPP
+
+#include "linear_arena.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Per-thread scratch memory for transient frame data. Every thread gets one
+// arena per frame in flight; memory taken during frame N stays valid until the
+// end of frame N+1 (long enough for the render thread to consume it) and is
+// then reused without going back to the heap. Each thread resets its own arena
+// lazily, so endFrame() never touches another thread's memory.
+class FrameMemory {
+  public:
+    // Igual ao numero de FramePackets do RenderThread
+    static constexpr size_t FRAMES_IN_FLIGHT = 2;
+
+    // Arena do thread atual para o frame corrente
+    static LinearArena& scratch();
+    template <typename T> static ArenaAllocator<T> allocator() {
+        return ArenaAllocator<T>(&scratch());
+    }
+
+    // Chamar uma vez por frame no thread principal, junto de Stats::endFrame
+    static void endFrame();
+    static uint64_t getFrame();
+
+    // Capacidade inicial das arenas criadas depois da chamada
+    static void setArenaSize(size_t bytes);
+};
+
+#endif // FRAME_MEMORY_HPP
@@ -0,0 +1,132 @@
+#define CLASS_NAME "GameLoop"
+#include "log_macros.hpp"
+
+#include "game_loop.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+// Abaixo disso o sleep do SO nao e confiavel; o resto do prazo e feito em spin
+constexpr auto SPIN_MARGIN = std::chrono::microseconds(1000);
+
+double toMs(GameLoop::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // namespace
+
+void GameLoop::setFixedTimestep(double seconds) {
+    if (!(seconds > 0.0) || !std::isfinite(seconds)) {
+        LOG_WARN("Invalid fixed timestep %f, keeping %f", seconds, fixedStep);
+        return;
+    }
+    fixedStep = seconds;
+}
+
+void GameLoop::setFrameRateLimit(double fps) {
+    if (fps <= 0.0) {
+        framePeriod = Clock::duration::zero();
+        return;
+    }
+    framePeriod =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    LOG_INFO("Frame rate limited to %.1f fps", fps);
+}
+
+void GameLoop::run() {
+    while (frame()) {
+    }
+
+    LOG_INFO("Frame pacing: avg %.2f ms, min %.2f ms, max %.2f ms, jitter %.2f ms, "
+             "%llu dropped tick(s)",
+             pacing.averageMs, pacing.minMs, pacing.maxMs, pacing.jitterMs,
+             (unsigned long long)pacing.droppedTicks);
+}
+
+bool GameLoop::frame() {
+    if (!running) return false;
+
+    Clock::time_point frameStart = Clock::now();
+    if (started) {
+        auto elapsed = frameStart - lastFrameStart;
+        recordFrame(toMs(elapsed));
+        accumulator += std::chrono::duration<double>(elapsed).count();
+    }
+    started = true;
+    lastFrameStart = frameStart;
+
+    {
+        PROFILE_SCOPE("Frame");
+
+        if (inputFn) inputFn();
+
+        int updates = 0;
+        {
+            PROFILE_SCOPE("Update");
+            while (accumulator >= fixedStep && updates < maxUpdates) {
+                if (updateFn) updateFn(fixedStep);
+                accumulator -= fixedStep;
+                updates++;
+                tickCount++;
+            }
+        }
+        // Atrasado demais (breakpoint, carga de cena): descarta em vez de acelerar
+        if (accumulator >= fixedStep) {
+            double dropped = std::floor(accumulator / fixedStep);
+            pacing.droppedTicks += (uint64_t)dropped;
+            accumulator -= dropped * fixedStep;
+        }
+        pacing.updates = updates;
+
+        if (renderFn) renderFn((float)(accumulator / fixedStep));
+    }
+
+    pacing.waitMs = 0.0;
+    if (framePeriod > Clock::duration::zero() && running) {
+        PROFILE_SCOPE("FrameLimiter");
+        Clock::time_point waitStart = Clock::now();
+        waitUntil(frameStart + framePeriod);
+        pacing.waitMs = toMs(Clock::now() - waitStart);
+    }
+
+    return running;
+}
+
+void GameLoop::waitUntil(Clock::time_point deadline) {
+    for (;;) {
+        auto remaining = deadline - Clock::now();
+        if (remaining <= Clock::duration::zero()) break;
+        if (remaining > SPIN_MARGIN) {
+            std::this_thread::sleep_for(remaining - SPIN_MARGIN);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void GameLoop::recordFrame(double frameMs) {
+    pacing.frameMs = frameMs;
+    history[historyHead] = frameMs;
+    historyHead = (historyHead + 1) % WINDOW;
+    historyCount = std::min(historyCount + 1, WINDOW);
+
+    double sum = 0.0, minMs = history[0], maxMs = history[0];
+    for (size_t i = 0; i < historyCount; i++) {
+        sum += history[i];
+        minMs = std::min(minMs, history[i]);
+        maxMs = std::max(maxMs, history[i]);
+    }
+    double mean = sum / historyCount;
+    double variance = 0.0;
+    for (size_t i = 0; i < historyCount; i++) {
+        variance += (history[i] - mean) * (history[i] - mean);
+    }
+
+    pacing.averageMs = mean;
+    pacing.minMs = minMs;
+    pacing.maxMs = maxMs;
+    pacing.jitterMs = std::sqrt(variance / historyCount);
+}
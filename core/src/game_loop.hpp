@@ -0,0 +1,96 @@
+#ifndef GAME_LOOP_HPP
+#define GAME_LOOP_HPP
+
+#include "vector3.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+// Loop com passo fixo de simulacao e acumulador: input uma vez por frame,
+// update em ticks de duracao fixa e render com o alpha da interpolacao entre
+// os dois ultimos estados. O limitador opcional dorme ate perto do prazo e
+// termina com spin curto, para nao ocupar 100% da CPU sem vsync.
+class GameLoop {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pacing {
+        double frameMs = 0.0;   // ultimo frame, inicio a inicio
+        double averageMs = 0.0; // janela dos ultimos WINDOW frames
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double jitterMs = 0.0;  // desvio padrao na janela
+        double waitMs = 0.0;    // tempo no limitador no ultimo frame
+        int updates = 0;        // ticks fixos no ultimo frame
+        uint64_t droppedTicks = 0;
+    };
+
+    static constexpr size_t WINDOW = 120;
+
+    void setInput(std::function<void()> fn) { inputFn = std::move(fn); }
+    void setUpdate(std::function<void(double dt)> fn) { updateFn = std::move(fn); }
+    void setRender(std::function<void(float alpha)> fn) { renderFn = std::move(fn); }
+
+    void setFixedTimestep(double seconds);
+    double getFixedTimestep() const { return fixedStep; }
+    // Limite de ticks por frame; o atraso excedente e descartado (evita a espiral)
+    void setMaxUpdatesPerFrame(int count) { maxUpdates = count > 0 ? count : 1; }
+    // 0 desliga o limitador
+    void setFrameRateLimit(double fps);
+
+    // Roda frame() ate stop()
+    void run();
+    // Um frame completo; retorna false depois de stop()
+    bool frame();
+    void stop() { running = false; }
+
+    const Pacing& getPacing() const { return pacing; }
+    uint64_t getTickCount() const { return tickCount; }
+
+  private:
+    std::function<void()> inputFn;
+    std::function<void(double)> updateFn;
+    std::function<void(float)> renderFn;
+
+    double fixedStep = 1.0 / 60.0;
+    int maxUpdates = 5;
+    Clock::duration framePeriod = Clock::duration::zero();
+
+    bool running = true;
+    bool started = false;
+    Clock::time_point lastFrameStart;
+    double accumulator = 0.0;
+    uint64_t tickCount = 0;
+
+    Pacing pacing;
+    std::array<double, WINDOW> history{};
+    size_t historyCount = 0;
+    size_t historyHead = 0;
+
+    void recordFrame(double frameMs);
+    void waitUntil(Clock::time_point deadline);
+};
+
+inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+inline Vector3 lerp(const Vector3& a, const Vector3& b, float t) {
+    return {lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t)};
+}
+
+// Guarda o estado dos dois ultimos ticks para o render interpolar.
+// Chamar commit() no inicio de cada tick, antes de alterar o valor.
+template <typename T> class Interpolated {
+  private:
+    T previous{};
+    T current{};
+
+  public:
+    void reset(const T& value) { previous = current = value; }
+    void commit() { previous = current; }
+    void set(const T& value) { current = value; }
+    const T& get() const { return current; }
+    T get(float alpha) const { return lerp(previous, current, alpha); }
+};
+
+#endif // GAME_LOOP_HPP
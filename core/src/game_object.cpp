@@ -1,14 +1,14 @@
 #include "game_object.hpp"
 
-void GameObject::setTransform(std::unique_ptr<Transform> t) { 
-    transform = std::move(t); 
+void GameObject::setTransform(Transform* t) { 
+    transform = t; 
 }
 
 Transform* GameObject::getTransform() { 
-    return transform.get(); 
+    return transform; 
 }
 
-void GameObject::setMesh(std::unique_ptr<Mesh> m) { 
+void GameObject::setMesh(std::shared_ptr<Mesh> m) { 
     mesh = std::move(m); 
 }
 
@@ -24,48 +24,48 @@ bool GameObject::hasMesh() const {
     return mesh != nullptr; 
 }
 
-void GameObject::setMeshRenderer(std::unique_ptr<MeshRenderer> m) { 
-    meshRenderer = std::move(m); 
+void GameObject::setMeshRenderer(MeshRenderer* m) { 
+    meshRenderer = m; 
 }
 
 MeshRenderer* GameObject::getMeshRenderer() { 
-    return meshRenderer.get(); 
+    return meshRenderer; 
 }
 
 const MeshRenderer* GameObject::getMeshRenderer() const { 
-    return meshRenderer.get(); 
+    return meshRenderer; 
 }
 
 bool GameObject::hasMeshRenderer() const { 
     return meshRenderer != nullptr; 
 }
 
-void GameObject::setSprite(std::unique_ptr<Sprite> s) { 
-    sprite = std::move(s); 
+void GameObject::setSprite(Sprite* s) { 
+    sprite = s; 
 }
 
 Sprite* GameObject::getSprite() { 
-    return sprite.get(); 
+    return sprite; 
 }
 
 const Sprite* GameObject::getSprite() const { 
-    return sprite.get(); 
+    return sprite; 
 }
 
 bool GameObject::hasSprite() const { 
     return sprite != nullptr; 
 }
 
-void GameObject::setSpriteRenderer(std::unique_ptr<SpriteRenderer> sr) { 
-    spriteRenderer = std::move(sr); 
+void GameObject::setSpriteRenderer(SpriteRenderer* sr) { 
+    spriteRenderer = sr; 
 }
 
 SpriteRenderer* GameObject::getSpriteRenderer() { 
-    return spriteRenderer.get(); 
+    return spriteRenderer; 
 }
 
 const SpriteRenderer* GameObject::getSpriteRenderer() const { 
-    return spriteRenderer.get(); 
+    return spriteRenderer; 
 }
 
 bool GameObject::hasSpriteRenderer() const { 
@@ -8,37 +8,39 @@
 #include "transform.hpp"
 #include <memory>
 
+// Os componentes pertencem ao SceneStorage da cena (ver scene_storage.hpp);
+// o GameObject so aponta para eles
 class GameObject {
   private:
-    std::unique_ptr<Mesh> mesh;
-    std::unique_ptr<MeshRenderer> meshRenderer;
-    std::unique_ptr<Sprite> sprite;
-    std::unique_ptr<SpriteRenderer> spriteRenderer;
+    std::shared_ptr<Mesh> mesh; // pode ser compartilhado entre objetos
+    MeshRenderer* meshRenderer = nullptr;
+    Sprite* sprite = nullptr;
+    SpriteRenderer* spriteRenderer = nullptr;
 
-    std::unique_ptr<Transform> transform;
+    Transform* transform = nullptr;
 
   public:
     GameObject() = default;
 
-    void setTransform(std::unique_ptr<Transform> t);
+    void setTransform(Transform* t);
     Transform* getTransform();
 
-    void setMesh(std::unique_ptr<Mesh> m);
+    void setMesh(std::shared_ptr<Mesh> m);
     Mesh* getMesh();
     const Mesh* getMesh() const;
     bool hasMesh() const;
 
-    void setMeshRenderer(std::unique_ptr<MeshRenderer> m);
+    void setMeshRenderer(MeshRenderer* m);
     MeshRenderer* getMeshRenderer();
     const MeshRenderer* getMeshRenderer() const;
     bool hasMeshRenderer() const;
 
-    void setSprite(std::unique_ptr<Sprite> s);
+    void setSprite(Sprite* s);
     Sprite* getSprite();
     const Sprite* getSprite() const;
     bool hasSprite() const;
 
-    void setSpriteRenderer(std::unique_ptr<SpriteRenderer> sr);
+    void setSpriteRenderer(SpriteRenderer* sr);
     SpriteRenderer* getSpriteRenderer();
     const SpriteRenderer* getSpriteRenderer() const;
     bool hasSpriteRenderer() const;
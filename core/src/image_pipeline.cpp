@@ -0,0 +1,276 @@
+#define CLASS_NAME "ImagePipeline"
+#include "log_macros.hpp"
+
+#include "image_pipeline.hpp"
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include "stb_image_header.hpp" // a implementacao do stb_image fica nesta unidade
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define IMAGE_PIPELINE_X86 1
+#endif
+
+namespace {
+
+constexpr size_t BAND_ROWS = 64; // linhas por job de conversao
+
+std::atomic<bool> simdEnabled{true};
+
+bool useSimd() { return simdEnabled.load(std::memory_order_relaxed); }
+
+struct SrgbTables {
+    float toLinear[256];
+    uint8_t fromLinear[4096]; // indexado por linear * 4095
+};
+
+const SrgbTables& srgbTables() {
+    static const SrgbTables tables = [] {
+        SrgbTables t;
+        for (int i = 0; i < 256; i++) {
+            float c = i / 255.0f;
+            t.toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; i++) {
+            float l = i / 4095.0f;
+            float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            t.fromLinear[i] = (uint8_t)std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f);
+        }
+        return t;
+    }();
+    return tables;
+}
+
+// c * a / 255 com arredondamento exato, sem divisao
+inline uint8_t mul255(uint32_t c, uint32_t a) {
+    uint32_t x = c * a + 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+#ifdef IMAGE_PIPELINE_X86
+bool hasSSSE3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+// 16 pixels por volta: 48 bytes RGB viram 64 bytes RGBA com um pshufb por registro
+__attribute__((target("ssse3"))) size_t expandSSSE3(const uint8_t* rgb, uint8_t* rgba,
+                                                   size_t pixelCount) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+    size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16) {
+        const __m128i* src = reinterpret_cast<const __m128i*>(rgb + i * 3);
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        __m128i c = _mm_loadu_si128(src + 2);
+
+        __m128i* dst = reinterpret_cast<__m128i*>(rgba + i * 4);
+        _mm_storeu_si128(dst, _mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha));
+        _mm_storeu_si128(dst + 1,
+                         _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha));
+        _mm_storeu_si128(dst + 2,
+                         _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha));
+        _mm_storeu_si128(dst + 3,
+                         _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha));
+    }
+    return i;
+}
+
+// 4 pixels por volta em 16 bits; o alpha se multiplica por 255 e fica igual
+size_t premultiplySSE2(uint8_t* rgba, size_t pixelCount) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colorLanes = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    const __m128i half = _mm_set1_epi16(128);
+
+    auto scale = [&](__m128i v) {
+        __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xFF), 0xFF);
+        a = _mm_or_si128(_mm_and_si128(a, colorLanes), alphaLanes);
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(v, a), half);
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    };
+
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(rgba + i * 4);
+        __m128i px = _mm_loadu_si128(p);
+        __m128i lo = scale(_mm_unpacklo_epi8(px, zero));
+        __m128i hi = scale(_mm_unpackhi_epi8(px, zero));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+#endif
+
+void convertRows(const uint8_t* src, int channels, uint8_t* dst, size_t width, size_t rowBegin,
+                 size_t rowEnd, const ImagePipeline::ConvertOptions& options) {
+    size_t count = width * (rowEnd - rowBegin);
+    src += rowBegin * width * channels;
+    dst += rowBegin * width * 4;
+
+    switch (channels) {
+    case 4:
+        std::memcpy(dst, src, count * 4);
+        break;
+    case 3:
+        ImagePipeline::expandRGBToRGBA(src, dst, count);
+        break;
+    case 2:
+        for (size_t i = 0; i < count; i++) {
+            dst[i * 4] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i * 2];
+            dst[i * 4 + 3] = src[i * 2 + 1];
+        }
+        break;
+    default:
+        for (size_t i = 0; i < count; i++) {
+            dst[i * 4] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i];
+            dst[i * 4 + 3] = 255;
+        }
+        break;
+    }
+
+    if (options.premultiplyAlpha && (channels == 2 || channels == 4)) {
+        ImagePipeline::premultiplyAlpha(dst, count, options.srgb);
+    }
+}
+
+} // namespace
+
+namespace ImagePipeline {
+
+bool probe(const std::string& path, ImageInfo& info) {
+    return stbi_info(path.c_str(), &info.width, &info.height, &info.channels) != 0;
+}
+
+size_t decode(std::vector<DecodeTarget>& targets, const ConvertOptions& options,
+              Yume::JobSystem* jobs) {
+    PROFILE_SCOPE("DecodeImages");
+
+    struct Decoded {
+        unsigned char* data = nullptr;
+        int channels = 0;
+    };
+    std::vector<Decoded> decoded(targets.size());
+
+    // Um job por imagem: o stb_image nao divide um arquivo entre threads
+    auto decodeRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            DecodeTarget& target = targets[i];
+            target.ok = false;
+
+            int width, height, channels;
+            unsigned char* data = stbi_load(target.path.c_str(), &width, &height, &channels, 0);
+            if (!data) {
+                LOG_ERROR("Failed to decode image: %s", target.path.c_str());
+                continue;
+            }
+            if (!target.pixels || width != target.info.width || height != target.info.height) {
+                LOG_ERROR("Image changed since it was probed: %s", target.path.c_str());
+                stbi_image_free(data);
+                continue;
+            }
+            decoded[i] = {data, channels};
+        }
+    };
+
+    // A conversao roda em faixas de BAND_ROWS linhas de todas as imagens juntas
+    std::vector<size_t> firstBand(targets.size() + 1, 0);
+    for (size_t i = 0; i < targets.size(); i++) {
+        size_t bands = targets[i].pixels ? (targets[i].info.height + BAND_ROWS - 1) / BAND_ROWS : 0;
+        firstBand[i + 1] = firstBand[i] + bands;
+    }
+    auto convertRange = [&](size_t begin, size_t end) {
+        for (size_t band = begin; band < end; band++) {
+            size_t i = std::upper_bound(firstBand.begin(), firstBand.end(), band) -
+                       firstBand.begin() - 1;
+            if (!decoded[i].data) continue; // decode falhou
+            size_t height = (size_t)targets[i].info.height;
+            size_t rowBegin = (band - firstBand[i]) * BAND_ROWS;
+            convertRows(decoded[i].data, decoded[i].channels, targets[i].pixels,
+                        (size_t)targets[i].info.width, rowBegin,
+                        std::min(rowBegin + BAND_ROWS, height), options);
+        }
+    };
+
+    if (jobs) {
+        // As faixas de cada imagem dependem so do decode dela: imagens pequenas
+        // ja convertem enquanto as grandes ainda decodificam
+        std::vector<Yume::JobCounter> decodedImage(targets.size());
+        Yume::JobCounter converted;
+        const auto* decodeBody = &decodeRange;
+        const auto* convertBody = &convertRange;
+        for (size_t i = 0; i < targets.size(); i++) {
+            jobs->run([decodeBody, i]() { (*decodeBody)(i, i + 1); }, &decodedImage[i]);
+            for (size_t band = firstBand[i]; band < firstBand[i + 1]; band++) {
+                jobs->run([convertBody, band]() { (*convertBody)(band, band + 1); }, &converted,
+                          &decodedImage[i]);
+            }
+        }
+        jobs->wait(converted);
+        for (const Yume::JobCounter& counter : decodedImage) {
+            jobs->wait(counter);
+        }
+    } else {
+        decodeRange(0, targets.size());
+        convertRange(0, firstBand.back());
+    }
+
+    size_t succeeded = 0;
+    for (size_t i = 0; i < targets.size(); i++) {
+        if (!decoded[i].data) continue;
+        stbi_image_free(decoded[i].data);
+        targets[i].ok = true;
+        succeeded++;
+    }
+    return succeeded;
+}
+
+void expandRGBToRGBA(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount) {
+    size_t i = 0;
+#ifdef IMAGE_PIPELINE_X86
+    if (useSimd() && hasSSSE3()) i = expandSSSE3(rgb, rgba, pixelCount);
+#endif
+    for (; i < pixelCount; i++) {
+        rgba[i * 4] = rgb[i * 3];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+void premultiplyAlpha(uint8_t* rgba, size_t pixelCount, bool srgb) {
+    if (srgb) {
+        // Tabelas nao vetorizam bem sem gather; pixels opacos saem de graca
+        const SrgbTables& tables = srgbTables();
+        for (size_t i = 0; i < pixelCount; i++) {
+            uint8_t* p = rgba + i * 4;
+            if (p[3] == 255) continue;
+            float alpha = p[3] / 255.0f * 4095.0f;
+            for (int c = 0; c < 3; c++) {
+                p[c] = tables.fromLinear[(int)(tables.toLinear[p[c]] * alpha + 0.5f)];
+            }
+        }
+        return;
+    }
+
+    size_t i = 0;
+#ifdef IMAGE_PIPELINE_X86
+    if (useSimd()) i = premultiplySSE2(rgba, pixelCount);
+#endif
+    for (; i < pixelCount; i++) {
+        uint8_t* p = rgba + i * 4;
+        p[0] = mul255(p[0], p[3]);
+        p[1] = mul255(p[1], p[3]);
+        p[2] = mul255(p[2], p[3]);
+    }
+}
+
+void setSimdEnabled(bool enabled) { simdEnabled.store(enabled, std::memory_order_relaxed); }
+
+} // namespace ImagePipeline
@@ -0,0 +1,55 @@
+#ifndef IMAGE_PIPELINE_HPP
+#define IMAGE_PIPELINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Yume {
+class JobSystem;
+}
+
+// Decode de imagens fonte (PNG, JPG... via stb_image) direto para RGBA8 no
+// destino do chamador, normalmente memoria mapeada de um PBO ou staging
+// buffer. Cada imagem decodifica num job; a conversao para RGBA8 (expansao
+// RGB, alpha pre-multiplicado) roda depois em faixas de linhas espalhadas pelos
+// workers, entao um atlas grande tambem escala com os cores.
+namespace ImagePipeline {
+
+struct ImageInfo {
+    int width = 0;
+    int height = 0;
+    int channels = 0; // no arquivo; o destino e sempre RGBA8
+};
+
+struct ConvertOptions {
+    bool premultiplyAlpha = false;
+    bool srgb = true; // cor em sRGB: pre-multiplica em linear e volta para sRGB
+};
+
+struct DecodeTarget {
+    std::string path;
+    ImageInfo info;            // de probe(); o decode falha se o arquivo nao bater
+    uint8_t* pixels = nullptr; // width * height * 4 bytes
+    bool ok = false;
+};
+
+// So le o cabecalho
+bool probe(const std::string& path, ImageInfo& info);
+
+// Preenche target.pixels e target.ok de cada alvo; retorna quantos deram certo.
+// Sem job system (ou sem workers) tudo roda no thread que chama.
+size_t decode(std::vector<DecodeTarget>& targets, const ConvertOptions& options = ConvertOptions(),
+              Yume::JobSystem* jobs = nullptr);
+
+// Conversoes usadas pelo decode, com SSE2/SSSE3 quando a CPU tem
+void expandRGBToRGBA(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount);
+void premultiplyAlpha(uint8_t* rgba, size_t pixelCount, bool srgb);
+
+// Desliga os caminhos SIMD (comparacao no benchmark)
+void setSimdEnabled(bool enabled);
+
+} // namespace ImagePipeline
+
+#endif // IMAGE_PIPELINE_HPP
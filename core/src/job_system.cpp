@@ -0,0 +1,329 @@
+#define CLASS_NAME "JobSystem"
+#include "log_macros.hpp"
+
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <string>
+
+namespace Yume {
+
+namespace {
+
+thread_local size_t t_threadIndex = JobSystem::NO_THREAD;
+
+// Tentativas de achar trabalho antes de dormir
+constexpr int SPIN_ROUNDS = 64;
+
+} // namespace
+
+// --- WorkStealingDeque ----------------------------------------------------
+
+bool WorkStealingDeque::push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+
+    buffer[b & MASK].store(job, std::memory_order_relaxed);
+    // release: quem ler o novo bottom enxerga o conteudo do job
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+Job* WorkStealingDeque::pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[b & MASK].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Ultimo item: disputa com quem estiver roubando
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingDeque::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+
+    Job* job = buffer[t & MASK].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+// --- JobSystem ------------------------------------------------------------
+
+JobSystem::~JobSystem() { shutdown(); }
+
+bool JobSystem::init(size_t workerCount) {
+    if (!slots.empty()) {
+        LOG_WARN("Job system already initialized");
+        return true;
+    }
+
+#ifdef PLATFORM_WEBGL
+    workerCount = 0; // sem pthreads no build web
+#else
+    if (workerCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 0;
+    }
+#endif
+
+    size_t slotCount = 1 + workerCount + MAX_EXTERNAL_THREADS;
+    for (size_t i = 0; i < slotCount; i++) {
+        auto slot = std::make_unique<Slot>();
+        slot->pool.reset(new Job[JOB_POOL_SIZE]);
+        slot->inUse.reset(new std::atomic<bool>[JOB_POOL_SIZE]);
+        for (size_t j = 0; j < JOB_POOL_SIZE; j++) {
+            slot->inUse[j].store(false, std::memory_order_relaxed);
+        }
+        slots.push_back(std::move(slot));
+    }
+
+    stopping = false;
+    nextExternal = 0;
+    t_threadIndex = 0;
+
+    for (size_t i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+
+    LOG_INFO("Started %zu worker thread(s)", workerCount);
+    return true;
+}
+
+void JobSystem::shutdown() {
+    if (slots.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Termina o que ainda estiver na fila no thread que desliga
+    while (runOne()) {
+    }
+
+    // Dependencia que nunca vai zerar: descarta, mas solta quem espera o job
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        if (!waiting.empty()) {
+            LOG_WARN("Dropping %zu job(s) whose dependency never completed", waiting.size());
+        }
+        for (const Job& job : waiting) {
+            if (job.counter) job.counter->value.fetch_sub(1, std::memory_order_release);
+        }
+        waiting.clear();
+        waitingCount = 0;
+    }
+
+    slots.clear();
+    t_threadIndex = NO_THREAD;
+}
+
+size_t JobSystem::registerThread(const char* name) {
+    if (t_threadIndex != NO_THREAD) return t_threadIndex;
+
+    size_t external = nextExternal.fetch_add(1);
+    if (slots.empty() || external >= MAX_EXTERNAL_THREADS) {
+        LOG_WARN("No job slot left for thread %s", name);
+        return NO_THREAD;
+    }
+
+    t_threadIndex = 1 + workers.size() + external;
+    Profiler::setThreadName(name);
+    return t_threadIndex;
+}
+
+size_t JobSystem::getThreadIndex() { return t_threadIndex; }
+
+void JobSystem::submit(const Job& job) {
+    if (job.dependency && !job.dependency->isDone()) {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        // waitingCount sobe antes de olhar o contador e execute() olha
+        // waitingCount depois de zerar: um dos dois sempre ve o outro
+        waitingCount.fetch_add(1, std::memory_order_seq_cst);
+        if (job.dependency->value.load(std::memory_order_seq_cst) != 0) {
+            waiting.push_back(job);
+            return;
+        }
+        waitingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    enqueue(job);
+}
+
+void JobSystem::enqueue(const Job& job) {
+    if (workers.empty()) {
+        Job copy = job;
+        execute(copy);
+        return;
+    }
+
+    size_t index = t_threadIndex;
+    bool pushed = false;
+    if (index < slots.size()) {
+        Slot& slot = *slots[index];
+        size_t entry = slot.poolNext++ % JOB_POOL_SIZE;
+        // acquire: a copia de quem tirou o job anterior desta entrada ja terminou
+        if (slot.inUse[entry].load(std::memory_order_acquire)) {
+            // Um ladrao ainda esta copiando o job antigo daqui: roda na hora
+            Job copy = job;
+            execute(copy);
+            return;
+        }
+        Job* stored = &slot.pool[entry];
+        *stored = job;
+        slot.inUse[entry].store(true, std::memory_order_relaxed);
+        pushed = slot.deque.push(stored);
+        if (!pushed) {
+            // Deque cheio: roda na hora em vez de perder o job
+            slot.inUse[entry].store(false, std::memory_order_relaxed);
+            Job copy = job;
+            execute(copy);
+            return;
+        }
+    }
+    if (!pushed) {
+        std::lock_guard<std::mutex> lock(injectMutex);
+        injected.push_back(job);
+    }
+
+    queued.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+void JobSystem::releaseWaiting() {
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        auto blocked = std::stable_partition(waiting.begin(), waiting.end(), [](const Job& job) {
+            return !job.dependency->isDone();
+        });
+        ready.assign(blocked, waiting.end());
+        waiting.erase(blocked, waiting.end());
+        waitingCount.store((int)waiting.size(), std::memory_order_seq_cst);
+    }
+    for (const Job& job : ready) {
+        enqueue(job);
+    }
+}
+
+void JobSystem::copyOut(Slot& slot, const Job* stored, Job& out) {
+    out = *stored;
+    slot.inUse[stored - slot.pool.get()].store(false, std::memory_order_release);
+}
+
+bool JobSystem::takeJob(Job& out) {
+    size_t index = t_threadIndex;
+    if (index < slots.size()) {
+        if (Job* job = slots[index]->deque.pop()) {
+            copyOut(*slots[index], job, out);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(injectMutex);
+        if (!injected.empty()) {
+            out = injected.front();
+            injected.pop_front();
+            return true;
+        }
+    }
+
+    // Comeca por um vizinho diferente para cada thread, espalhando os roubos
+    size_t count = slots.size();
+    size_t start = index < count ? index + 1 : 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t victim = (start + i) % count;
+        if (victim == index) continue;
+        if (Job* job = slots[victim]->deque.steal()) {
+            copyOut(*slots[victim], job, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::runOne() {
+    Job job;
+    if (!takeJob(job)) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(Job& job) {
+    job.invoke(job.storage);
+    // Depois de zerar o contador o dono pode destrui-lo; so waitingCount e lido
+    if (job.counter && job.counter->value.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        waitingCount.load(std::memory_order_seq_cst) > 0) {
+        releaseWaiting();
+    }
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t slot) {
+    t_threadIndex = slot;
+    Profiler::setThreadName(("Worker " + std::to_string(slot)).c_str());
+
+    int idleRounds = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (runOne()) {
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        wake.wait(lock, [&] {
+            return stopping.load(std::memory_order_relaxed) ||
+                   queued.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        idleRounds = 0;
+    }
+}
+
+} // namespace Yume
@@ -0,0 +1,182 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Yume {
+
+// Numero de jobs ainda pendentes num grupo; wait() volta quando chega a zero
+struct JobCounter {
+    std::atomic<int> value{0};
+
+    bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+};
+
+struct Job {
+    static constexpr size_t STORAGE_SIZE = 48;
+
+    void (*invoke)(const void* storage) = nullptr;
+    JobCounter* counter = nullptr;
+    const JobCounter* dependency = nullptr;
+    alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+};
+
+// Deque de Chase-Lev com capacidade fixa: o dono faz push/pop no fundo sem
+// lock, os outros threads roubam do topo com um CAS.
+class WorkStealingDeque {
+  public:
+    static constexpr int64_t CAPACITY = 4096;
+
+    bool push(Job* job);
+    Job* pop();
+    Job* steal();
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Job*> buffer[CAPACITY];
+};
+
+// Workers por core com roubo de trabalho. O thread que chama init() vira o
+// slot 0 e ajuda a executar jobs enquanto espera em wait(); outros threads
+// que queiram submeter sem lock chamam registerThread(). Threads nao
+// registrados submetem por uma fila com mutex.
+//
+// Jobs sao copiados para dentro do Job (ate STORAGE_SIZE bytes, trivialmente
+// copiaveis): capture por referencia ou ponteiro e espere com um JobCounter.
+class JobSystem {
+  public:
+    static constexpr size_t NO_THREAD = SIZE_MAX;
+    static constexpr size_t MAX_EXTERNAL_THREADS = 4;
+
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // workerCount == 0 usa hardware_concurrency() - 1
+    bool init(size_t workerCount = 0);
+    void shutdown();
+    bool isRunning() const { return !workers.empty(); }
+
+    // Slot extra para um thread de longa duracao (render, streaming)
+    size_t registerThread(const char* name);
+
+    // Sem workers o job roda na hora. `dependency` adia o inicio ate o
+    // contador dela zerar: o job espera numa lista fora das filas e volta a
+    // elas quando o ultimo job daquele contador termina. O contador precisa
+    // viver ate o job dependente comecar.
+    template <typename F>
+    void run(F&& fn, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+
+    void wait(const JobCounter& counter);
+
+    // Divide [0, count) em blocos de pelo menos minBatch e chama fn(begin, end)
+    // em paralelo; retorna quando todos terminaram.
+    template <typename F> void parallelFor(size_t count, size_t minBatch, const F& fn);
+
+    // Slots = main + workers + externos; indexa estado por thread (pools etc.)
+    size_t getThreadCount() const { return slots.size(); }
+    size_t getWorkerCount() const { return workers.size(); }
+    // Slot do thread atual ou NO_THREAD
+    static size_t getThreadIndex();
+
+  private:
+    static constexpr size_t JOB_POOL_SIZE = 2 * WorkStealingDeque::CAPACITY;
+
+    // Anel de jobs apontados pelo deque. Uma entrada so volta a ser usada
+    // depois que quem a tirou do deque (dono ou ladrao) copiou o job: inUse
+    // cai com release depois da copia.
+    struct Slot {
+        WorkStealingDeque deque;
+        std::unique_ptr<Job[]> pool;
+        std::unique_ptr<std::atomic<bool>[]> inUse;
+        size_t poolNext = 0;
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextExternal{0};
+
+    std::mutex injectMutex;
+    std::deque<Job> injected;
+
+    // Jobs com dependencia pendente; nao contam em `queued`
+    std::mutex waitMutex;
+    std::vector<Job> waiting;
+    std::atomic<int> waitingCount{0};
+
+    std::atomic<int> queued{0};
+    std::atomic<int> sleepers{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void submit(const Job& job);
+    void enqueue(const Job& job);
+    void releaseWaiting();
+    bool runOne();
+    bool takeJob(Job& out);
+    static void copyOut(Slot& slot, const Job* stored, Job& out);
+    void execute(Job& job);
+    void workerLoop(size_t slot);
+};
+
+template <typename F> void JobSystem::run(F&& fn, JobCounter* counter, const JobCounter* dependency) {
+    using Fn = typename std::decay<F>::type;
+    static_assert(sizeof(Fn) <= Job::STORAGE_SIZE, "Job capture is too large, pass a pointer");
+    static_assert(std::is_trivially_copyable<Fn>::value &&
+                      std::is_trivially_destructible<Fn>::value,
+                  "Job captures must be trivially copyable");
+
+    if (counter) counter->value.fetch_add(1, std::memory_order_relaxed);
+
+    Job job;
+    job.invoke = [](const void* storage) { (*static_cast<const Fn*>(storage))(); };
+    job.counter = counter;
+    job.dependency = dependency;
+    new (job.storage) Fn(std::forward<F>(fn));
+    submit(job);
+}
+
+template <typename F> void JobSystem::parallelFor(size_t count, size_t minBatch, const F& fn) {
+    if (count == 0) return;
+    minBatch = std::max<size_t>(minBatch, 1);
+
+    size_t chunks = (count + minBatch - 1) / minBatch;
+    chunks = std::min(chunks, (workers.size() + 1) * 4);
+    if (workers.empty() || chunks <= 1) {
+        fn(size_t(0), count);
+        return;
+    }
+
+    JobCounter counter;
+    const F* body = &fn;
+    for (size_t i = 1; i < chunks; i++) {
+        size_t begin = count * i / chunks;
+        size_t end = count * (i + 1) / chunks;
+        run([body, begin, end]() { (*body)(begin, end); }, &counter);
+    }
+    fn(size_t(0), count / chunks);
+    wait(counter);
+}
+
+} // namespace Yume
+
+#endif // JOB_SYSTEM_HPP
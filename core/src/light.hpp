@@ -12,7 +12,17 @@ struct Light {
     Vector3 direction;
     ColorRGBA color;
     float intensity;
-    // float position[3];
+    // Point e spot; a direcional so usa direction
+    Vector3 position = {0.0f, 0.0f, 0.0f};
+    float range = 10.0f;
+    float innerAngle = 30.0f; // graus, metade do cone
+    float outerAngle = 45.0f;
+    // Sombra em cascatas; so a primeira direcional com castShadows projeta
+    bool castShadows = false;
+    uint8_t shadowCascades = 3;      // 1..ShadowCascades::MAX_CASCADES
+    float shadowDistance = 50.0f;    // profundidade maxima da sombra, em view space
+    float shadowSplitLambda = 0.75f; // 0 = divisoes uniformes, 1 = logaritmicas
+    float shadowBias = 0.002f;       // em profundidade normalizada do shadow map
 };
 
 #endif
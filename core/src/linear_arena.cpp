@@ -0,0 +1,55 @@
+#include "linear_arena.hpp"
+#include <algorithm>
+
+LinearArena::LinearArena(size_t capacity, size_t minBlockSize) : minBlockSize(minBlockSize) {
+    if (capacity > 0) {
+        addBlock(capacity);
+    }
+}
+
+void LinearArena::addBlock(size_t size) {
+    Block block;
+    block.data.reset(new uint8_t[size]);
+    block.size = size;
+    blocks.push_back(std::move(block));
+    offset = 0;
+}
+
+void* LinearArena::allocate(size_t size, size_t alignment) {
+    if (!blocks.empty()) {
+        Block& block = blocks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        size_t end = aligned - base + size;
+        if (end <= block.size) {
+            used += end - offset;
+            offset = end;
+            highWater = std::max(highWater, used);
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    // Estourou: bloco novo do heap, consolidado no proximo reset
+    if (!blocks.empty()) overflowCount++;
+    size_t grow = blocks.empty() ? minBlockSize : blocks.back().size * 2;
+    addBlock(std::max(grow, size + alignment));
+    return allocate(size, alignment);
+}
+
+void LinearArena::reset() {
+    if (blocks.size() > 1) {
+        // Um bloco so do tamanho do pico: o proximo frame igual nao estoura
+        size_t total = 0;
+        for (const Block& block : blocks) total += block.size;
+        blocks.clear();
+        addBlock(std::max(total, highWater));
+    }
+    offset = 0;
+    used = 0;
+}
+
+size_t LinearArena::getCapacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.size;
+    return total;
+}
@@ -0,0 +1,92 @@
+#ifndef LINEAR_ARENA_HPP
+#define LINEAR_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for data that dies all at once (one frame, one packet).
+// allocate() is a pointer increment; nothing is freed individually and reset()
+// makes the whole arena reusable. When a frame needs more than the capacity the
+// arena borrows extra blocks from the heap and, on the next reset(), replaces
+// them with a single block of the peak size, so steady-state frames never touch
+// the general heap. Not thread-safe: one writer per arena.
+class LinearArena {
+  private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks; // o ultimo e o que recebe as alocacoes
+    size_t offset = 0;         // dentro do ultimo bloco
+    size_t used = 0;           // soma do que foi entregue desde o reset
+    size_t highWater = 0;
+    size_t overflowCount = 0;
+    size_t minBlockSize;
+
+    void addBlock(size_t size);
+
+  public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit LinearArena(size_t capacity = 0, size_t minBlockSize = DEFAULT_BLOCK_SIZE);
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T> T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is never destroyed, use trivially destructible types");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Invalida tudo que foi alocado desde o ultimo reset
+    void reset();
+
+    size_t getUsed() const { return used; }
+    size_t getCapacity() const;
+    size_t getHighWater() const { return highWater; }
+    // Quantas vezes foi preciso pedir um bloco extra ao heap
+    size_t getOverflowCount() const { return overflowCount; }
+};
+
+// STL allocator over a LinearArena. deallocate() is a no-op, so containers can
+// grow (the old storage stays in the arena until reset) but should reserve up
+// front. A null arena falls back to the general heap, which lets the same
+// container type be used outside a frame.
+template <typename T> class ArenaAllocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    LinearArena* arena = nullptr;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(LinearArena* arena) : arena(arena) {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        if (!arena) return static_cast<T*>(::operator new(count * sizeof(T)));
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* ptr, size_t) {
+        if (!arena) ::operator delete(ptr);
+    }
+
+    template <typename U> bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+    template <typename U> bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+};
+
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // LINEAR_ARENA_HPP
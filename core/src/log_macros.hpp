@@ -2,12 +2,40 @@
 #define LOGGER_MACROS_HPP
 
 #include "logger.hpp"
-#include <string>
 
-#define LOG_INFO(msg) Logger::log(CLASS_NAME, __func__, (std::string("[INFO] ") + msg).c_str())
+// Nivel minimo compilado; chamadas abaixo dele somem (argumentos nao sao avaliados).
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
 
-#define LOG_WARN(msg) Logger::log(CLASS_NAME, __func__, (std::string("[WARN] ") + msg).c_str())
+#ifndef YUME_LOG_LEVEL
+#define YUME_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#if YUME_LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::log(LogLevel::DBG, CLASS_NAME, __func__, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if YUME_LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::log(LogLevel::INFO, CLASS_NAME, __func__, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if YUME_LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::log(LogLevel::WARN, CLASS_NAME, __func__, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
 
-#define LOG_ERROR(msg) Logger::log(CLASS_NAME, __func__, (std::string("[ERROR] ") + msg).c_str())
+#if YUME_LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::log(LogLevel::ERR, CLASS_NAME, __func__, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
 
 #endif
@@ -1,45 +1,312 @@
 #include "logger.hpp"
+#include <atomic>
 #include <chrono>
-#include <fstream>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+namespace {
 
-static std::ofstream g_logFile;
-static std::mutex g_logMutex;
+struct Record {
+    int64_t timeNs;
+    const char* className;
+    const char* methodName;
+    LogLevel level;
+    uint16_t length;
+    char message[Logger::MESSAGE_SIZE];
+};
+static_assert(sizeof(Record) == 256, "Record should fill exactly 4 cache lines");
 
-static std::string formatDateTime(const char* format) {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto time = system_clock::to_time_t(now);
+struct ThreadRing {
+    std::vector<Record> records = std::vector<Record>(Logger::RING_CAPACITY);
+    std::atomic<uint64_t> head{0}; // so a thread dona escreve
+    std::atomic<uint64_t> tail{0}; // so o writer escreve
+};
+
+// Texto "YYYY-mm-dd HH:MM:SS.mmm" refeito no maximo uma vez por milissegundo;
+// localtime so roda quando o segundo muda.
+struct TimestampCache {
+    int64_t second = -1;
+    int64_t millisecond = -1;
+    char text[32] = {};
+    size_t length = 0;
+
+    void update(int64_t timeNs) {
+        int64_t ms = timeNs / 1000000;
+        if (ms == millisecond) return;
+        millisecond = ms;
+
+        int64_t sec = ms / 1000;
+        if (sec != second) {
+            second = sec;
+            std::time_t time = (std::time_t)sec;
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &time);
+#else
+            localtime_r(&time, &tm);
+#endif
+            length = std::strftime(text, sizeof(text) - 4, "%Y-%m-%d %H:%M:%S", &tm);
+        }
+        int frac = (int)(ms % 1000);
+        text[length] = '.';
+        text[length + 1] = (char)('0' + frac / 100);
+        text[length + 2] = (char)('0' + frac / 10 % 10);
+        text[length + 3] = (char)('0' + frac % 10);
+    }
+};
+
+constexpr size_t BATCH_SIZE = 64 * 1024;
+constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(5);
+
+std::FILE* g_file = nullptr;
+std::atomic<bool> g_active{false};
+std::atomic<uint64_t> g_dropped{0};
+uint64_t g_reportedDropped = 0;
+
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<ThreadRing>> g_rings;
+thread_local ThreadRing* t_ring = nullptr;
+
+// Estado do writer: so tocado com g_drainMutex
+std::mutex g_drainMutex;
+TimestampCache g_timestamp;
+std::vector<char> g_batch;
+std::vector<ThreadRing*> g_drainRings; // copia de g_rings; rings nunca sao removidos
+
+#ifndef PLATFORM_WEBGL
+std::thread g_writer;
+std::mutex g_wakeMutex;
+std::condition_variable g_wake;
+std::condition_variable g_flushed;
+bool g_stopping = false;
+uint64_t g_flushRequested = 0;
+uint64_t g_flushCompleted = 0;
+#endif
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::DBG:
+        return "[DEBUG] ";
+    case LogLevel::INFO:
+        return "[INFO] ";
+    case LogLevel::WARN:
+        return "[WARN] ";
+    case LogLevel::ERR:
+        return "[ERROR] ";
+    }
+    return "";
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+ThreadRing& threadRing() {
+    if (!t_ring) {
+        auto ring = std::make_unique<ThreadRing>();
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        t_ring = ring.get();
+        g_rings.push_back(std::move(ring));
+    }
+    return *t_ring;
+}
+
+void append(const char* data, size_t size) {
+    if (g_batch.size() + size > BATCH_SIZE) {
+        std::fwrite(g_batch.data(), 1, g_batch.size(), g_file);
+        g_batch.clear();
+    }
+    g_batch.insert(g_batch.end(), data, data + size);
+}
+
+void appendLine(const Record& r) {
+    g_timestamp.update(r.timeNs);
+
+    // [time] [Class::method] [LEVEL] message
+    append("[", 1);
+    append(g_timestamp.text, g_timestamp.length + 4);
+    append("] [", 3);
+    append(r.className, std::strlen(r.className));
+    append("::", 2);
+    append(r.methodName, std::strlen(r.methodName));
+    append("] ", 2);
+    const char* level = levelName(r.level);
+    append(level, std::strlen(level));
+    append(r.message, r.length);
+    append("\n", 1);
+}
+
+// Esvazia todos os rings no arquivo. Chamado com g_drainMutex travado.
+void drainAll() {
+    if (!g_file) return;
+
+    // So a lista e copiada com o registro travado; formatar e escrever fica fora
+    // dele para um arquivo lento nao segurar threads registrando o ring
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        for (size_t i = g_drainRings.size(); i < g_rings.size(); i++) {
+            g_drainRings.push_back(g_rings[i].get());
+        }
+    }
+
+    for (ThreadRing* ring : g_drainRings) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+            appendLine(ring->records[tail & (Logger::RING_CAPACITY - 1)]);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    uint64_t dropped = g_dropped.load(std::memory_order_relaxed);
+    if (dropped != g_reportedDropped) {
+        Record r{};
+        r.timeNs = nowNs();
+        r.className = "Logger";
+        r.methodName = "drain";
+        r.level = LogLevel::WARN;
+        r.length = (uint16_t)std::snprintf(r.message, sizeof(r.message),
+                                           "%llu messages dropped (ring full)",
+                                           (unsigned long long)(dropped - g_reportedDropped));
+        appendLine(r);
+        g_reportedDropped = dropped;
+    }
+
+    if (!g_batch.empty()) {
+        std::fwrite(g_batch.data(), 1, g_batch.size(), g_file);
+        g_batch.clear();
+        std::fflush(g_file);
+    }
+}
+
+#ifndef PLATFORM_WEBGL
+void writerLoop() {
+    std::unique_lock<std::mutex> lock(g_wakeMutex);
+    while (true) {
+        g_wake.wait_for(lock, WRITER_INTERVAL);
+        bool stopping = g_stopping;
+        uint64_t requested = g_flushRequested;
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> drainLock(g_drainMutex);
+            drainAll();
+        }
+
+        lock.lock();
+        g_flushCompleted = requested;
+        g_flushed.notify_all();
+        if (stopping) return;
+    }
+}
+#endif
+
+std::string formatFileDate() {
+    std::time_t time = std::time(nullptr);
     std::tm tm{};
 #ifdef _WIN32
     localtime_s(&tm, &time);
 #else
     localtime_r(&time, &tm);
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, format);
-    return oss.str();
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d_%H-%M-%S", &tm);
+    return buffer;
 }
 
+} // namespace
+
 void Logger::init(const char* baseName) {
-    std::string filename =
-        "logs/" + std::string(baseName) + "_" + formatDateTime("%Y-%m-%d_%H-%M-%S") + ".log";
-    g_logFile.open(filename, std::ios::out | std::ios::app);
+    std::string filename = "logs/" + std::string(baseName) + "_" + formatFileDate() + ".log";
+    g_file = std::fopen(filename.c_str(), "a");
+    if (!g_file) return;
+
+    g_batch.reserve(BATCH_SIZE);
+    g_active = true;
+
+#ifndef PLATFORM_WEBGL
+    g_stopping = false;
+    g_writer = std::thread(writerLoop);
+#endif
 }
 
 void Logger::shutdown() {
-    if (g_logFile.is_open())
-        g_logFile.close();
+    if (!g_active.exchange(false)) return;
+
+#ifndef PLATFORM_WEBGL
+    {
+        std::lock_guard<std::mutex> lock(g_wakeMutex);
+        g_stopping = true;
+    }
+    g_wake.notify_one();
+    g_writer.join();
+#endif
+
+    std::lock_guard<std::mutex> lock(g_drainMutex);
+    drainAll();
+    std::fclose(g_file);
+    g_file = nullptr;
 }
 
-void Logger::log(const char* className, const char* methodName, const char* message) {
-    std::lock_guard<std::mutex> lock(g_logMutex);
-    if (!g_logFile.is_open())
+void Logger::log(LogLevel level, const char* className, const char* methodName,
+                 const char* format, ...) {
+    if (!g_active.load(std::memory_order_relaxed)) return;
+
+    ThreadRing& ring = threadRing();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
         return;
-    g_logFile << "[" << formatDateTime("%Y-%m-%d %H:%M:%S") << "] "
-              << "[" << className << "::" << methodName << "] " << message << std::endl;
+    }
+
+    Record& r = ring.records[head & (RING_CAPACITY - 1)];
+    r.timeNs = nowNs();
+    r.className = className;
+    r.methodName = methodName;
+    r.level = level;
+
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(r.message, MESSAGE_SIZE, format, args);
+    va_end(args);
+    if (length < 0) length = 0;
+    r.length = (uint16_t)(length < (int)MESSAGE_SIZE ? length : MESSAGE_SIZE - 1);
+
+    ring.head.store(head + 1, std::memory_order_release);
+
+#ifdef PLATFORM_WEBGL
+    // Sem threads no navegador: escreve na hora
+    std::lock_guard<std::mutex> lock(g_drainMutex);
+    drainAll();
+#else
+    if (level == LogLevel::ERR) {
+        g_wake.notify_one(); // erros nao esperam o proximo ciclo do writer
+    }
+#endif
 }
+
+void Logger::flush() {
+    if (!g_active.load(std::memory_order_relaxed)) return;
+
+#ifdef PLATFORM_WEBGL
+    std::lock_guard<std::mutex> lock(g_drainMutex);
+    drainAll();
+#else
+    std::unique_lock<std::mutex> lock(g_wakeMutex);
+    uint64_t ticket = ++g_flushRequested;
+    g_wake.notify_one();
+    g_flushed.wait(lock, [&] { return g_flushCompleted >= ticket || g_stopping; });
+#endif
+}
+
+uint64_t Logger::getDroppedCount() { return g_dropped.load(std::memory_order_relaxed); }
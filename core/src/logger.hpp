@@ -1,11 +1,37 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <cstddef>
+#include <cstdint>
+
+// DBG/ERR porque DEBUG e ERROR costumam ser macros (windows.h, -DDEBUG)
+enum class LogLevel : uint8_t { DBG, INFO, WARN, ERR };
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define LOG_PRINTF_FORMAT(fmt, args)
+#endif
+
+// Asynchronous file logger. log() formats straight into a fixed-size slot of a
+// per-thread ring (no heap, no lock); a background writer drains every ring,
+// stamps the lines and hands them to the file in batches.
 class Logger {
   public:
-    static void init(const char* filename);
+    static constexpr size_t MESSAGE_SIZE = 228; // Record fica com 256 bytes
+    static constexpr size_t RING_CAPACITY = 1024;
+
+    static void init(const char* baseName);
     static void shutdown();
-    static void log(const char* className, const char* methodName, const char* message);
+
+    static void log(LogLevel level, const char* className, const char* methodName,
+                    const char* format, ...) LOG_PRINTF_FORMAT(4, 5);
+
+    // Blocks until everything logged so far has reached the file.
+    static void flush();
+
+    // Records lost because a thread's ring was full.
+    static uint64_t getDroppedCount();
 };
 
 #endif
@@ -4,17 +4,24 @@
 
 #include "scene.hpp"
 #include "scene_manager.hpp"
-#include "stb_image_header.hpp"
 
+#include "frame_memory.hpp"
+#include "game_loop.hpp"
 #include "game_object_manager.hpp"
+#include "renderer/frame_capture.hpp"
+#include "renderer/render_thread.hpp"
 #include "vector3.hpp"
 #include "window/window_desc.hpp"
 #include "window/window_manager.hpp"
 #include "logger.hpp"
+#include "profiler.hpp"
+#include "stats.hpp"
 #include <SDL2/SDL_keycode.h>
 
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 #include <SDL2/SDL.h>
@@ -32,6 +39,17 @@ std::unique_ptr<WindowManager> screenManager;
 std::unique_ptr<SceneManager> sceneManager;
 RendererBackend* rendererBackend = nullptr;
 WindowDesc winDesc;
+FrameCapture frameCapture;
+GameLoop gameLoop;
+RenderThread renderThread;
+bool useRenderThread = true;
+size_t textureBudgetMb = 0; // 0 = sem limite
+bool textureStreaming = false;
+
+// Estado simulado da camera; o render usa a interpolacao entre os dois ultimos ticks
+Camera* trackedCamera = nullptr;
+Interpolated<Vector3> camPosition;
+Interpolated<Vector3> camTarget;
 
 auto inputMan = Yume::IInputFactory::create();
 Yume::Context engine(inputMan);
@@ -47,6 +65,10 @@ void init() {
     screenManager->init(winDesc);
 
     rendererBackend = screenManager->getRenderer()->getRendererBackend();
+    // Antes de carregar a cena: o loader decodifica as malhas nos workers
+    screenManager->getRenderer()->setJobSystem(&engine.getJobSystem());
+    screenManager->getRenderer()->getTextureManager().setBudget(textureBudgetMb * 1024 * 1024);
+    rendererBackend->setTextureStreaming(textureStreaming);
 
     sceneManager = std::make_unique<SceneManager>();
     sceneManager->setRendererBackend(*rendererBackend);
@@ -59,7 +81,34 @@ void init() {
     });
 
     engine.getInputSystem().bindKey(SDLK_SPACE, [&]() { 
+        // Os packets em voo ainda apontam para as malhas da cena antiga
+        renderThread.pause();
         sceneManager->loadScene("cena2");
+        renderThread.resume();
+        trackedCamera = nullptr;
+    });
+
+    engine.getInputSystem().bindKey(SDLK_F10, [&]() {
+        Stats::setOverlayVisible(!Stats::isOverlayVisible());
+    });
+
+    engine.getInputSystem().bindKey(SDLK_F11, [&]() {
+        if (Profiler::isEnabled()) {
+            Profiler::stop();
+            Profiler::writeChromeTrace("profile.json");
+        } else {
+            Profiler::start();
+        }
+    });
+
+    engine.getInputSystem().bindKey(SDLK_F12, [&]() {
+        renderThread.pause();
+        if (frameCapture.isRecording()) {
+            frameCapture.stop();
+        } else {
+            frameCapture.start(*rendererBackend, "captures");
+        }
+        renderThread.resume();
     });
 }
 
@@ -84,48 +133,78 @@ void main_loop() {
 }
 #else
 void main_loop() {
-    static Uint64 lastTime = SDL_GetPerformanceCounter();
-    static float deltaTime = 0.0f;
-
-    float moveSpeed = 2.0f;
+    const float moveSpeed = 2.0f;
 
-    bool running = true;
-    while (running) {
-        Uint64 currentTime = SDL_GetPerformanceCounter();
-        deltaTime = (float)(currentTime - lastTime) / SDL_GetPerformanceFrequency();
-        lastTime = currentTime;
+    Profiler::setThreadName("Main");
 
+    gameLoop.setInput([&]() {
+        PROFILE_SCOPE("Input");
         engine.getInputSystem().processEvents();
-
         if (engine.getInputSystem().getQuitEvent()) {
-            running = false;
+            gameLoop.stop();
+        }
+    });
+
+    gameLoop.setUpdate([&](double dt) {
+        Camera* cam = sceneManager->getActiveScene()->getCamera();
+        if (cam != trackedCamera) {
+            // Cena nova ou recarregada: recomeca sem interpolar a partir da antiga
+            trackedCamera = cam;
+            if (cam) {
+                camPosition.reset(cam->getPosition());
+                camTarget.reset(cam->getTarget());
+            }
         }
+        if (!cam) return;
+
+        camPosition.commit();
+        camTarget.commit();
+
+        Vector3 delta = {0, 0, 0};
+        float tickSpeed = moveSpeed * (float)dt;
+
+        if (engine.getInputSystem().isKeyPressed(SDLK_w))
+            delta.z -= tickSpeed;
+        if (engine.getInputSystem().isKeyPressed(SDLK_s))
+            delta.z += tickSpeed;
+        if (engine.getInputSystem().isKeyPressed(SDLK_a))
+            delta.x -= tickSpeed;
+        if (engine.getInputSystem().isKeyPressed(SDLK_d))
+            delta.x += tickSpeed;
+
+        const Vector3& pos = camPosition.get();
+        const Vector3& target = camTarget.get();
+        camPosition.set({pos.x + delta.x, pos.y + delta.y, pos.z + delta.z});
+        camTarget.set({target.x + delta.x, target.y + delta.y, target.z + delta.z});
+    });
 
+    gameLoop.setRender([&](float alpha) {
         Camera* cam = sceneManager->getActiveScene()->getCamera();
-        if (cam) {
-            Vector3 pos = cam->getPosition();
-            Vector3 target = cam->getTarget();
-            Vector3 delta = {0, 0, 0};
-
-            float frameSpeed = moveSpeed * deltaTime;
-
-            if (engine.getInputSystem().isKeyPressed(SDLK_w))
-                delta.z -= frameSpeed;
-            if (engine.getInputSystem().isKeyPressed(SDLK_s))
-                delta.z += frameSpeed;
-            if (engine.getInputSystem().isKeyPressed(SDLK_a))
-                delta.x -= frameSpeed;
-            if (engine.getInputSystem().isKeyPressed(SDLK_d))
-                delta.x += frameSpeed;
-
-            cam->setPosition({pos.x + delta.x, pos.y + delta.y, pos.z + delta.z});
-            cam->setTarget({target.x + delta.x, target.y + delta.y, target.z + delta.z});
+        if (cam && cam == trackedCamera) {
+            cam->setPosition(camPosition.get(alpha));
+            cam->setTarget(camTarget.get(alpha));
         }
 
-        screenManager->render(*sceneManager->getActiveScene());
-        screenManager->present();
+        // So a copia vai para o render thread; a simulacao segue no proximo tick
+        FramePacket& packet = renderThread.beginFrame();
+        screenManager->getRenderer()->buildFramePacket(*sceneManager->getActiveScene(), packet);
+        renderThread.submitFrame();
+
+        Profiler::collect();
+        Stats::endFrame(gameLoop.getPacing().frameMs);
+        FrameMemory::endFrame();
+    });
+
+    renderThread.setFrameRenderedCallback([]() { frameCapture.onFrameRendered(); });
+    renderThread.setRenderer(*screenManager->getRenderer(), screenManager->getWindow());
+    if (useRenderThread) {
+        renderThread.start();
     }
 
+    gameLoop.run();
+
+    renderThread.stop();
+    frameCapture.stop();
     SDL_Quit();
 }
 
@@ -134,6 +213,27 @@ void main_loop() {
 int main(int argc, char* argv[]) {
         Logger::init("engine");
 
+        size_t workerCount = 0;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--stats-csv") == 0 && i + 1 < argc) {
+                Stats::startCsv(argv[++i]);
+            } else if (std::strcmp(argv[i], "--max-fps") == 0 && i + 1 < argc) {
+                gameLoop.setFrameRateLimit(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+                gameLoop.setFixedTimestep(1.0 / std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+                workerCount = (size_t)std::atoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--texture-budget-mb") == 0 && i + 1 < argc) {
+                textureBudgetMb = (size_t)std::atoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--texture-streaming") == 0) {
+                textureStreaming = true;
+            } else if (std::strcmp(argv[i], "--no-render-thread") == 0) {
+                useRenderThread = false;
+            }
+        }
+
+        engine.getJobSystem().init(workerCount);
+
         init();
 
 #ifdef PLATFORM_WEBGL
@@ -142,6 +242,8 @@ int main(int argc, char* argv[]) {
         main_loop();
 #endif
 
+        engine.getJobSystem().shutdown();
+        Stats::stopCsv();
         Logger::shutdown();
         return 0;
 }
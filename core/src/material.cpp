@@ -2,7 +2,6 @@
 #include "log_macros.hpp"
 
 #include "color.hpp"
-#include "light.hpp"
 #include "material.hpp"
 
 
@@ -13,7 +12,9 @@ bool Material::init() {
         return false;
     }
 
-    if (!vertexShader->load() || !fragmentShader->load()) {
+    // Shaders vindos do ShaderCache ja chegam compilados
+    if ((!vertexShader->isLoaded() && !vertexShader->load()) ||
+        (!fragmentShader->isLoaded() && !fragmentShader->load())) {
         return false;
     }
 
@@ -42,21 +43,3 @@ void Material::setBaseColor(const ColorRGBA color) {
         shaderProgram->setUniformBuffer("MaterialData", &baseColor, sizeof(baseColor));
     }
 }
-
-void Material::applyLight(const Light light) {
-    if (!shaderProgram) {
-        LOG_WARN("Can not apply light on material with null shaderProgram");
-        return;
-    }
-
-    if (light.type == LightType::DIRECTIONAL) {
-        struct LightDataBuffer {
-            Vector3 direction;
-            float padding;
-            ColorRGBA color;
-            float intensity;
-        } lightData = {light.direction, 0.0f, light.color, light.intensity};
-        
-        shaderProgram->setUniformBuffer("LightData", &lightData, sizeof(lightData));
-    }
-}
\ No newline at end of file
@@ -2,15 +2,15 @@
 #define MATERIAL_HPP
 
 #include "color.hpp"
-#include "light.hpp"
 #include "shader_asset.hpp"
 #include "shader_program.hpp"
 #include <memory>
 
 class Material {
   private:
-    std::unique_ptr<ShaderAsset> vertexShader;
-    std::unique_ptr<ShaderAsset> fragmentShader;
+    // Compartilhados entre materiais da mesma variante (ShaderCache)
+    std::shared_ptr<ShaderAsset> vertexShader;
+    std::shared_ptr<ShaderAsset> fragmentShader;
     std::unique_ptr<ShaderProgram> shaderProgram;
     ColorRGBA baseColor = COLOR::RED;
 
@@ -20,11 +20,10 @@ class Material {
     bool init();
     void use();
     void setBaseColor(const ColorRGBA color);
-    void applyLight(const Light light);
 
-    void setVertexShader(std::unique_ptr<ShaderAsset> shader) { vertexShader = std::move(shader); }
+    void setVertexShader(std::shared_ptr<ShaderAsset> shader) { vertexShader = std::move(shader); }
 
-    void setFragmentShader(std::unique_ptr<ShaderAsset> shader) {
+    void setFragmentShader(std::shared_ptr<ShaderAsset> shader) {
         fragmentShader = std::move(shader);
     }
 
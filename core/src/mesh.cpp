@@ -1,5 +1,7 @@
 #include "mesh.hpp"
 #include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
 
 bool Mesh::configure() {
     bool result = meshBuffer->createBuffers(vertices, normals);
@@ -7,7 +9,32 @@ bool Mesh::configure() {
     return result;
 }
 
-void Mesh::setVertices(const std::vector<float>& v) { vertices = v; }
+void Mesh::setVertices(const std::vector<float>& v) {
+    vertices = v;
+
+    if (vertices.size() < 3) {
+        boundsCenter = glm::vec3(0.0f);
+        boundsRadius = 0.0f;
+        return;
+    }
+
+    // Centro da AABB; o raio e a maior distancia ate ele
+    glm::vec3 lo(vertices[0], vertices[1], vertices[2]);
+    glm::vec3 hi = lo;
+    for (size_t i = 3; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 p(vertices[i], vertices[i + 1], vertices[i + 2]);
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    boundsCenter = (lo + hi) * 0.5f;
+
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 d = glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]) - boundsCenter;
+        radiusSq = std::max(radiusSq, glm::dot(d, d));
+    }
+    boundsRadius = std::sqrt(radiusSq);
+}
 
 const std::vector<float>& Mesh::getVertices() const { return vertices; }
 
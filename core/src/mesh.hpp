@@ -2,6 +2,7 @@
 #define MESH_HPP
 
 #include "mesh_buffer.hpp"
+#include <glm/glm.hpp>
 #include <memory>
 #include <vector>
 
@@ -10,12 +11,17 @@ class Mesh {
     std::vector<float> vertices;
     std::vector<float> normals;
     std::unique_ptr<MeshBuffer> meshBuffer;
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
 
   public:
     Mesh() = default;
 
     void setVertices(const std::vector<float>& v);
     const std::vector<float>& getVertices() const;
+    // Esfera envolvente em espaco local, recalculada em setVertices
+    const glm::vec3& getBoundsCenter() const { return boundsCenter; }
+    float getBoundsRadius() const { return boundsRadius; }
     void setNormals(const std::vector<float>& n);
     const std::vector<float>& getNormals() const;
 
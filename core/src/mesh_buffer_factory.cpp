@@ -1,5 +1,8 @@
 #include "mesh_buffer_factory.hpp"
 
+#include "renderer/backends/null/null_mesh_buffer.hpp"
+#include "renderer/backends/null/null_renderer_backend.hpp"
+
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_mesh_buffer.hpp"
 #else
@@ -25,6 +28,8 @@ std::unique_ptr<MeshBuffer> MeshBufferFactory::create(GraphicsAPI api, void* con
         return std::make_unique<D3D12MeshBuffer>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NULL_BACKEND:
+        return std::make_unique<NullMeshBuffer>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
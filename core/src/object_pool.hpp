@@ -0,0 +1,148 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Reference to an object in an ObjectPool. Stays safe to hold after the object
+// is destroyed: the slot generation no longer matches and get() returns null.
+template <typename T> struct PoolHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const PoolHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PoolHandle& other) const { return !(*this == other); }
+};
+
+// Typed pool with fixed-size slabs and a free list. A fresh pool hands out slots
+// in order, so objects created in sequence end up contiguous; pointers stay
+// stable because slabs never move. clear() destroys everything and returns the
+// memory one slab at a time instead of one free per object. Not thread-safe.
+template <typename T> class ObjectPool {
+  private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    size_t slabSize;
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    // Geracao impar = slot ocupado; sobrevive ao clear() para invalidar handles
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeList;
+    uint32_t nextIndex = 0; // primeiro slot nunca usado
+    size_t liveCount = 0;
+
+    T* slotPointer(uint32_t index) const {
+        Slot& slot = slabs[index / slabSize][index % slabSize];
+        return std::launder(reinterpret_cast<T*>(slot.storage));
+    }
+
+    void addSlab() {
+        slabs.emplace_back(new Slot[slabSize]);
+        if (generations.size() < slabs.size() * slabSize) {
+            generations.resize(slabs.size() * slabSize, 0);
+        }
+    }
+
+  public:
+    static constexpr size_t DEFAULT_SLAB_SIZE = 1024;
+
+    explicit ObjectPool(size_t slabSize = DEFAULT_SLAB_SIZE)
+        : slabSize(slabSize > 0 ? slabSize : 1) {}
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ~ObjectPool() { clear(); }
+
+    // Garante slabs para `count` objetos vivos sem alocar durante o load
+    void reserve(size_t count) {
+        while (slabs.size() * slabSize < count) addSlab();
+    }
+
+    template <typename... Args> PoolHandle<T> create(Args&&... args) {
+        uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            if (nextIndex == slabs.size() * slabSize) addSlab();
+            index = nextIndex++;
+        }
+
+        Slot& slot = slabs[index / slabSize][index % slabSize];
+        new (slot.storage) T(std::forward<Args>(args)...);
+        uint32_t& generation = generations[index];
+        generation++;
+        liveCount++;
+        return PoolHandle<T>{index, generation};
+    }
+
+    T* get(PoolHandle<T> handle) const {
+        if (!isAlive(handle)) return nullptr;
+        return slotPointer(handle.index);
+    }
+
+    // Handle de um objeto vivo do pool a partir do ponteiro (busca pelos slabs)
+    PoolHandle<T> getHandle(const T* object) const {
+        auto address = reinterpret_cast<uintptr_t>(object);
+        for (size_t s = 0; s < slabs.size(); s++) {
+            auto begin = reinterpret_cast<uintptr_t>(slabs[s].get());
+            if (address < begin || address >= begin + slabSize * sizeof(Slot)) continue;
+
+            uint32_t index = (uint32_t)(s * slabSize + (address - begin) / sizeof(Slot));
+            if (index < nextIndex && (generations[index] & 1u)) {
+                return PoolHandle<T>{index, generations[index]};
+            }
+            break;
+        }
+        return PoolHandle<T>{};
+    }
+
+    bool isAlive(PoolHandle<T> handle) const {
+        return handle.index < nextIndex && generations[handle.index] == handle.generation &&
+               (handle.generation & 1u);
+    }
+
+    void destroy(PoolHandle<T> handle) {
+        if (!isAlive(handle)) return;
+        slotPointer(handle.index)->~T();
+        generations[handle.index]++;
+        freeList.push_back(handle.index);
+        liveCount--;
+    }
+
+    // Destroi todos os objetos vivos e devolve os slabs
+    void clear() {
+        for (uint32_t i = 0; i < nextIndex; i++) {
+            if (generations[i] & 1u) {
+                slotPointer(i)->~T();
+                generations[i]++;
+            }
+        }
+        slabs.clear();
+        freeList.clear();
+        nextIndex = 0;
+        liveCount = 0;
+    }
+
+    // Percorre os vivos na ordem dos slots
+    template <typename F> void forEach(F&& fn) {
+        for (uint32_t i = 0; i < nextIndex; i++) {
+            if (generations[i] & 1u) fn(*slotPointer(i));
+        }
+    }
+
+    size_t size() const { return liveCount; }
+    size_t getSlabCount() const { return slabs.size(); }
+    size_t getCapacity() const { return slabs.size() * slabSize; }
+};
+
+#endif // OBJECT_POOL_HPP
@@ -0,0 +1,7 @@
+#ifndef PRESENT_MODE_HPP
+#define PRESENT_MODE_HPP
+
+// FIFO e sempre suportado; os outros caem para FIFO quando o driver nao oferece
+enum class PresentMode { FIFO, FIFO_RELAXED, MAILBOX, IMMEDIATE };
+
+#endif // PRESENT_MODE_HPP
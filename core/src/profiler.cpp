@@ -0,0 +1,157 @@
+#define CLASS_NAME "Profiler"
+#include "log_macros.hpp"
+
+#include "profiler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t RING_CAPACITY = 1 << 15; // potencia de 2
+constexpr size_t MAX_COLLECTED = 1 << 22;
+
+struct ThreadBuffer {
+    std::vector<Profiler::Event> events = std::vector<Profiler::Event>(RING_CAPACITY);
+    std::atomic<uint64_t> head{0}; // so a thread dona escreve
+    std::atomic<uint64_t> tail{0}; // so collect() escreve
+    uint32_t tid = 0;
+    std::string name;
+};
+
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_threads;
+std::atomic<bool> g_enabled{false};
+std::atomic<uint64_t> g_dropped{0};
+
+std::mutex g_collectMutex;
+struct CollectedEvent {
+    Profiler::Event event;
+    uint32_t tid;
+};
+std::vector<CollectedEvent> g_collected;
+
+const auto g_epoch = std::chrono::steady_clock::now();
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        buffer->tid = (uint32_t)g_threads.size();
+        buffer->name = "Thread " + std::to_string(buffer->tid);
+        t_buffer = buffer.get();
+        g_threads.push_back(std::move(buffer));
+    }
+    return *t_buffer;
+}
+
+} // namespace
+
+void Profiler::start() {
+    {
+        std::lock_guard<std::mutex> lock(g_collectMutex);
+        g_collected.clear();
+    }
+    g_dropped = 0;
+    g_enabled = true;
+}
+
+void Profiler::stop() {
+    g_enabled = false;
+    collect();
+    if (g_dropped > 0) {
+        LOG_WARN("%llu profiler events dropped (ring full)",
+                 (unsigned long long)g_dropped.load());
+    }
+}
+
+bool Profiler::isEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    buffer.name = name;
+}
+
+uint64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                g_epoch)
+               .count() +
+           1; // 0 fica reservado para "scope desligado"
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs, Track track) {
+    if (!isEnabled()) return;
+
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[head & (RING_CAPACITY - 1)] = {name, startNs, endNs, track};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::collect() {
+    std::lock_guard<std::mutex> collectLock(g_collectMutex);
+    std::lock_guard<std::mutex> registryLock(g_registryMutex);
+
+    for (auto& buffer : g_threads) {
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+        for (; tail < head; tail++) {
+            if (g_collected.size() < MAX_COLLECTED) {
+                g_collected.push_back({buffer->events[tail & (RING_CAPACITY - 1)], buffer->tid});
+            } else {
+                g_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        buffer->tail.store(head, std::memory_order_release);
+    }
+}
+
+bool Profiler::writeChromeTrace(const char* path) {
+    collect();
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> collectLock(g_collectMutex);
+    fprintf(file, "{\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPU\"}},\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"GPU\"}}");
+    {
+        std::lock_guard<std::mutex> registryLock(g_registryMutex);
+        for (auto& buffer : g_threads) {
+            fprintf(file,
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                    "\"args\":{\"name\":\"%s\"}}",
+                    buffer->tid, buffer->name.c_str());
+        }
+    }
+
+    // Chrome trace usa microssegundos
+    for (const auto& e : g_collected) {
+        bool gpu = e.event.track == Track::GPU;
+        fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                e.event.name, gpu ? 2 : 1, gpu ? 0 : e.tid, e.event.startNs / 1000.0,
+                (e.event.endNs - e.event.startNs) / 1000.0);
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    LOG_INFO("Wrote %zu events to %s", g_collected.size(), path);
+    return true;
+}
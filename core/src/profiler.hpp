@@ -0,0 +1,53 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstdint>
+
+// Profiler de frame. Cada thread escreve seus eventos num ring SPSC proprio
+// (sem lock no caminho quente); collect() drena todos os rings na thread
+// principal e writeChromeTrace() exporta para chrome://tracing / Perfetto.
+class Profiler {
+  public:
+    enum class Track : uint8_t { CPU, GPU };
+
+    struct Event {
+        const char* name; // precisa ser um literal ou ter vida estatica
+        uint64_t startNs;
+        uint64_t endNs;
+        Track track;
+    };
+
+    static void start();
+    static void stop();
+    static bool isEnabled();
+
+    // Nome mostrado no trace para a thread que chama
+    static void setThreadName(const char* name);
+
+    static uint64_t now();
+    static void record(const char* name, uint64_t startNs, uint64_t endNs,
+                       Track track = Track::CPU);
+
+    // Move os eventos dos rings para o buffer de exportacao; chamar uma vez por frame
+    static void collect();
+    static bool writeChromeTrace(const char* path);
+};
+
+class ProfileScope {
+  private:
+    const char* name;
+    uint64_t start;
+
+  public:
+    explicit ProfileScope(const char* name)
+        : name(name), start(Profiler::isEnabled() ? Profiler::now() : 0) {}
+    ~ProfileScope() {
+        if (start) Profiler::record(name, start, Profiler::now());
+    }
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // PROFILER_HPP
@@ -247,6 +247,8 @@ bool D3D12RendererBackend::createConstantBuffers() {
     bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 
     for (int i = 0; i < 3; i++) {
+        // LightData leva o LightBuffer inteiro; CBVs sao multiplos de 256
+        bufferDesc.Width = i == 2 ? (sizeof(LightBuffer) + 255) & ~255 : 256;
         if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
                                                    D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
                                                    IID_PPV_ARGS(&constantBuffers[i]))))
@@ -383,6 +385,10 @@ void D3D12RendererBackend::updateConstantBuffer(int binding, const void* data, s
     }
 }
 
+void D3D12RendererBackend::submitLights(const LightBuffer& lights) {
+    updateConstantBuffer(2, &lights, lights.getUsedBytes());
+}
+
 unsigned int D3D12RendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
     return 0;
 }
@@ -439,15 +445,11 @@ void D3D12RendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjec
 
         mat->use();
         applyMaterial(mat);
-
-        if (lights && !lights->empty()) {
-            mat->applyLight((*lights)[0]);
-        }
-
         draw(*mesh);
     }
 }
 
-unsigned int D3D12RendererBackend::loadTexture(const std::string& path, uint8_t filterType) { return 0; };
+unsigned int D3D12RendererBackend::loadTexture(const std::string& path,
+                                               const SamplerDesc& sampler) { return 0; };
     
 void D3D12RendererBackend::drawSprite(const Sprite& sprite) {};
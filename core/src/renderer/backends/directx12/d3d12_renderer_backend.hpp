@@ -43,13 +43,17 @@ private:
 public:
     ~D3D12RendererBackend();
 
-    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    unsigned int loadTexture(const std::string& path,
+                             const SamplerDesc& sampler = SamplerDesc()) override;
+    void deleteTexture(unsigned int textureID) override {}
+    size_t getTextureBytes(unsigned int textureID) const override { return 0; }
     void drawSprite(const Sprite& sprite) override;
     bool init() override;
     bool initWindowContext() override;
     void bindCamera(Camera* camera) override;
     void applyMaterial(Material* material) override;
     void renderGameObjects(std::vector<GameObject*>* gameObjects, std::vector<Light>* lights) override;
+    void submitLights(const LightBuffer& lights) override;
     void clear(Camera* camera) override;
     void draw(const Mesh&) override;
     void setUniforms(ShaderProgram* shaderProgram) override;
@@ -114,7 +114,7 @@ void D3D12ShaderProgram::use() {
 void D3D12ShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
     auto it = uniformBindings.find(name);
     if (it == uniformBindings.end()) {
-        LOG_WARN("Uniform " + std::string(name) + " not found!");
+        LOG_WARN("Uniform %s not found!", name);
         return;
     }
 
@@ -0,0 +1,127 @@
+#define CLASS_NAME "NullCommandList"
+#include "../../../log_macros.hpp"
+
+#include "null_command_list.hpp"
+#include <cstdio>
+
+namespace {
+
+const char MAGIC[4] = {'Y', 'C', 'M', 'D'};
+const uint32_t VERSION = 1;
+
+const char* const OP_NAMES[NullCommandList::OP_COUNT] = {
+    "clear",        "set_camera", "set_model",   "bind_program", "upload_uniform",
+    "bind_texture", "draw",       "draw_sprite", "draw_skybox",  "present",
+    "light_clusters", "upload_lights", "shadow_cascade", "shadow_draw",
+};
+
+} // namespace
+
+void NullCommandList::push(NullOp op, const void* payload, size_t size) {
+    if (size > UINT16_MAX) {
+        LOG_ERROR("Payload of %zu bytes is too large for %s", size, getOpName(op));
+        return;
+    }
+
+    uint16_t size16 = static_cast<uint16_t>(size);
+    size_t offset = bytes.size();
+    bytes.resize(offset + HEADER_SIZE + size);
+    bytes[offset] = static_cast<uint8_t>(op);
+    bytes[offset + 1] = 0;
+    std::memcpy(&bytes[offset + 2], &size16, sizeof(size16));
+    if (size > 0) {
+        std::memcpy(&bytes[offset + HEADER_SIZE], payload, size);
+    }
+
+    opCounts[static_cast<size_t>(op)]++;
+    commandCount++;
+}
+
+void NullCommandList::clear() {
+    bytes.clear();
+    opCounts.fill(0);
+    commandCount = 0;
+}
+
+size_t NullCommandList::getDrawCount() const {
+    return getCount(NullOp::DRAW) + getCount(NullOp::DRAW_SPRITE) +
+           getCount(NullOp::DRAW_SKYBOX);
+}
+
+uint64_t NullCommandList::getHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t byte : bytes) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool NullCommandList::save(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", path.c_str());
+        return false;
+    }
+
+    uint64_t size = bytes.size();
+    bool ok = std::fwrite(MAGIC, sizeof(MAGIC), 1, file) == 1 &&
+              std::fwrite(&VERSION, sizeof(VERSION), 1, file) == 1 &&
+              std::fwrite(&size, sizeof(size), 1, file) == 1 &&
+              (size == 0 || std::fwrite(bytes.data(), size, 1, file) == 1);
+    std::fclose(file);
+
+    if (!ok) {
+        LOG_ERROR("Failed to write %s", path.c_str());
+    }
+    return ok;
+}
+
+bool NullCommandList::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", path.c_str());
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t size = 0;
+    bool ok = std::fread(magic, sizeof(magic), 1, file) == 1 &&
+              std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == VERSION &&
+              std::fread(&size, sizeof(size), 1, file) == 1;
+
+    clear();
+    if (ok) {
+        bytes.resize(size);
+        ok = size == 0 || std::fread(bytes.data(), size, 1, file) == 1;
+    }
+    std::fclose(file);
+
+    if (!ok) {
+        LOG_ERROR("Invalid command list file: %s", path.c_str());
+        clear();
+        return false;
+    }
+
+    forEach([this, &ok](const Command& cmd) {
+        size_t index = static_cast<size_t>(cmd.op);
+        if (index >= OP_COUNT) {
+            ok = false;
+            return;
+        }
+        opCounts[index]++;
+        commandCount++;
+    });
+    if (!ok) {
+        LOG_ERROR("Unknown command in %s", path.c_str());
+        clear();
+    }
+    return ok;
+}
+
+const char* NullCommandList::getOpName(NullOp op) {
+    size_t index = static_cast<size_t>(op);
+    return index < OP_COUNT ? OP_NAMES[index] : "unknown";
+}
@@ -0,0 +1,90 @@
+#ifndef NULL_COMMAND_LIST_HPP
+#define NULL_COMMAND_LIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum class NullOp : uint8_t {
+    CLEAR,           // float r, g, b, a
+    SET_CAMERA,      // float view[16], projection[16]
+    SET_MODEL,       // float model[16]
+    BIND_PROGRAM,    // uint32 program
+    UPLOAD_UNIFORM,  // uint32 program, uint32 nameHash, bytes...
+    BIND_TEXTURE,    // uint32 slot, uint32 texture
+    DRAW,            // uint32 mesh, uint32 vertexCount
+    DRAW_SPRITE,     // uint32 texture, float width, float height
+    DRAW_SKYBOX,     // uint32 mesh, uint32 program, uint32 cubemap
+    PRESENT,         // -
+    LIGHT_CLUSTERS,  // uint32 lightCount, uint32 indexCount (so quando ha point/spot)
+    UPLOAD_LIGHTS,   // LightBuffer, so as luzes em uso
+    SHADOW_CASCADE,  // uint32 cascade, runCount, instanceCount, float viewProjection[16]
+    SHADOW_DRAW,     // uint32 mesh, vertexCount, firstInstance, instanceCount
+    COUNT
+};
+
+// Stream binario compacto dos comandos emitidos pelo NullRendererBackend.
+// Cada comando e um header de 4 bytes (op, reservado, tamanho do payload)
+// seguido do payload; os handles sao ids sequenciais, entao a mesma cena
+// gera sempre os mesmos bytes e o mesmo hash.
+class NullCommandList {
+  public:
+    static constexpr size_t OP_COUNT = static_cast<size_t>(NullOp::COUNT);
+
+    struct Command {
+        NullOp op;
+        const uint8_t* payload;
+        uint16_t size;
+
+        template <typename T> T read(size_t offset) const {
+            T value;
+            std::memcpy(&value, payload + offset, sizeof(T));
+            return value;
+        }
+    };
+
+    void push(NullOp op, const void* payload = nullptr, size_t size = 0);
+    void clear();
+
+    size_t getCommandCount() const { return commandCount; }
+    size_t getCount(NullOp op) const { return opCounts[static_cast<size_t>(op)]; }
+    // DRAW + DRAW_SPRITE + DRAW_SKYBOX
+    size_t getDrawCount() const;
+    size_t getByteSize() const { return bytes.size(); }
+    const std::vector<uint8_t>& getBytes() const { return bytes; }
+
+    // FNV-1a 64 sobre o stream inteiro
+    uint64_t getHash() const;
+
+    // Decodifica os comandos em ordem, para inspecao (contagens, diffs entre dumps).
+    // Nao ha replay: o stream guarda ids e hashes de nomes, nao os recursos.
+    template <typename Fn> void forEach(Fn&& fn) const {
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= bytes.size()) {
+            Command cmd;
+            cmd.op = static_cast<NullOp>(bytes[offset]);
+            std::memcpy(&cmd.size, &bytes[offset + 2], sizeof(cmd.size));
+            if (offset + HEADER_SIZE + cmd.size > bytes.size()) break;
+            cmd.payload = bytes.data() + offset + HEADER_SIZE;
+            fn(cmd);
+            offset += HEADER_SIZE + cmd.size;
+        }
+    }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    static const char* getOpName(NullOp op);
+
+  private:
+    static constexpr size_t HEADER_SIZE = 4;
+
+    std::vector<uint8_t> bytes;
+    std::array<size_t, OP_COUNT> opCounts{};
+    size_t commandCount = 0;
+};
+
+#endif // NULL_COMMAND_LIST_HPP
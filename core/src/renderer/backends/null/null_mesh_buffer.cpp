@@ -0,0 +1,13 @@
+#include "null_mesh_buffer.hpp"
+#include "../../../stats.hpp"
+#include "null_renderer_backend.hpp"
+
+bool NullMeshBuffer::createBuffers(const std::vector<float>& vertices,
+                                   const std::vector<float>& normals) {
+    id = backend->allocateHandle();
+    vertexCount = static_cast<uint32_t>(vertices.size() / 3);
+    Stats::add(Stat::GPU_ALLOCATIONS, 2);
+    return true;
+}
+
+void* NullMeshBuffer::getHandle() const { return reinterpret_cast<void*>(uintptr_t(id)); }
@@ -0,0 +1,28 @@
+#ifndef NULL_MESH_BUFFER_HPP
+#define NULL_MESH_BUFFER_HPP
+
+#include "mesh_buffer.hpp"
+#include <cstdint>
+
+class NullRendererBackend;
+
+class NullMeshBuffer : public MeshBuffer {
+  private:
+    NullRendererBackend* backend;
+    uint32_t id = 0;
+    uint32_t vertexCount = 0;
+
+  public:
+    NullMeshBuffer(NullRendererBackend* backend) : backend(backend) {}
+
+    bool createBuffers(const std::vector<float>& vertices,
+                       const std::vector<float>& normals) override;
+    void bind() override {}
+    void unbind() override {}
+    void destroy() override { id = 0; }
+    void* getHandle() const override;
+
+    uint32_t getVertexCount() const { return vertexCount; }
+};
+
+#endif // NULL_MESH_BUFFER_HPP
@@ -0,0 +1,265 @@
+#define CLASS_NAME "NullRendererBackend"
+#include "../../../log_macros.hpp"
+
+#include "../../../color.hpp"
+#include "../../../material.hpp"
+#include "../../../profiler.hpp"
+#include "../../../stats.hpp"
+#include "mesh_buffer_factory.hpp"
+#include "null_mesh_buffer.hpp"
+#include "null_renderer_backend.hpp"
+#include "shader_compiler_factory.hpp"
+#include "shader_program_factory.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+
+namespace {
+
+uint32_t hashName(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (; *name; name++) {
+        hash ^= static_cast<uint8_t>(*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+GraphicsAPI NullRendererBackend::getGraphicsAPI() const { return GraphicsAPI::NULL_BACKEND; }
+
+std::string NullRendererBackend::getShaderExtension() const { return ".glsl"; }
+
+std::unique_ptr<ShaderProgram> NullRendererBackend::createShaderProgram() {
+    return ShaderProgramFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<MeshBuffer> NullRendererBackend::createMeshBuffer() {
+    return MeshBufferFactory::create(getGraphicsAPI(), this);
+}
+
+std::unique_ptr<ShaderCompiler> NullRendererBackend::createShaderCompiler() {
+    return ShaderCompilerFactory::create(getGraphicsAPI(), this);
+}
+
+bool NullRendererBackend::init() { return true; }
+
+bool NullRendererBackend::init(SDL_Window* window) { return true; }
+
+bool NullRendererBackend::initHeadless(int width, int height) {
+    headless = true;
+    LOG_INFO("Null backend recording %dx%d frames", width, height);
+    return true;
+}
+
+bool NullRendererBackend::initWindowContext() { return true; }
+
+unsigned int NullRendererBackend::loadTexture(const std::string& path,
+                                              const SamplerDesc& sampler) {
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    return allocateHandle();
+}
+
+void NullRendererBackend::deleteTexture(unsigned int textureID) {}
+
+unsigned int NullRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    return allocateHandle();
+}
+
+void NullRendererBackend::clear(Camera* camera) {
+    // Cada frame comeca sem programa ligado, como depois de um present real
+    boundProgram = 0;
+
+    ColorRGBA bgColor = camera ? camera->getBackgroundColor() : COLOR::BLACK;
+    float color[4] = {bgColor.r, bgColor.g, bgColor.b, bgColor.a};
+    frameCommands.push(NullOp::CLEAR, color, sizeof(color));
+}
+
+void NullRendererBackend::bindCamera(Camera* camera) {
+    if (!camera) {
+        LOG_ERROR("Camera is null");
+        return;
+    }
+
+    glm::mat4 matrices[2] = {camera->getViewMatrix(), camera->getProjectionMatrix()};
+    frameCommands.push(NullOp::SET_CAMERA, matrices, sizeof(matrices));
+
+    // Mesmo volume que o backend GL envia (model + view + projection)
+    Stats::add(Stat::UBO_UPLOADS, 3);
+    Stats::add(Stat::UBO_BYTES, 3 * sizeof(glm::mat4));
+}
+
+void NullRendererBackend::bindProgram(uint32_t program) {
+    if (program == 0 || program == boundProgram) {
+        return;
+    }
+    boundProgram = program;
+    frameCommands.push(NullOp::BIND_PROGRAM, &program, sizeof(program));
+    Stats::add(Stat::PROGRAM_BINDS);
+}
+
+void NullRendererBackend::uploadUniform(uint32_t program, const char* name, const void* data,
+                                        size_t size) {
+    uint8_t payload[8 + 256];
+    if (size > sizeof(payload) - 8) {
+        LOG_WARN("Uniform %s has %zu bytes, recording only the first 256", name, size);
+        size = sizeof(payload) - 8;
+    }
+
+    uint32_t nameHash = hashName(name);
+    std::memcpy(payload, &program, sizeof(program));
+    std::memcpy(payload + 4, &nameHash, sizeof(nameHash));
+    std::memcpy(payload + 8, data, size);
+    frameCommands.push(NullOp::UPLOAD_UNIFORM, payload, 8 + size);
+
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, size);
+}
+
+void NullRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
+                                            size_t size) {
+    uploadUniform(0, name.c_str(), data, size);
+}
+
+void NullRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
+    if (!shaderProgram || !shaderProgram->isValid())
+        return;
+
+    shaderProgram->use();
+}
+
+void NullRendererBackend::applyMaterial(Material* material) {
+    setUniforms(material->getShaderProgram());
+}
+
+void NullRendererBackend::draw(const Mesh& mesh) {
+    auto* buffer = static_cast<NullMeshBuffer*>(mesh.getMeshBuffer());
+    uint32_t payload[2] = {
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle())),
+        buffer ? buffer->getVertexCount() : static_cast<uint32_t>(mesh.getVertices().size() / 3)};
+    frameCommands.push(NullOp::DRAW, payload, sizeof(payload));
+
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, payload[1] / 3);
+}
+
+void NullRendererBackend::drawSprite(const Sprite& sprite) {
+    uint32_t texture = resolveTexture(sprite.getTexture());
+    uint32_t binding[2] = {0, texture};
+    frameCommands.push(NullOp::BIND_TEXTURE, binding, sizeof(binding));
+
+    uint8_t payload[12];
+    float size[2] = {sprite.getWidth(), sprite.getHeight()};
+    std::memcpy(payload, &texture, sizeof(texture));
+    std::memcpy(payload + 4, size, sizeof(size));
+    frameCommands.push(NullOp::DRAW_SPRITE, payload, sizeof(payload));
+
+    Stats::add(Stat::TEXTURE_BINDS);
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, 2);
+}
+
+void NullRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                            std::vector<Light>* lights) {
+    if (!gameObjects) return;
+
+    if (lights) {
+        LightBuffer lightBuffer;
+        lightBuffer.pack(*lights);
+        submitLights(lightBuffer);
+    }
+
+    RenderQueue queue;
+    queue.build(*gameObjects);
+    submitQueue(queue, lights);
+}
+
+void NullRendererBackend::submitQueue(const RenderQueue& queue, std::vector<Light>* lights) {
+    PROFILE_SCOPE("RenderGameObjects");
+    for (const DrawItem& item : queue.getItems()) {
+        frameCommands.push(NullOp::SET_MODEL, glm::value_ptr(item.model), sizeof(glm::mat4));
+        Stats::add(Stat::UBO_UPLOADS);
+        Stats::add(Stat::UBO_BYTES, sizeof(glm::mat4));
+
+        Material* mat = item.material;
+        applyMaterial(mat);
+
+        if (item.sprite) {
+            drawSprite(*item.sprite);
+        } else if (item.mesh) {
+            draw(*item.mesh);
+        }
+    }
+}
+
+void NullRendererBackend::submitShadows(const ShadowCascades& shadows) {
+    if (!shadows.isActive()) return;
+
+    // As matrizes das instancias sobem uma vez para todas as cascatas, como no GL
+    size_t bytes = shadows.getInstanceModels().size() * sizeof(glm::mat4);
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, bytes);
+
+    const auto& runs = shadows.getRuns();
+    for (uint32_t c = 0; c < shadows.getCascadeCount(); c++) {
+        const ShadowCascades::Cascade& cascade = shadows.getCascade(c);
+        uint8_t header[12 + sizeof(glm::mat4)];
+        uint32_t counts[3] = {c, cascade.runCount, cascade.instanceCount};
+        std::memcpy(header, counts, sizeof(counts));
+        std::memcpy(header + 12, glm::value_ptr(cascade.viewProjection), sizeof(glm::mat4));
+        frameCommands.push(NullOp::SHADOW_CASCADE, header, sizeof(header));
+
+        for (uint32_t r = cascade.firstRun; r < cascade.firstRun + cascade.runCount; r++) {
+            const ShadowCascades::Run& run = runs[r];
+            auto* buffer = static_cast<NullMeshBuffer*>(run.mesh->getMeshBuffer());
+            uint32_t payload[4] = {
+                static_cast<uint32_t>(reinterpret_cast<uintptr_t>(run.mesh->getMeshBufferHandle())),
+                buffer ? buffer->getVertexCount()
+                       : static_cast<uint32_t>(run.mesh->getVertices().size() / 3),
+                run.first, run.count};
+            frameCommands.push(NullOp::SHADOW_DRAW, payload, sizeof(payload));
+            Stats::add(Stat::SHADOW_DRAWS);
+        }
+    }
+}
+
+void NullRendererBackend::submitLights(const LightBuffer& lights) {
+    frameCommands.push(NullOp::UPLOAD_LIGHTS, &lights, lights.getUsedBytes());
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, lights.getUsedBytes());
+}
+
+void NullRendererBackend::submitLightClusters(const LightClusters& clusters) {
+    if (clusters.empty()) return;
+
+    // Mesmo volume que o backend GL envia: UBO de parametros e os tres buffers
+    size_t bytes = sizeof(LightClusters::Params) +
+                   clusters.getLights().size() * sizeof(LightClusters::GpuLight) +
+                   clusters.getClusters().size() * sizeof(LightClusters::Cluster) +
+                   clusters.getLightIndices().size() * sizeof(uint32_t);
+    uint32_t payload[2] = {(uint32_t)clusters.getLights().size(),
+                           (uint32_t)clusters.getLightIndices().size()};
+    frameCommands.push(NullOp::LIGHT_CLUSTERS, payload, sizeof(payload));
+
+    Stats::add(Stat::UBO_UPLOADS, 4);
+    Stats::add(Stat::UBO_BYTES, bytes);
+}
+
+void NullRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                                       unsigned int textureID) {
+    uint32_t payload[3] = {
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle())),
+        shaderProgram, textureID};
+    frameCommands.push(NullOp::DRAW_SKYBOX, payload, sizeof(payload));
+
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, mesh.getVertices().size() / 9);
+}
+
+void NullRendererBackend::present(SDL_Window* window) {
+    frameCommands.push(NullOp::PRESENT);
+    std::swap(lastFrameCommands, frameCommands);
+    frameCommands.clear();
+}
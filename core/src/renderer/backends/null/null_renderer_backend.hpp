@@ -0,0 +1,67 @@
+#ifndef NULL_RENDERER_BACKEND_HPP
+#define NULL_RENDERER_BACKEND_HPP
+
+#include "../../renderer_backend.hpp"
+#include "null_command_list.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Implementa a interface inteira sem GPU: cada chamada vira um comando no
+// NullCommandList do frame. Serve para medir o custo de CPU do renderer
+// (culling, ordenacao, uniforms) de forma deterministica em maquinas de CI.
+class NullRendererBackend : public RendererBackend {
+  private:
+    NullCommandList frameCommands;
+    NullCommandList lastFrameCommands;
+    uint32_t nextHandle = 1;
+    uint32_t boundProgram = 0;
+
+  public:
+    unsigned int loadTexture(const std::string& path,
+                             const SamplerDesc& sampler = SamplerDesc()) override;
+    void deleteTexture(unsigned int textureID) override;
+    size_t getTextureBytes(unsigned int textureID) const override { return 0; }
+    void drawSprite(const Sprite& sprite) override;
+    bool init() override;
+    bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    void present(SDL_Window* window) override;
+    bool initWindowContext() override;
+    void bindCamera(Camera* camera) override;
+    void applyMaterial(Material* material) override;
+    void setBufferDataImpl(const std::string& name, const void* data, size_t size) override;
+    void clear(Camera* camera) override;
+    void draw(const Mesh&) override;
+    void setUniforms(ShaderProgram* shaderProgram) override;
+    unsigned int createCubemapTexture(const std::vector<std::string>& faces) override;
+    std::unique_ptr<ShaderProgram> createShaderProgram() override;
+    std::unique_ptr<ShaderCompiler> createShaderCompiler() override;
+    std::unique_ptr<MeshBuffer> createMeshBuffer() override;
+    void onCameraSet() override {}
+    GraphicsAPI getGraphicsAPI() const override;
+    std::string getShaderExtension() const override;
+    unsigned int getRequiredWindowFlags() const override { return 0; }
+
+    void renderGameObjects(std::vector<GameObject*>* gameObjects,
+                           std::vector<Light>* lights) override;
+    void submitQueue(const RenderQueue& queue, std::vector<Light>* lights) override;
+    void submitShadows(const ShadowCascades& shadows) override;
+    bool supportsShadows() const override { return true; }
+    void submitLights(const LightBuffer& lights) override;
+    void submitLightClusters(const LightClusters& clusters) override;
+    void renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
+                      unsigned int textureID) override;
+
+    // Usados pelos recursos do backend (mesh buffers, programas, shaders)
+    uint32_t allocateHandle() { return nextHandle++; }
+    void bindProgram(uint32_t program);
+    void uploadUniform(uint32_t program, const char* name, const void* data, size_t size);
+
+    // Comandos do frame em andamento e do ultimo frame fechado por present()
+    const NullCommandList& getFrameCommands() const { return frameCommands; }
+    const NullCommandList& getLastFrameCommands() const { return lastFrameCommands; }
+};
+
+#endif // NULL_RENDERER_BACKEND_HPP
@@ -0,0 +1,8 @@
+#include "null_shader_compiler.hpp"
+#include "null_renderer_backend.hpp"
+#include <cstdint>
+
+bool NullShaderCompiler::compile(const std::string& source, ShaderType type, void** outHandle) {
+    *outHandle = reinterpret_cast<void*>(uintptr_t(backend->allocateHandle()));
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef NULL_SHADER_COMPILER_HPP
+#define NULL_SHADER_COMPILER_HPP
+
+#include "../../../shader_compiler.hpp"
+
+class NullRendererBackend;
+
+// Nao le nem compila nada: qualquer caminho vira um handle valido, para que
+// cenas rodem sem os shaders gerados pelo build.
+class NullShaderCompiler : public ShaderCompiler {
+  private:
+    NullRendererBackend* backend;
+
+  public:
+    NullShaderCompiler(NullRendererBackend* backend) : backend(backend) {}
+
+    bool compile(const std::string& source, ShaderType type, void** outHandle) override;
+    void destroy(void* handle) override {}
+    bool isValid(void* handle) override { return handle != nullptr; }
+};
+
+#endif // NULL_SHADER_COMPILER_HPP
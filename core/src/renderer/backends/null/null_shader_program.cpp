@@ -0,0 +1,29 @@
+#define CLASS_NAME "NullShaderProgram"
+#include "../../../log_macros.hpp"
+
+#include "../../../shader_asset.hpp"
+#include "null_renderer_backend.hpp"
+#include "null_shader_program.hpp"
+
+bool NullShaderProgram::attachShader(const ShaderAsset& shader) {
+    if (!shader.getHandle()) {
+        return false;
+    }
+    attachedShaders++;
+    return true;
+}
+
+bool NullShaderProgram::link() {
+    if (attachedShaders == 0) {
+        LOG_ERROR("Can not link a program without shaders");
+        return false;
+    }
+    id = backend->allocateHandle();
+    return true;
+}
+
+void NullShaderProgram::use() { backend->bindProgram(id); }
+
+void NullShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
+    backend->uploadUniform(id, name, data, size);
+}
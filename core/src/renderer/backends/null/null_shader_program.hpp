@@ -0,0 +1,28 @@
+#ifndef NULL_SHADER_PROGRAM_HPP
+#define NULL_SHADER_PROGRAM_HPP
+
+#include "../../../shader_program.hpp"
+#include <cstdint>
+
+class NullRendererBackend;
+
+class NullShaderProgram : public ShaderProgram {
+  private:
+    NullRendererBackend* backend;
+    uint32_t id = 0;
+    int attachedShaders = 0;
+
+  public:
+    NullShaderProgram(NullRendererBackend* backend) : backend(backend) {}
+
+    bool attachShader(const ShaderAsset& shader) override;
+    bool link() override;
+    void use() override;
+    void setUniformBuffer(const char* name, const void* data, size_t size) override;
+    void* getHandle() const override { return reinterpret_cast<void*>(uintptr_t(id)); }
+    bool isValid() const override { return id != 0; }
+
+    uint32_t getId() const { return id; }
+};
+
+#endif // NULL_SHADER_PROGRAM_HPP
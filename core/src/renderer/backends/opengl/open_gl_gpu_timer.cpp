@@ -0,0 +1,64 @@
+#include "open_gl_gpu_timer.hpp"
+#include "../../../profiler.hpp"
+
+OpenGLGpuTimer::~OpenGLGpuTimer() {
+    if (initialized) {
+        for (auto& frame : frames) {
+            glDeleteQueries(MAX_SCOPES * 2, frame.queries);
+        }
+    }
+}
+
+void OpenGLGpuTimer::resolve(Frame& frame) {
+    if (frame.count == 0) return;
+
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available) {
+        for (int i = 0; i < frame.count; i++) {
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+            Profiler::record(frame.names[i], start + frame.offsetNs, end + frame.offsetNs,
+                             Profiler::Track::GPU);
+        }
+    }
+    // Se ainda nao chegou depois de FRAME_LATENCY frames, descarta
+    frame.count = 0;
+}
+
+void OpenGLGpuTimer::beginFrame() {
+    if (!Profiler::isEnabled()) return;
+
+    if (!initialized) {
+        for (auto& frame : frames) {
+            glGenQueries(MAX_SCOPES * 2, frame.queries);
+        }
+        initialized = true;
+    }
+
+    current = (current + 1) % FRAME_LATENCY;
+    Frame& frame = frames[current];
+    resolve(frame);
+
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    frame.offsetNs = (int64_t)Profiler::now() - gpuNow;
+}
+
+int OpenGLGpuTimer::begin(const char* name) {
+    if (!initialized || !Profiler::isEnabled()) return -1;
+
+    Frame& frame = frames[current];
+    if (frame.count == MAX_SCOPES) return -1;
+
+    int scope = frame.count++;
+    frame.names[scope] = name;
+    glQueryCounter(frame.queries[scope * 2], GL_TIMESTAMP);
+    return scope;
+}
+
+void OpenGLGpuTimer::end(int scope) {
+    if (scope < 0) return;
+    glQueryCounter(frames[current].queries[scope * 2 + 1], GL_TIMESTAMP);
+}
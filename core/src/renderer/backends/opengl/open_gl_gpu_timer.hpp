@@ -0,0 +1,37 @@
+#ifndef OPEN_GL_GPU_TIMER_HPP
+#define OPEN_GL_GPU_TIMER_HPP
+
+#include <GL/glew.h>
+#include <cstdint>
+
+// Escopos de GPU com GL_TIMESTAMP. Os resultados sao lidos FRAME_LATENCY frames
+// depois para nunca bloquear esperando a GPU, e convertidos para o relogio do
+// Profiler com um offset medido no inicio de cada frame.
+class OpenGLGpuTimer {
+  private:
+    static constexpr int FRAME_LATENCY = 4;
+    static constexpr int MAX_SCOPES = 16;
+
+    struct Frame {
+        GLuint queries[MAX_SCOPES * 2] = {};
+        const char* names[MAX_SCOPES] = {};
+        int count = 0;
+        int64_t offsetNs = 0;
+    };
+
+    Frame frames[FRAME_LATENCY];
+    int current = 0;
+    bool initialized = false;
+
+    void resolve(Frame& frame);
+
+  public:
+    ~OpenGLGpuTimer();
+
+    void beginFrame();
+    // Retorna -1 quando o profiler esta desligado ou o frame ja tem escopos demais
+    int begin(const char* name);
+    void end(int scope);
+};
+
+#endif // OPEN_GL_GPU_TIMER_HPP
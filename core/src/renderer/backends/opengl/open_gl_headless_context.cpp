@@ -0,0 +1,141 @@
+#define CLASS_NAME "OpenGLHeadlessContext"
+#include "../../../log_macros.hpp"
+
+#include "open_gl_headless_context.hpp"
+#include <SDL2/SDL.h>
+
+#ifdef YUME_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+OpenGLHeadlessContext::~OpenGLHeadlessContext() { destroy(); }
+
+bool OpenGLHeadlessContext::create() {
+#ifdef YUME_HAS_EGL
+    if (createEGL()) {
+        return true;
+    }
+    LOG_WARN("EGL surfaceless context unavailable, falling back to a hidden SDL window");
+#endif
+    return createHiddenWindow();
+}
+
+bool OpenGLHeadlessContext::usesEGL() const {
+#ifdef YUME_HAS_EGL
+    return context != nullptr;
+#else
+    return false;
+#endif
+}
+
+bool OpenGLHeadlessContext::makeCurrent(bool current) {
+#ifdef YUME_HAS_EGL
+    if (context) {
+        return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                              current ? context : EGL_NO_CONTEXT) == EGL_TRUE;
+    }
+#endif
+    if (!sdlContext) return false;
+    return SDL_GL_MakeCurrent(hiddenWindow, current ? sdlContext : nullptr) == 0;
+}
+
+void OpenGLHeadlessContext::destroy() {
+#ifdef YUME_HAS_EGL
+    if (display) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context) eglDestroyContext(display, context);
+        eglTerminate(display);
+    }
+    display = nullptr;
+    context = nullptr;
+#endif
+    if (sdlContext) SDL_GL_DeleteContext(sdlContext);
+    if (hiddenWindow) SDL_DestroyWindow(hiddenWindow);
+    sdlContext = nullptr;
+    hiddenWindow = nullptr;
+}
+
+#ifdef YUME_HAS_EGL
+bool OpenGLHeadlessContext::createEGL() {
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+
+    const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay && clientExts && strstr(clientExts, "EGL_MESA_platform_surfaceless")) {
+        dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (dpy == EGL_NO_DISPLAY) {
+        dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major = 0, minor = 0;
+    if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor)) {
+        LOG_ERROR("eglInitialize failed");
+        return false;
+    }
+    display = dpy;
+
+    const char* displayExts = eglQueryString(dpy, EGL_EXTENSIONS);
+    if (!displayExts || !strstr(displayExts, "EGL_KHR_surfaceless_context")) {
+        LOG_ERROR("EGL_KHR_surfaceless_context not supported");
+        return false;
+    }
+
+    const EGLint configAttribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(dpy, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        LOG_ERROR("No EGL config with desktop GL support");
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        LOG_ERROR("eglBindAPI(EGL_OPENGL_API) failed");
+        return false;
+    }
+
+    const EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                     3,
+                                     EGL_CONTEXT_MINOR_VERSION,
+                                     3,
+                                     EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                     EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                     EGL_NONE};
+    context = eglCreateContext(dpy, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        context = nullptr;
+        LOG_ERROR("eglCreateContext failed");
+        return false;
+    }
+
+    if (!eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        LOG_ERROR("eglMakeCurrent failed");
+        return false;
+    }
+
+    LOG_INFO("EGL %d.%d surfaceless context created", major, minor);
+    return true;
+}
+#endif
+
+bool OpenGLHeadlessContext::createHiddenWindow() {
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+
+    hiddenWindow = SDL_CreateWindow("", 0, 0, 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!hiddenWindow) {
+        LOG_ERROR("Failed to create hidden window: %s", SDL_GetError());
+        return false;
+    }
+
+    sdlContext = SDL_GL_CreateContext(hiddenWindow);
+    if (!sdlContext) {
+        LOG_ERROR("Failed to create OpenGL context!");
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef OPEN_GL_HEADLESS_CONTEXT_HPP
+#define OPEN_GL_HEADLESS_CONTEXT_HPP
+
+struct SDL_Window;
+
+// Contexto GL 3.3 core sem janela visivel. Com EGL usa um display surfaceless
+// (Mesa llvmpipe funciona sem GPU nem servidor X); sem EGL cai para uma janela
+// SDL escondida, que ainda precisa de um display.
+class OpenGLHeadlessContext {
+  private:
+#ifdef YUME_HAS_EGL
+    void* display = nullptr;
+    void* context = nullptr;
+
+    bool createEGL();
+#endif
+    SDL_Window* hiddenWindow = nullptr;
+    void* sdlContext = nullptr;
+
+    bool createHiddenWindow();
+
+  public:
+    ~OpenGLHeadlessContext();
+
+    bool create();
+    void destroy();
+    bool usesEGL() const;
+    // Liga (ou solta) o contexto no thread atual
+    bool makeCurrent(bool current);
+};
+
+#endif // OPEN_GL_HEADLESS_CONTEXT_HPP
@@ -1,4 +1,5 @@
 #include "open_gl_mesh_buffer.hpp"
+#include "../../../stats.hpp"
 
 OpenGLMeshBuffer::~OpenGLMeshBuffer() { 
     destroy(); 
@@ -28,6 +29,7 @@ bool OpenGLMeshBuffer::createBuffers(const std::vector<float>& vertices, const s
     glEnableVertexAttribArray(1);
 
     glBindVertexArray(0);
+    Stats::add(Stat::GPU_ALLOCATIONS, 2);
     return true;
 }
 
@@ -1,13 +1,16 @@
 #define CLASS_NAME "OpenGLRendererBackend"
 #include "../../../log_macros.hpp"
 
+#include "../../../baked_texture.hpp"
 #include "../../../color.hpp"
 #include "../../../game_object.hpp"
 #include "../../../material.hpp"
 #include "../../../mesh_renderer.hpp"
-#include "../../../stb_image.h"
+#include "../../../profiler.hpp"
+#include "../../../stats.hpp"
 #include "mesh_buffer_factory.hpp"
 #include "open_gl_renderer_backend.hpp"
+#include "open_gl_shader_program.hpp"
 #include "shader_compiler_factory.hpp"
 #include "shader_program_factory.hpp"
 #include <GL/glew.h>
@@ -15,18 +18,99 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Le o .ytex ao lado da imagem; false se nao existe, se e mais velho que a imagem ou
+// se o driver nao aceita o formato.
+// Com tailOnly le so os mips pequenos e o streamer traz o resto depois.
+bool loadBakedTexture(const std::string& sourcePath, BakedTexture& baked, bool tailOnly = false) {
+    if (BakedTexture::isStale(sourcePath)) {
+        return false;
+    }
+    std::string path = bakedTexturePath(sourcePath);
+    if (!(tailOnly ? baked.loadTail(path, TextureStreamer::TAIL_SIZE) : baked.load(path))) {
+        return false;
+    }
+    if (isBlockCompressed(baked.format) && !GLEW_EXT_texture_compression_s3tc) {
+        LOG_WARN("S3TC not supported, decoding %s instead", sourcePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void uploadBakedTexture(GLenum target, const BakedTexture& baked) {
+    GLenum internalFormat = baked.format == TextureFormat::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                                               : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    for (size_t level = baked.firstLevel; level < baked.levelEnd; level++) {
+        const TextureMipEntry& mip = baked.mips[level];
+        if (isBlockCompressed(baked.format)) {
+            glCompressedTexImage2D(target, (GLint)level, internalFormat, mip.width, mip.height, 0,
+                                   mip.size, baked.mipData(level));
+        } else {
+            glTexImage2D(target, (GLint)level, GL_RGBA, mip.width, mip.height, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, baked.mipData(level));
+        }
+    }
+}
+
+// Maior lado, em pixels, do quad do sprite (-0.5..0.5) depois de projetado
+float projectedSize(const glm::mat4& modelViewProjection, int viewportWidth, int viewportHeight) {
+    glm::vec2 lo(INFINITY), hi(-INFINITY);
+    for (float x : {-0.5f, 0.5f}) {
+        for (float y : {-0.5f, 0.5f}) {
+            glm::vec4 clip = modelViewProjection * glm::vec4(x, y, 0.0f, 1.0f);
+            // Atravessa o plano da camera: trata como se cobrisse a tela
+            if (clip.w <= 0.0f) return (float)std::max(viewportWidth, viewportHeight);
+            glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            lo = glm::min(lo, ndc);
+            hi = glm::max(hi, ndc);
+        }
+    }
+    glm::vec2 size = (hi - lo) * 0.5f * glm::vec2(viewportWidth, viewportHeight);
+    return std::max(size.x, size.y);
+}
+
+} // namespace
 
 GraphicsAPI OpenGLRendererBackend::getGraphicsAPI() const { return GraphicsAPI::OPENGL; }
 
 std::string OpenGLRendererBackend::getShaderExtension() const { return ".glsl"; }
 
 OpenGLRendererBackend::~OpenGLRendererBackend() {
+    for (auto& [key, sampler] : samplers)
+        glDeleteSamplers(1, &sampler);
     if (matricesUBO)
         glDeleteBuffers(1, &matricesUBO);
     if (materialDataUBO)
         glDeleteBuffers(1, &materialDataUBO);
     if (lightDataUBO)
         glDeleteBuffers(1, &lightDataUBO);
+    if (clusterDataUBO)
+        glDeleteBuffers(1, &clusterDataUBO);
+    for (TextureBuffer* textureBuffer : {&clusterLights, &clusterGrid, &clusterIndices}) {
+        if (textureBuffer->texture)
+            glDeleteTextures(1, &textureBuffer->texture);
+        if (textureBuffer->buffer)
+            glDeleteBuffers(1, &textureBuffer->buffer);
+    }
+    if (uploadPBO)
+        glDeleteBuffers(1, &uploadPBO);
+    for (auto& slot : readbackSlots) {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        if (slot.pbo)
+            glDeleteBuffers(1, &slot.pbo);
+    }
+    if (offscreenFBO)
+        glDeleteFramebuffers(1, &offscreenFBO);
+    if (offscreenColor)
+        glDeleteRenderbuffers(1, &offscreenColor);
+    if (offscreenDepth)
+        glDeleteRenderbuffers(1, &offscreenDepth);
 }
 
 unsigned int OpenGLRendererBackend::getRequiredWindowFlags() const { return SDL_WINDOW_OPENGL; };
@@ -49,20 +133,84 @@ bool OpenGLRendererBackend::init(SDL_Window* window) {
         return false;
     }
 
-    SDL_GLContext glContext = SDL_GL_CreateContext(window);
+    glContext = SDL_GL_CreateContext(window);
     if (!glContext) {
         LOG_ERROR("Failed to create OpenGL context!");
         return false;
     }
 
+    // GL nao tem mailbox; sem vsync e o mais proximo
+    int interval = 1;
+    if (presentMode == PresentMode::MAILBOX || presentMode == PresentMode::IMMEDIATE) {
+        interval = 0;
+    } else if (presentMode == PresentMode::FIFO_RELAXED) {
+        interval = -1;
+    }
+    if (SDL_GL_SetSwapInterval(interval) != 0 && interval == -1) {
+        LOG_WARN("Adaptive vsync not supported, falling back to vsync");
+        SDL_GL_SetSwapInterval(1);
+    }
+
     return init();
 };
 
+bool OpenGLRendererBackend::initHeadless(int width, int height) {
+    headless = true;
+
+    headlessContext = std::make_unique<OpenGLHeadlessContext>();
+    if (!headlessContext->create()) {
+        LOG_ERROR("Failed to create headless OpenGL context!");
+        return false;
+    }
+
+    if (!init()) {
+        return false;
+    }
+
+    return createOffscreenTarget(width, height);
+}
+
+bool OpenGLRendererBackend::createOffscreenTarget(int width, int height) {
+    offscreenWidth = width;
+    offscreenHeight = height;
+
+    glGenRenderbuffers(1, &offscreenColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreenColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &offscreenDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreenDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &offscreenFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, offscreenFBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              offscreenColor);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                              offscreenDepth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Offscreen framebuffer is incomplete");
+        return false;
+    }
+
+    glViewport(0, 0, width, height);
+    LOG_INFO("Headless target %dx%d", width, height);
+    return true;
+}
+
 bool OpenGLRendererBackend::init() {
     GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // Com EGL o glewInit carrega as funcoes GL e depois falha ao procurar o GLX
+    if (headless && err == GLEW_ERROR_NO_GLX_DISPLAY) {
+        err = GLEW_OK;
+    }
+#endif
     if (GLEW_OK != err) {
-        std::string glewErr = reinterpret_cast<const char*>(glewGetErrorString(err));
-        LOG_ERROR("GLEW initialization failed: " + glewErr);
+        LOG_ERROR("GLEW initialization failed: %s",
+                  reinterpret_cast<const char*>(glewGetErrorString(err)));
         return false;
     }
 
@@ -73,32 +221,73 @@ bool OpenGLRendererBackend::init() {
     glGenBuffers(1, &matricesUBO);
     glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
     glBufferData(GL_UNIFORM_BUFFER, 4 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+    glBindBufferBase(GL_UNIFORM_BUFFER, OpenGLShaderProgram::MATRICES_BINDING, matricesUBO);
 
     glGenBuffers(1, &materialDataUBO);
     glBindBuffer(GL_UNIFORM_BUFFER, materialDataUBO);
     glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 1, materialDataUBO);
+    glBindBufferBase(GL_UNIFORM_BUFFER, OpenGLShaderProgram::MATERIAL_BINDING, materialDataUBO);
 
     glGenBuffers(1, &lightDataUBO);
     glBindBuffer(GL_UNIFORM_BUFFER, lightDataUBO);
-    glBufferData(GL_UNIFORM_BUFFER, 256, nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 2, lightDataUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightBuffer), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, OpenGLShaderProgram::LIGHT_DATA_BINDING, lightDataUBO);
+
+    glGenBuffers(1, &clusterDataUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, clusterDataUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightClusters::Params), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, OpenGLShaderProgram::CLUSTER_DATA_BINDING, clusterDataUBO);
 
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
     uniformBindings["ModelViewProjection"] = matricesUBO;
     uniformBindings["MaterialData"] = materialDataUBO;
     uniformBindings["LightData"] = lightDataUBO;
+    uniformBindings["ClusterData"] = clusterDataUBO;
+
+    initTextureBuffer(clusterLights, GL_RGBA32F, OpenGLShaderProgram::CLUSTER_LIGHTS_UNIT);
+    initTextureBuffer(clusterGrid, GL_RG32UI, OpenGLShaderProgram::CLUSTER_GRID_UNIT);
+    initTextureBuffer(clusterIndices, GL_R32UI, OpenGLShaderProgram::CLUSTER_INDICES_UNIT);
 
     initSpriteQuad();
 
     return true;
 }
 
+// Fica ligado na propria unidade para sempre; os dados trocam a cada frame
+void OpenGLRendererBackend::initTextureBuffer(TextureBuffer& textureBuffer, GLenum format,
+                                              GLint unit) {
+    glGenBuffers(1, &textureBuffer.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, textureBuffer.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &textureBuffer.texture);
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, textureBuffer.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, textureBuffer.buffer);
+    glActiveTexture(GL_TEXTURE0);
+    Stats::add(Stat::GPU_ALLOCATIONS, 2);
+}
+
 void OpenGLRendererBackend::onCameraSet() {}
 
 void OpenGLRendererBackend::clear(Camera* camera) {
+    gpuTimer.beginFrame();
+    gpuFrameScope = gpuTimer.begin("GPU Frame");
+
+    if (offscreenFBO) {
+        glBindFramebuffer(GL_FRAMEBUFFER, offscreenFBO);
+    }
+
+    if (textureStreaming) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        viewportWidth = viewport[2];
+        viewportHeight = viewport[3];
+        uploadStreamedMips();
+    }
+
     ColorRGBA bgColor = camera ? camera->getBackgroundColor() : COLOR::BLACK;
 
     glClearColor(bgColor.r, bgColor.g, bgColor.b, bgColor.a);
@@ -115,9 +304,13 @@ bool OpenGLRendererBackend::initWindowContext() {
 
 void OpenGLRendererBackend::draw(const Mesh& mesh) {
     auto vao = static_cast<GLuint>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle()));
+    GLsizei vertexCount = mesh.getVertices().size() / 3;
     glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, mesh.getVertices().size() / 3);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
     glBindVertexArray(0);
+
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, vertexCount / 3);
 }
 
 void OpenGLRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
@@ -125,6 +318,7 @@ void OpenGLRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
         return;
 
     shaderProgram->use();
+    Stats::add(Stat::PROGRAM_BINDS);
 }
 
 void OpenGLRendererBackend::bindCamera(Camera* camera) {
@@ -145,8 +339,7 @@ void OpenGLRendererBackend::bindCamera(Camera* camera) {
     if (camera->isOrthographic()) {
         float orthoSize = camera->getOrthoSize();
         float aspect = camera->getAspectRatio();
-        LOG_INFO("Ortho projection - size: " + std::to_string(orthoSize) +
-                 " aspect: " + std::to_string(aspect));
+        LOG_DEBUG("Ortho projection - size: %f aspect: %f", orthoSize, aspect);
         projection = glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize, orthoSize,
                                 camera->getNearDistance(), camera->getFarDistance());
     } else {
@@ -154,12 +347,17 @@ void OpenGLRendererBackend::bindCamera(Camera* camera) {
                                       camera->getNearDistance(), camera->getFarDistance());
     }
 
+    viewProjection = projection * view;
+
     glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(model));
     glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
     glBufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), sizeof(glm::mat4),
                     glm::value_ptr(projection));
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    Stats::add(Stat::UBO_UPLOADS, 3);
+    Stats::add(Stat::UBO_BYTES, 3 * sizeof(glm::mat4));
 }
 
 void OpenGLRendererBackend::setBufferDataImpl(const std::string& name, const void* data,
@@ -169,6 +367,8 @@ void OpenGLRendererBackend::setBufferDataImpl(const std::string& name, const voi
         glBindBuffer(GL_UNIFORM_BUFFER, it->second);
         glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        Stats::add(Stat::UBO_UPLOADS);
+        Stats::add(Stat::UBO_BYTES, size);
     }
 }
 
@@ -183,67 +383,135 @@ void OpenGLRendererBackend::applyMaterial(Material* material) {
 
 void OpenGLRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
                                               std::vector<Light>* lights) {
-    for (const auto go : *gameObjects) {
+    if (!gameObjects) return;
 
-        glm::mat4 model = glm::mat4(1.0f);
-        if (go->getTransform()) {
-            model = go->getTransform()->getModelMatrix();
-        }
+    // Caminho antigo, sem FramePacket: as luzes sobem aqui mesmo
+    if (lights) {
+        LightBuffer lightBuffer;
+        lightBuffer.pack(*lights);
+        submitLights(lightBuffer);
+    }
 
+    RenderQueue queue;
+    queue.build(*gameObjects);
+    submitQueue(queue, lights);
+}
+
+void OpenGLRendererBackend::submitQueue(const RenderQueue& queue, std::vector<Light>* lights) {
+    PROFILE_SCOPE("RenderGameObjects");
+    for (const DrawItem& item : queue.getItems()) {
         glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(model));
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(item.model));
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        Stats::add(Stat::UBO_UPLOADS);
+        Stats::add(Stat::UBO_BYTES, sizeof(glm::mat4));
 
-        if (go->hasSprite() && go->hasSpriteRenderer()) {
-            auto sprite = go->getSprite();
-            auto spriteRenderer = go->getSpriteRenderer();
-            auto mat = spriteRenderer->getMaterial();
+        Material* mat = item.material;
+        mat->use();
+        applyMaterial(mat);
 
-            if (mat) {
-                mat->use();
-                applyMaterial(mat);
-                drawSprite(*sprite);
-            }
-        } else if (go->hasMesh() && go->hasMeshRenderer()) {
-            auto mesh = go->getMesh();
-            auto meshRenderer = go->getMeshRenderer();
-            auto mat = meshRenderer->getMaterial();
-
-            if (mat) {
-                mat->use();
-                applyMaterial(mat);
-                if (lights && !lights->empty()) {
-                    mat->applyLight((*lights)[0]);
-                }
-                draw(*mesh);
-            }
+        if (item.sprite) {
+            drawSprite(*item.sprite);
+        } else if (item.mesh) {
+            draw(*item.mesh);
         }
     }
 }
 
+void OpenGLRendererBackend::submitShadows(const ShadowCascades& shadows) {
+    if (!shadows.isActive()) return;
+    if (!shadowPassCreated) {
+        shadowPassCreated = true;
+        shadowPass.init();
+    }
+    int scope = gpuTimer.begin("Shadows");
+    shadowPass.render(shadows);
+    gpuTimer.end(scope);
+}
+
+void OpenGLRendererBackend::submitLights(const LightBuffer& lights) {
+    glBindBuffer(GL_UNIFORM_BUFFER, lightDataUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, lights.getUsedBytes(), &lights);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, lights.getUsedBytes());
+}
+
+void OpenGLRendererBackend::submitLightClusters(const LightClusters& clusters) {
+    PROFILE_SCOPE("UploadLightClusters");
+
+    // Com zero luzes o shader nem chega a ler os texture buffers
+    glBindBuffer(GL_UNIFORM_BUFFER, clusterDataUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightClusters::Params), &clusters.getParams());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, sizeof(LightClusters::Params));
+    if (clusters.empty()) return;
+
+    // glBufferData a cada frame orfana o store antigo, que a GPU pode estar lendo
+    auto upload = [](const TextureBuffer& textureBuffer, const void* data, size_t size) {
+        glBindBuffer(GL_TEXTURE_BUFFER, textureBuffer.buffer);
+        glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)size, data, GL_STREAM_DRAW);
+        Stats::add(Stat::UBO_UPLOADS);
+        Stats::add(Stat::UBO_BYTES, size);
+    };
+    upload(clusterLights, clusters.getLights().data(),
+           clusters.getLights().size() * sizeof(LightClusters::GpuLight));
+    upload(clusterGrid, clusters.getClusters().data(),
+           clusters.getClusters().size() * sizeof(LightClusters::Cluster));
+    // Lista vazia ainda precisa de um store valido
+    const std::vector<uint32_t>& indices = clusters.getLightIndices();
+    uint32_t none = 0;
+    upload(clusterIndices, indices.empty() ? &none : (const void*)indices.data(),
+           std::max<size_t>(indices.size(), 1) * sizeof(uint32_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
 unsigned int OpenGLRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    Stats::add(Stat::GPU_ALLOCATIONS);
+
+    // So usa as versoes baked se todas as faces tiverem a mesma cadeia de mips
+    std::vector<BakedTexture> bakedFaces(faces.size());
+    bool baked = !faces.empty();
+    for (size_t i = 0; i < faces.size() && baked; i++) {
+        baked = loadBakedTexture(faces[i], bakedFaces[i], textureStreaming) &&
+                bakedFaces[i].mips.size() == bakedFaces[0].mips.size() &&
+                bakedFaces[i].firstLevel == bakedFaces[0].firstLevel &&
+                bakedFaces[i].width == bakedFaces[0].width &&
+                bakedFaces[i].format == bakedFaces[0].format;
+    }
 
-    int width, height, nrChannels;
-    for (unsigned int i = 0; i < faces.size(); i++) {
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-
-        if (data) {
-            GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, width, height, 0, format,
-                         GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
-        } else {
-            LOG_WARN("Cubemap texture failed to load at path: " + faces[i].c_str());
-            stbi_image_free(data);
+    GLint mipLevels = 1;
+    if (baked) {
+        for (unsigned int i = 0; i < faces.size(); i++) {
+            uploadBakedTexture(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, bakedFaces[i]);
+        }
+        mipLevels = (GLint)bakedFaces[0].mips.size();
+
+        if (bakedFaces[0].firstLevel > 0) {
+            std::vector<std::string> bakedPaths;
+            for (const auto& face : faces) bakedPaths.push_back(bakedTexturePath(face));
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, bakedFaces[0].firstLevel);
+            streamer.setJobSystem(jobSystem);
+            streamer.track(textureID, bakedPaths, bakedFaces);
+        }
+    } else {
+        // As seis faces decodificam ao mesmo tempo, cada uma num job
+        std::vector<ImagePipeline::DecodeTarget> images;
+        if (!uploadImages(faces, GL_TEXTURE_CUBE_MAP_POSITIVE_X, images)) {
+            LOG_WARN("Cubemap texture failed to load");
+            glDeleteTextures(1, &textureID);
             return 0;
         }
     }
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER,
+                    mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
@@ -252,6 +520,7 @@ unsigned int OpenGLRendererBackend::createCubemapTexture(const std::vector<std::
 }
 
 void OpenGLRendererBackend::deleteCubemapTexture(unsigned int textureID) {
+    streamer.forget(textureID);
     glDeleteTextures(1, &textureID);
 }
 
@@ -277,18 +546,146 @@ void OpenGLRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderPr
                        glm::value_ptr(projection));
     glUniform1i(glGetUniformLocation(shaderProgram, "skybox"), 0);
 
+    // Cada face cobre 90 graus, ou viewportHeight * projection[1][1] pixels
+    if (textureStreaming) {
+        streamer.request(textureID, viewportHeight * projection[1][1]);
+    }
+
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    glBindSampler(0, 0); // o cubemap usa os parametros da propria textura
 
     auto vao = static_cast<GLuint>(reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle()));
     glBindVertexArray(vao);
     glDrawArrays(GL_TRIANGLES, 0, 36);
     glBindVertexArray(0);
 
+    Stats::add(Stat::TEXTURE_BINDS);
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, 12);
+
     glDepthFunc(GL_LESS);
 }
 
-void OpenGLRendererBackend::present(SDL_Window* window) { SDL_GL_SwapWindow(window); }
+void OpenGLRendererBackend::present(SDL_Window* window) {
+    if (Stats::isOverlayVisible()) {
+        if (!statsOverlayCreated) {
+            statsOverlayCreated = true;
+            statsOverlay.init();
+        }
+        statsOverlay.draw();
+    }
+
+    gpuTimer.end(gpuFrameScope);
+
+    PROFILE_SCOPE("SwapWindow");
+    if (headless) {
+        glFlush();
+        return;
+    }
+    SDL_GL_SwapWindow(window);
+}
+
+bool OpenGLRendererBackend::makeCurrent(SDL_Window* window) {
+    if (headless) {
+        return headlessContext && headlessContext->makeCurrent(true);
+    }
+    if (SDL_GL_MakeCurrent(window, glContext) != 0) {
+        LOG_ERROR("SDL_GL_MakeCurrent failed: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void OpenGLRendererBackend::releaseCurrent(SDL_Window* window) {
+    if (headless) {
+        if (headlessContext) headlessContext->makeCurrent(false);
+        return;
+    }
+    SDL_GL_MakeCurrent(window, nullptr);
+}
+
+bool OpenGLRendererBackend::requestReadback() {
+    if (readbackSlots.size() != readbackSlotCount && readbackPending == 0) {
+        for (auto& slot : readbackSlots) {
+            if (slot.pbo)
+                glDeleteBuffers(1, &slot.pbo);
+        }
+        readbackSlots.assign(readbackSlotCount, ReadbackSlot{});
+        readbackHead = readbackTail = 0;
+    }
+    if (readbackPending == readbackSlots.size()) {
+        return false; // ring cheio, o consumidor esta atrasado
+    }
+
+    ReadbackSlot& slot = readbackSlots[readbackHead];
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    slot.width = viewport[2];
+    slot.height = viewport[3];
+    GLsizeiptr size = (GLsizeiptr)slot.width * slot.height * 4;
+
+    if (!slot.pbo) {
+        glGenBuffers(1, &slot.pbo);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (size != slot.capacity) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+
+    if (offscreenFBO) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, offscreenFBO);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+    } else {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glReadBuffer(GL_BACK);
+    }
+
+    // Com um PBO bound o glReadPixels so agenda a copia e retorna
+    glReadPixels(0, 0, slot.width, slot.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readbackHead = (readbackHead + 1) % readbackSlots.size();
+    readbackPending++;
+    return true;
+}
+
+bool OpenGLRendererBackend::pollReadback(std::vector<uint8_t>& pixels, int& width, int& height) {
+    if (readbackPending == 0) {
+        return false;
+    }
+
+    ReadbackSlot& slot = readbackSlots[readbackTail];
+    GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    readbackTail = (readbackTail + 1) % readbackSlots.size();
+    readbackPending--;
+
+    width = slot.width;
+    height = slot.height;
+    size_t rowSize = (size_t)width * 4;
+    pixels.resize(rowSize * height);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    auto src = static_cast<const uint8_t*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, rowSize * height, GL_MAP_READ_BIT));
+    if (src) {
+        // GL le de baixo pra cima
+        for (int y = 0; y < height; y++) {
+            memcpy(&pixels[y * rowSize], src + (height - 1 - y) * rowSize, rowSize);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return src != nullptr;
+}
 
 void OpenGLRendererBackend::initSpriteQuad() {
     float vertices[] = {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.5f,  -0.5f, 0.0f, 1.0f, 0.0f,
@@ -310,42 +707,183 @@ void OpenGLRendererBackend::initSpriteQuad() {
     glBindVertexArray(0);
 }
 
-unsigned int OpenGLRendererBackend::loadTexture(const std::string& path, uint8_t filterType) {
+unsigned int OpenGLRendererBackend::loadTexture(const std::string& path,
+                                                const SamplerDesc& sampler) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
 
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-
-    if (data) {
-        LOG_INFO("Texture loaded: " + path + " (" + std::to_string(width) + "x" +
-                 std::to_string(height) + ", " + std::to_string(nrChannels) + " channels)");
+    GLint mipLevels = 0;
+    size_t bytes = 0;
+    BakedTexture baked;
+    if (loadBakedTexture(path, baked, textureStreaming)) {
+        LOG_INFO("Texture loaded: %s (%ux%u baked, %zu mips, resident from mip %u)",
+                 path.c_str(), baked.width, baked.height, baked.mips.size(), baked.firstLevel);
 
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
         glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        uploadBakedTexture(GL_TEXTURE_2D, baked);
+        mipLevels = (GLint)baked.mips.size();
+        bytes = baked.data.size();
+
+        // Amostra so a cauda ate o streamer trazer os mips maiores
+        if (baked.firstLevel > 0) {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, baked.firstLevel);
+            streamer.setJobSystem(jobSystem);
+            streamer.setTextureManager(textureManager);
+            streamer.track(textureID, bakedTexturePath(path), baked);
+        }
+    } else {
+        std::vector<ImagePipeline::DecodeTarget> images;
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        if (!uploadImages({path}, GL_TEXTURE_2D, images)) {
+            LOG_ERROR("Failed to load texture: %s", path.c_str());
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDeleteTextures(1, &textureID);
+            return 0;
+        }
 
-        GLenum filter = (filterType == 1) ? GL_LINEAR : GL_NEAREST;
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        int width = images[0].info.width, height = images[0].info.height;
+        LOG_INFO("Texture loaded: %s (%dx%d, %d channels)", path.c_str(), width, height,
+                 images[0].info.channels);
 
-        stbi_image_free(data);
-    } else {
-        LOG_ERROR("Failed to load texture: " + path);
+        // Sem versao baked: a cadeia de mips sai do driver
+        glGenerateMipmap(GL_TEXTURE_2D);
+        mipLevels = (GLint)std::log2(std::max(width, height)) + 1;
+        bytes = (size_t)width * height * 4 * 4 / 3; // RGBA8 no driver + mips
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
+
+    // Filtro e wrap ficam no sampler compartilhado
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+    textures[textureID] = {getSampler(sampler), bytes};
 
     return textureID;
 }
 
+bool OpenGLRendererBackend::uploadImages(const std::vector<std::string>& paths, GLenum firstTarget,
+                                         std::vector<ImagePipeline::DecodeTarget>& images) {
+    images.assign(paths.size(), ImagePipeline::DecodeTarget());
+    std::vector<size_t> offsets(paths.size());
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        images[i].path = paths[i];
+        if (!ImagePipeline::probe(paths[i], images[i].info)) {
+            LOG_WARN("Image not found or unsupported: %s", paths[i].c_str());
+            return false;
+        }
+        offsets[i] = totalBytes;
+        totalBytes += (size_t)images[i].info.width * images[i].info.height * 4;
+    }
+
+    // Os workers escrevem o RGBA8 final direto no PBO mapeado; o orphan do
+    // glBufferData evita esperar por um upload anterior ainda na GPU
+    if (!uploadPBO) glGenBuffers(1, &uploadPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadPBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)totalBytes, nullptr, GL_STREAM_DRAW);
+    auto* mapped = static_cast<uint8_t*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)totalBytes,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (!mapped) {
+        LOG_ERROR("Failed to map pixel unpack buffer (%zu bytes)", totalBytes);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    for (size_t i = 0; i < images.size(); i++) images[i].pixels = mapped + offsets[i];
+    bool ok = ImagePipeline::decode(images, ImagePipeline::ConvertOptions(), jobSystem) ==
+              images.size();
+    ok = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE && ok;
+
+    if (ok) {
+        for (size_t i = 0; i < images.size(); i++) {
+            glTexImage2D(firstTarget + (GLenum)i, 0, GL_RGBA8, images[i].info.width,
+                         images[i].info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         reinterpret_cast<const void*>(offsets[i]));
+        }
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return ok;
+}
+
+void OpenGLRendererBackend::deleteTexture(unsigned int textureID) {
+    streamer.forget(textureID);
+    glDeleteTextures(1, &textureID);
+    textures.erase(textureID);
+}
+
+size_t OpenGLRendererBackend::getTextureBytes(unsigned int textureID) const {
+    auto it = textures.find(textureID);
+    return it != textures.end() ? it->second.bytes : 0;
+}
+
+void OpenGLRendererBackend::uploadStreamedMips() {
+    std::vector<TextureStreamer::Levels> arrived;
+    streamer.poll(arrived);
+
+    for (const auto& levels : arrived) {
+        bool cubemap = levels.faces.size() == 6;
+        GLenum target = cubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+        glBindTexture(target, levels.texture);
+        for (size_t i = 0; i < levels.faces.size(); i++) {
+            uploadBakedTexture(cubemap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i : target,
+                               levels.faces[i]);
+        }
+        glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, (GLint)levels.firstLevel);
+        glBindTexture(target, 0);
+
+        auto info = textures.find(levels.texture);
+        if (info != textures.end()) {
+            info->second.bytes += levels.faces[0].data.size();
+            if (textureManager) {
+                textureManager->updateTextureBytes(levels.texture, info->second.bytes);
+            }
+        }
+        LOG_DEBUG("Texture %u now resident from mip %u", levels.texture, levels.firstLevel);
+    }
+}
+
+GLuint OpenGLRendererBackend::getSampler(const SamplerDesc& desc) {
+    auto it = samplers.find(desc.key());
+    if (it != samplers.end()) return it->second;
+
+    GLuint sampler;
+    glGenSamplers(1, &sampler);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    switch (desc.filter) {
+    case TextureFilter::NEAREST:
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        break;
+    case TextureFilter::LINEAR:
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        break;
+    case TextureFilter::TRILINEAR:
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        break;
+    }
+
+    if (desc.maxAnisotropy > 1 && GLEW_EXT_texture_filter_anisotropic) {
+        GLfloat maxSupported = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxSupported);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT,
+                            std::min((GLfloat)desc.maxAnisotropy, maxSupported));
+    }
+
+    LOG_DEBUG("Created sampler %u (filter %d, anisotropy %d)", sampler, (int)desc.filter,
+              desc.maxAnisotropy);
+    samplers.emplace(desc.key(), sampler);
+    return sampler;
+}
+
 void OpenGLRendererBackend::drawSprite(const Sprite& sprite) {
-    LOG_INFO("Drawing sprite - TextureID: " + std::to_string(sprite.getTexture()) + " Width: " +
-             std::to_string(sprite.getWidth()) + " Height: " + std::to_string(sprite.getHeight()));
+    LOG_DEBUG("Drawing sprite - TextureID: %u Width: %f Height: %f", sprite.getTexture(),
+              sprite.getWidth(), sprite.getHeight());
 
     // Não sobrescrever a matriz model, apenas aplicar a escala do sprite
-    // A matriz model já foi configurada em renderGameObjects com o Transform
+    // A matriz model já foi configurada em submitQueue com o Transform
     glm::mat4 spriteScale =
         glm::scale(glm::mat4(1.0f), glm::vec3(sprite.getWidth(), sprite.getHeight(), 1.0f));
 
@@ -359,14 +897,21 @@ void OpenGLRendererBackend::drawSprite(const Sprite& sprite) {
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(finalModel));
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+    GLuint texture = resolveTexture(sprite.getTexture());
+    if (textureStreaming) {
+        streamer.request(texture, projectedSize(viewProjection * finalModel, viewportWidth,
+                                                viewportHeight));
+    }
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, sprite.getTexture());
+    glBindTexture(GL_TEXTURE_2D, texture);
+    auto info = textures.find(texture);
+    glBindSampler(0, info != textures.end() ? info->second.sampler : 0);
 
     GLint currentProgram;
     glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
     GLint texLoc =
         glGetUniformLocation(currentProgram, "SPIRV_Cross_CombinedspriteTexturespriteSampler");
-    LOG_INFO("Texture uniform location: " + std::to_string(texLoc));
+    LOG_DEBUG("Texture uniform location: %d", texLoc);
     if (texLoc != -1) {
         glUniform1i(texLoc, 0);
     }
@@ -375,8 +920,14 @@ void OpenGLRendererBackend::drawSprite(const Sprite& sprite) {
     glDrawArrays(GL_TRIANGLES, 0, 6);
     glBindVertexArray(0);
 
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, sizeof(glm::mat4));
+    Stats::add(Stat::TEXTURE_BINDS);
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, 2);
+
     GLenum err = glGetError();
     if (err != GL_NO_ERROR) {
-        LOG_ERROR("OpenGL error in drawSprite: " + std::to_string(err));
+        LOG_ERROR("OpenGL error in drawSprite: %u", err);
     }
 }
@@ -2,9 +2,17 @@
 #define OPEN_GL_RENDERER_BACKEND_HPP
 
 #include "../../../graphics_api.hpp"
+#include "../../../image_pipeline.hpp"
 #include "../../../mesh.hpp"
+#include "../../../texture_streamer.hpp"
 #include "../../renderer_backend.hpp"
+#include "open_gl_gpu_timer.hpp"
+#include "open_gl_headless_context.hpp"
+#include "open_gl_shadow_pass.hpp"
+#include "open_gl_stats_overlay.hpp"
 #include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -17,17 +25,82 @@ class OpenGLRendererBackend : public RendererBackend {
     GLuint matricesUBO = 0;
     GLuint materialDataUBO = 0;
     GLuint lightDataUBO = 0;
+    // Luzes point/spot em clusters: parametros num UBO, listas em texture buffers
+    GLuint clusterDataUBO = 0;
+    struct TextureBuffer {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+    };
+    TextureBuffer clusterLights;  // RGBA32F, 3 texels por luz
+    TextureBuffer clusterGrid;    // RG32UI, (offset, count) por cluster
+    TextureBuffer clusterIndices; // R32UI
     std::unordered_map<std::string, GLuint> uniformBindings;
+    std::unordered_map<uint32_t, GLuint> samplers;      // SamplerDesc::key() -> sampler
+    struct TextureInfo {
+        GLuint sampler = 0;
+        size_t bytes = 0;
+    };
+    std::unordered_map<GLuint, TextureInfo> textures; // texturas 2D de loadTexture
+    void* glContext = nullptr; // SDL_GLContext da janela
+    GLuint uploadPBO = 0;      // imagens decodificadas vao direto para ele
+
+    // Streaming: tamanho na tela de cada textura decide quais mips pedir
+    TextureStreamer streamer;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+
+    OpenGLGpuTimer gpuTimer;
+    int gpuFrameScope = -1;
+
+    // Criado no primeiro frame com uma luz que projeta sombra
+    OpenGLShadowPass shadowPass;
+    bool shadowPassCreated = false;
+
+    // Criado na primeira vez que o overlay e ligado
+    OpenGLStatsOverlay statsOverlay;
+    bool statsOverlayCreated = false;
+
+    // Headless: tudo e desenhado num FBO em vez do default framebuffer
+    std::unique_ptr<OpenGLHeadlessContext> headlessContext;
+    GLuint offscreenFBO = 0;
+    GLuint offscreenColor = 0;
+    GLuint offscreenDepth = 0;
+    int offscreenWidth = 0;
+    int offscreenHeight = 0;
+
+    struct ReadbackSlot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        GLsizeiptr capacity = 0;
+        int width = 0;
+        int height = 0;
+    };
+    std::vector<ReadbackSlot> readbackSlots;
+    size_t readbackHead = 0; // proximo slot a receber um glReadPixels
+    size_t readbackTail = 0; // slot pendente mais antigo
+    size_t readbackPending = 0;
 
     void initSpriteQuad();
+    void initTextureBuffer(TextureBuffer& textureBuffer, GLenum format, GLint unit);
+    GLuint getSampler(const SamplerDesc& desc);
+    void uploadStreamedMips();
+    bool uploadImages(const std::vector<std::string>& paths, GLenum firstTarget,
+                      std::vector<ImagePipeline::DecodeTarget>& images);
+    bool createOffscreenTarget(int width, int height);
 
   public:
     ~OpenGLRendererBackend();
 
-    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    unsigned int loadTexture(const std::string& path,
+                             const SamplerDesc& sampler = SamplerDesc()) override;
+    void deleteTexture(unsigned int textureID) override;
+    size_t getTextureBytes(unsigned int textureID) const override;
     void drawSprite(const Sprite& sprite) override;
     bool init() override;
     void present(SDL_Window* window) override;
+    bool makeCurrent(SDL_Window* window) override;
+    void releaseCurrent(SDL_Window* window) override;
     bool initWindowContext() override;
     void bindCamera(Camera* camera) override;
     void applyMaterial(Material* material) override;    
@@ -45,6 +118,11 @@ class OpenGLRendererBackend : public RendererBackend {
 
     void renderGameObjects(std::vector<GameObject*>* gameObjects,
                            std::vector<Light>* lights) override;
+    void submitQueue(const RenderQueue& queue, std::vector<Light>* lights) override;
+    void submitShadows(const ShadowCascades& shadows) override;
+    bool supportsShadows() const override { return true; }
+    void submitLights(const LightBuffer& lights) override;
+    void submitLightClusters(const LightClusters& clusters) override;
 
     // Skybox management
     void deleteCubemapTexture(unsigned int textureID);
@@ -53,6 +131,10 @@ class OpenGLRendererBackend : public RendererBackend {
 
     unsigned int getRequiredWindowFlags() const override;
     bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool requestReadback() override;
+    bool pollReadback(std::vector<uint8_t>& pixels, int& width, int& height) override;
+    size_t getPendingReadbacks() const override { return readbackPending; }
 };
 
 #endif // OPENGLRENDERERBACKEND_HPP
@@ -12,7 +12,7 @@ bool OpenGLShaderCompiler::compile(const std::string& source, ShaderType type, v
     // Ler o arquivo GLSL
     std::ifstream file(source);
     if (!file.is_open()) {
-        LOG_ERROR("Failed to open shader file: " + source);
+        LOG_ERROR("Failed to open shader file: %s", source.c_str());
         return false;
     }
     
@@ -32,7 +32,7 @@ bool OpenGLShaderCompiler::compile(const std::string& source, ShaderType type, v
     if (!success) {
         GLchar infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        LOG_ERROR("Shader compilation error: " + infoLog);
+        LOG_ERROR("Shader compilation error: %s", infoLog);
         glDeleteShader(shader);
         return false;
     } 
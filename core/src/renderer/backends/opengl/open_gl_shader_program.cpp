@@ -1,13 +1,16 @@
 #define CLASS_NAME "OpenGLShaderProgram"
 #include "open_gl_shader_program.hpp"
 #include "log_macros.hpp"
+#include "stats.hpp"
 #include "shader_asset.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <utility>
 
 
 OpenGLShaderProgram::~OpenGLShaderProgram() {
-    for (auto& pair : uniformBuffers) {
-        glDeleteBuffers(1, &pair.second);
+    for (const OwnedBlock& block : ownedBlocks) {
+        glDeleteBuffers(1, &block.ubo);
     }
     if (programID != 0) {
         glDeleteProgram(programID);
@@ -22,6 +25,54 @@ bool OpenGLShaderProgram::attachShader(const ShaderAsset& shader) {
     auto value = reinterpret_cast<std::uintptr_t>(shader.getHandle());
     GLuint shaderID = static_cast<GLuint>(value);
     glAttachShader(programID, shaderID);
+
+    if (!reflection.merge(shader.getReflection())) {
+        LOG_WARN("Uniform blocks of %s disagree with the other stage", shader.getPath().c_str());
+    }
+    return true;
+}
+
+bool OpenGLShaderProgram::bindBlock(const std::string& name, GLuint binding, GLsizeiptr size) {
+    // Spirv-cross prefixes uniforms with 'type_'
+    GLuint blockIndex = glGetUniformBlockIndex(programID, ("type_" + name).c_str());
+    if (blockIndex == GL_INVALID_INDEX) {
+        return false;
+    }
+
+    // Matrizes, luzes e clusters sao buffers do backend, enviados uma vez por
+    // frame: o programa so aponta o bloco para o ponto onde eles estao
+    static const std::pair<const char*, GLuint> backendBlocks[] = {
+        {"ModelViewProjection", MATRICES_BINDING},
+        {"LightData", LIGHT_DATA_BINDING},
+        {"ClusterData", CLUSTER_DATA_BINDING}};
+    for (const auto& [backendName, backendBinding] : backendBlocks) {
+        if (name != backendName) continue;
+        if (binding != backendBinding) {
+            LOG_WARN("%s declared at binding %u, the backend feeds it at %u", name.c_str(),
+                     binding, backendBinding);
+        }
+        glUniformBlockBinding(programID, blockIndex, backendBinding);
+        return true;
+    }
+
+    // O resto e do programa, com buffer do tamanho exato do bloco
+    if (size <= 0) {
+        GLint dataSize = 0;
+        glGetActiveUniformBlockiv(programID, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+        size = dataSize;
+    }
+    glUniformBlockBinding(programID, blockIndex, binding);
+
+    OwnedBlock block;
+    block.name = name;
+    block.binding = binding;
+    block.size = size;
+    glGenBuffers(1, &block.ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, block.ubo);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    ownedBlocks.push_back(std::move(block));
     return true;
 }
 
@@ -33,48 +84,68 @@ bool OpenGLShaderProgram::link() {
     if (success != GL_TRUE) {
         GLchar infoLog[512];
         glGetProgramInfoLog(programID, 512, nullptr, infoLog);
-        LOG_ERROR("Shader program link error: " + infoLog);
+        LOG_ERROR("Shader program link error: %s", infoLog);
         return false;
     }
 
-    uniformBindings["ModelViewProjection"] = 0;
-    uniformBindings["MaterialData"] = 1;
-    uniformBindings["LightData"] = 2;
+    if (!reflection.empty()) {
+        for (const ShaderBlock& block : reflection.getBlocks()) {
+            if (!bindBlock(block.name, block.binding, block.size)) {
+                LOG_WARN("Uniform block %s not found in the linked program", block.name.c_str());
+            }
+        }
+    } else {
+        // Sem .spv: os blocos conhecidos nos pontos de sempre, tamanho do driver.
+        // Programas sem luz nao tem os nomes.
+        bindBlock("ModelViewProjection", MATRICES_BINDING, 0);
+        bindBlock("MaterialData", MATERIAL_BINDING, 0);
+        bindBlock("LightData", LIGHT_DATA_BINDING, 0);
+        bindBlock("ClusterData", CLUSTER_DATA_BINDING, 0);
+    }
+
+    // Texture buffers dos clusters e o shadow map, sempre nas mesmas unidades
+    GLint previous = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+    glUseProgram(programID);
+    const std::pair<const char*, GLint> samplers[] = {
+        {"ClusterLights", CLUSTER_LIGHTS_UNIT},
+        {"ClusterGrid", CLUSTER_GRID_UNIT},
+        {"ClusterLightIndices", CLUSTER_INDICES_UNIT},
+        {"SPIRV_Cross_CombinedShadowMapShadowSampler", SHADOW_MAP_UNIT}};
+    for (const auto& [name, unit] : samplers) {
+        GLint location = glGetUniformLocation(programID, name);
+        if (location >= 0) glUniform1i(location, unit);
+    }
+    glUseProgram((GLuint)previous);
 
     return true;
 }
 
-void OpenGLShaderProgram::use() { glUseProgram(programID); }
+void OpenGLShaderProgram::use() {
+    glUseProgram(programID);
+    // O ponto e global: sem religar, o ultimo material enviado valeria para todos
+    for (const OwnedBlock& block : ownedBlocks) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, block.binding, block.ubo);
+    }
+}
 
 void OpenGLShaderProgram::setUniformBuffer(const char* name, const void* data, size_t size) {
-    auto it = uniformBindings.find(name);
-    if (it == uniformBindings.end()) {
-        LOG_WARN("Uniform binding for " + std::string(name) + " not found!");
+    // Poucos blocos e so no setup do material; nada disso roda por draw
+    auto it = std::find_if(ownedBlocks.begin(), ownedBlocks.end(),
+                           [&](const OwnedBlock& block) { return block.name == name; });
+    if (it == ownedBlocks.end()) {
+        LOG_WARN("Uniform block %s not found!", name);
         return;
     }
 
-    //Spirv-cross prefixes uniforms with 'type_'
-    GLuint blockIndex = glGetUniformBlockIndex(programID, ("type_" + std::string(name)).c_str());
-    if (blockIndex == GL_INVALID_INDEX) {
-        LOG_WARN("Uniform block index for " + std::string(name) + " not found!");
-        return;
+    if ((GLsizeiptr)size > it->size) {
+        LOG_WARN("%zu bytes for %s, the block has %ld", size, name, (long)it->size);
+        size = (size_t)it->size;
     }
 
-    int binding = it->second;
-    glUniformBlockBinding(programID, blockIndex, binding);
-
-    // Se name não existe no mapa, cria uma entrada com valor 0
-    // Se já existe, retorna referência ao GLuint existente
-    GLuint& ubo = uniformBuffers[name];
-    if (ubo == 0) {
-        //Só cria o buffer OpenGL na primeira vez que é usado
-        //O ID gerado é armazenado no mapa para reutilização
-        glGenBuffers(1, &ubo);
-    }
-    
-    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-    glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, it->ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, size);
 }
-
@@ -3,16 +3,41 @@
 
 #include "shader_program.hpp"
 #include <GL/glew.h>
-#include <unordered_map>
 #include <string>
+#include <vector>
 
 class OpenGLShaderProgram : public ShaderProgram {
 private:
     GLuint programID = 0;
-    std::unordered_map<std::string, int> uniformBindings;
-    std::unordered_map<std::string, GLuint> uniformBuffers;
+
+    // Bloco cujo buffer e do programa (MaterialData): criado no link com o
+    // tamanho do bloco e religado no ponto dele a cada use()
+    struct OwnedBlock {
+        std::string name;
+        GLuint binding = 0;
+        GLuint ubo = 0;
+        GLsizeiptr size = 0;
+    };
+    std::vector<OwnedBlock> ownedBlocks;
+
+    bool bindBlock(const std::string& name, GLuint binding, GLsizeiptr size);
 
 public:
+    // Pontos de binding dos uniform blocks que o backend alimenta; iguais aos
+    // register(bN) do HLSL
+    static constexpr GLuint MATRICES_BINDING = 0;
+    static constexpr GLuint MATERIAL_BINDING = 1;
+    static constexpr GLuint LIGHT_DATA_BINDING = 2;
+    // Onde o backend deixa os buffers de luz em clusters (LightClusters)
+    static constexpr GLuint CLUSTER_DATA_BINDING = 3;
+    static constexpr GLint CLUSTER_LIGHTS_UNIT = 4;
+    static constexpr GLint CLUSTER_GRID_UNIT = 5;
+    static constexpr GLint CLUSTER_INDICES_UNIT = 6;
+    // Sombras em cascata (OpenGLShadowPass): mapa de profundidade e as matrizes
+    // das instancias do passe de sombra
+    static constexpr GLint SHADOW_MAP_UNIT = 7;
+    static constexpr GLint SHADOW_INSTANCES_UNIT = 8;
+
     ~OpenGLShaderProgram() override;
     bool attachShader(const ShaderAsset& shader) override;
     bool link() override;
@@ -0,0 +1,185 @@
+#define CLASS_NAME "OpenGLShadowPass"
+#include "../../../log_macros.hpp"
+
+#include "open_gl_shadow_pass.hpp"
+#include "../../../profiler.hpp"
+#include "../../../stats.hpp"
+#include "open_gl_shader_program.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstdint>
+
+namespace {
+
+// GL 3.3 nao tem base instance no draw: o primeiro indice vai num uniform
+const char* VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 position;
+uniform samplerBuffer instanceModels;
+uniform mat4 viewProjection;
+uniform int firstInstance;
+void main() {
+    int base = (firstInstance + gl_InstanceID) * 4;
+    mat4 model = mat4(texelFetch(instanceModels, base), texelFetch(instanceModels, base + 1),
+                      texelFetch(instanceModels, base + 2), texelFetch(instanceModels, base + 3));
+    gl_Position = viewProjection * model * vec4(position, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(#version 330 core
+void main() {}
+)";
+
+GLuint compile(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        LOG_ERROR("Shadow shader compilation error: %s", infoLog);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+} // namespace
+
+OpenGLShadowPass::~OpenGLShadowPass() {
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (depthTexture) glDeleteTextures(1, &depthTexture);
+    if (instanceTexture) glDeleteTextures(1, &instanceTexture);
+    if (instanceBuffer) glDeleteBuffers(1, &instanceBuffer);
+    if (program) glDeleteProgram(program);
+}
+
+bool OpenGLShadowPass::init() {
+    GLuint vs = compile(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fs = compile(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success != GL_TRUE) {
+        LOG_ERROR("Shadow program link failed");
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+    viewProjectionLoc = glGetUniformLocation(program, "viewProjection");
+    firstInstanceLoc = glGetUniformLocation(program, "firstInstance");
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "instanceModels"),
+                OpenGLShaderProgram::SHADOW_INSTANCES_UNIT);
+    glUseProgram(0);
+
+    // Uma camada por cascata possivel; compare mode faz o PCF 2x2 no sampler
+    const GLsizei size = ShadowCascades::MAP_SIZE;
+    glGenTextures(1, &depthTexture);
+    glActiveTexture(GL_TEXTURE0 + OpenGLShaderProgram::SHADOW_MAP_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depthTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, size, size,
+                 ShadowCascades::MAX_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+    // Matrizes das instancias: ligado na propria unidade para sempre
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, instanceBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glGenTextures(1, &instanceTexture);
+    glActiveTexture(GL_TEXTURE0 + OpenGLShaderProgram::SHADOW_INSTANCES_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, instanceTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, instanceBuffer);
+    glActiveTexture(GL_TEXTURE0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    Stats::add(Stat::GPU_ALLOCATIONS, 4);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Shadow framebuffer incomplete: 0x%x", status);
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+    return true;
+}
+
+void OpenGLShadowPass::render(const ShadowCascades& shadows) {
+    if (!program || !shadows.isActive()) return;
+    PROFILE_SCOPE("ShadowPass");
+
+    GLint previousFramebuffer = 0;
+    GLint viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // glBufferData a cada frame orfana o store que a GPU ainda pode estar lendo
+    const auto& models = shadows.getInstanceModels();
+    size_t bytes = models.size() * sizeof(glm::mat4);
+    glBindBuffer(GL_TEXTURE_BUFFER, instanceBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)bytes, models.empty() ? nullptr : models.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, bytes);
+
+    // Depth clamp achata os casters que ficam antes do near da cascata (o
+    // culling nao testa esse plano); o offset por inclinacao tira o acne
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, ShadowCascades::MAP_SIZE, ShadowCascades::MAP_SIZE);
+    glEnable(GL_DEPTH_CLAMP);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(1.5f, 2.0f);
+    glUseProgram(program);
+    Stats::add(Stat::PROGRAM_BINDS);
+
+    const auto& runs = shadows.getRuns();
+    for (uint32_t c = 0; c < shadows.getCascadeCount(); c++) {
+        const ShadowCascades::Cascade& cascade = shadows.getCascade(c);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, c);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glUniformMatrix4fv(viewProjectionLoc, 1, GL_FALSE,
+                           glm::value_ptr(cascade.viewProjection));
+
+        for (uint32_t r = cascade.firstRun; r < cascade.firstRun + cascade.runCount; r++) {
+            const ShadowCascades::Run& run = runs[r];
+            auto vao = static_cast<GLuint>(
+                reinterpret_cast<uintptr_t>(run.mesh->getMeshBufferHandle()));
+            glBindVertexArray(vao);
+            glUniform1i(firstInstanceLoc, (GLint)run.first);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, (GLsizei)(run.mesh->getVertices().size() / 3),
+                                  (GLsizei)run.count);
+            Stats::add(Stat::SHADOW_DRAWS);
+        }
+    }
+    glBindVertexArray(0);
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_DEPTH_CLAMP);
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
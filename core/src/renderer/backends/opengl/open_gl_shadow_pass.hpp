@@ -0,0 +1,29 @@
+#ifndef OPEN_GL_SHADOW_PASS_HPP
+#define OPEN_GL_SHADOW_PASS_HPP
+
+#include "../../shadow_cascades.hpp"
+#include <GL/glew.h>
+
+// Depth-only pass of ShadowCascades into a depth texture array, one layer per
+// cascade. Uses its own GLSL program, like the stats overlay: it only needs
+// positions and matrices, so it skips the HLSL materials entirely. Each run is
+// one glDrawArraysInstanced reading the model matrices from a texture buffer.
+class OpenGLShadowPass {
+  private:
+    GLuint program = 0;
+    GLuint depthTexture = 0; // GL_TEXTURE_2D_ARRAY com compare mode, para PCF
+    GLuint framebuffer = 0;
+    GLuint instanceBuffer = 0;
+    GLuint instanceTexture = 0; // RGBA32F, 4 texels por matriz
+    GLint viewProjectionLoc = -1;
+    GLint firstInstanceLoc = -1;
+
+  public:
+    ~OpenGLShadowPass();
+
+    bool init();
+    // Devolve o framebuffer e o viewport que estavam ligados
+    void render(const ShadowCascades& shadows);
+};
+
+#endif // OPEN_GL_SHADOW_PASS_HPP
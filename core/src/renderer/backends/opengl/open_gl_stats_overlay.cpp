@@ -0,0 +1,256 @@
+#define CLASS_NAME "OpenGLStatsOverlay"
+#include "../../../log_macros.hpp"
+
+#include "open_gl_stats_overlay.hpp"
+#include "../../../stats.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr int GLYPH_W = 5;
+constexpr int GLYPH_H = 7;
+constexpr float SCALE = 2.0f;
+constexpr float MARGIN = 8.0f;
+constexpr float ADVANCE = (GLYPH_W + 1) * SCALE;
+constexpr float LINE_HEIGHT = (GLYPH_H + 2) * SCALE;
+
+// Linhas de 5 bits, bit 4 = coluna da esquerda
+constexpr char GLYPHS[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ:.-/%";
+constexpr uint8_t FONT[][GLYPH_H] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+    {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04}, // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+    {0x00, 0x04, 0x04, 0x00, 0x04, 0x04, 0x00}, // ':'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // '.'
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+};
+constexpr int GLYPH_COUNT = sizeof(GLYPHS) - 1;
+
+const char* VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec4 vertex;
+uniform vec2 viewport;
+out vec2 uv;
+void main() {
+    uv = vertex.zw;
+    vec2 ndc = vertex.xy / viewport * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+}
+)";
+
+// u < 0 marca o retangulo de fundo
+const char* FRAGMENT_SHADER = R"(#version 330 core
+in vec2 uv;
+out vec4 color;
+uniform sampler2D font;
+void main() {
+    if (uv.x < 0.0) {
+        color = vec4(0.0, 0.0, 0.0, 0.6);
+        return;
+    }
+    color = vec4(1.0, 1.0, 0.6, texture(font, uv).r);
+}
+)";
+
+GLuint compile(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        LOG_ERROR("Overlay shader compilation error: %s", infoLog);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+int glyphIndex(char c) {
+    c = (char)std::toupper((unsigned char)c);
+    if (c == '_') c = ' ';
+    const char* found = c ? std::strchr(GLYPHS, c) : nullptr;
+    return found ? (int)(found - GLYPHS) : 0;
+}
+
+} // namespace
+
+OpenGLStatsOverlay::~OpenGLStatsOverlay() {
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (fontTexture) glDeleteTextures(1, &fontTexture);
+    if (program) glDeleteProgram(program);
+}
+
+bool OpenGLStatsOverlay::init() {
+    GLuint vs = compile(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fs = compile(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success != GL_TRUE) {
+        LOG_ERROR("Overlay program link failed");
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+    viewportLoc = glGetUniformLocation(program, "viewport");
+
+    // Atlas R8 com todos os glifos lado a lado
+    std::vector<uint8_t> atlas(GLYPH_COUNT * GLYPH_W * GLYPH_H, 0);
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        for (int y = 0; y < GLYPH_H; y++) {
+            for (int x = 0; x < GLYPH_W; x++) {
+                bool on = FONT[g][y] & (1 << (GLYPH_W - 1 - x));
+                atlas[y * GLYPH_COUNT * GLYPH_W + g * GLYPH_W + x] = on ? 255 : 0;
+            }
+        }
+    }
+
+    glGenTextures(1, &fontTexture);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, GLYPH_COUNT * GLYPH_W, GLYPH_H, 0, GL_RED,
+                 GL_UNSIGNED_BYTE, atlas.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return true;
+}
+
+void OpenGLStatsOverlay::addQuad(float x0, float y0, float x1, float y1, float u0, float v0,
+                                 float u1, float v1) {
+    const float quad[] = {x0, y0, u0, v0, x1, y0, u1, v0, x1, y1, u1, v1,
+                          x0, y0, u0, v0, x1, y1, u1, v1, x0, y1, u0, v1};
+    vertices.insert(vertices.end(), std::begin(quad), std::end(quad));
+}
+
+void OpenGLStatsOverlay::addText(float x, float y, const char* text) {
+    const float glyphU = 1.0f / GLYPH_COUNT;
+    for (; *text; text++, x += ADVANCE) {
+        int g = glyphIndex(*text);
+        if (g == 0) continue;
+        addQuad(x, y, x + GLYPH_W * SCALE, y + GLYPH_H * SCALE, g * glyphU, 0.0f,
+                (g + 1) * glyphU, 1.0f);
+    }
+}
+
+void OpenGLStatsOverlay::draw() {
+    if (!program) return;
+
+    Stats::Snapshot values = Stats::getLastFrame();
+    char lines[Stats::COUNT + 1][64];
+    std::snprintf(lines[0], sizeof(lines[0]), "frame ms: %.2f", Stats::getLastFrameMs());
+    size_t longest = std::strlen(lines[0]);
+    for (size_t i = 0; i < Stats::COUNT; i++) {
+        std::snprintf(lines[i + 1], sizeof(lines[i + 1]), "%s: %lld",
+                      Stats::getName(static_cast<Stat>(i)), (long long)values[i]);
+        longest = std::max(longest, std::strlen(lines[i + 1]));
+    }
+
+    vertices.clear();
+    addQuad(MARGIN - 4.0f, MARGIN - 4.0f, MARGIN + longest * ADVANCE + 4.0f,
+            MARGIN + (Stats::COUNT + 1) * LINE_HEIGHT + 2.0f, -1.0f, 0.0f, -1.0f, 0.0f);
+    for (size_t i = 0; i <= Stats::COUNT; i++) {
+        addText(MARGIN, MARGIN + i * LINE_HEIGHT, lines[i]);
+    }
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(program);
+    glUniform2f(viewportLoc, (float)viewport[2], (float)viewport[3]);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glBindSampler(0, 0); // filtro da propria textura da fonte
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    size_t bytes = vertices.size() * sizeof(float);
+    if (bytes > vboCapacity) {
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        vboCapacity = bytes;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / 4));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    if (cullFace) glEnable(GL_CULL_FACE);
+    if (!blend) glDisable(GL_BLEND);
+}
@@ -0,0 +1,29 @@
+#ifndef OPEN_GL_STATS_OVERLAY_HPP
+#define OPEN_GL_STATS_OVERLAY_HPP
+
+#include <GL/glew.h>
+#include <vector>
+
+// Desenha o ultimo snapshot de Stats no canto da tela com uma fonte bitmap 5x7
+// embutida, entao nao depende de nenhum asset nem do pipeline de shaders HLSL.
+class OpenGLStatsOverlay {
+  private:
+    GLuint program = 0;
+    GLuint fontTexture = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLint viewportLoc = -1;
+    size_t vboCapacity = 0;
+    std::vector<float> vertices; // x, y, u, v por vertice
+
+    void addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1);
+    void addText(float x, float y, const char* text);
+
+  public:
+    ~OpenGLStatsOverlay();
+
+    bool init();
+    void draw();
+};
+
+#endif // OPEN_GL_STATS_OVERLAY_HPP
@@ -0,0 +1,121 @@
+#define CLASS_NAME "VulkanCommandRecorder"
+#include "../../../log_macros.hpp"
+
+#include "vulkan_command_recorder.hpp"
+#include "../../../job_system.hpp"
+#include <algorithm>
+
+VulkanCommandRecorder::~VulkanCommandRecorder() { destroy(); }
+
+bool VulkanCommandRecorder::init(VkDevice device, uint32_t queueFamily) {
+    this->device = device;
+    this->queueFamily = queueFamily;
+    return createContexts(1);
+}
+
+bool VulkanCommandRecorder::createContexts(size_t count) {
+    while (contexts.size() < count) {
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = queueFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+        ThreadContext ctx;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &ctx.pool) != VK_SUCCESS) {
+            LOG_ERROR("Failed to create per-thread command pool");
+            return false;
+        }
+        contexts.push_back(std::move(ctx));
+    }
+    return true;
+}
+
+void VulkanCommandRecorder::destroy() {
+    for (auto& ctx : contexts) {
+        if (ctx.pool) vkDestroyCommandPool(device, ctx.pool, nullptr);
+    }
+    contexts.clear();
+}
+
+void VulkanCommandRecorder::beginFrame(Yume::JobSystem* jobSystem) {
+    jobs = jobSystem && jobSystem->getWorkerCount() > 0 ? jobSystem : nullptr;
+
+    size_t needed = jobs ? jobs->getThreadCount() + 1 : 1;
+    if (contexts.size() < needed) {
+        // Pools novos ficam vazios; os antigos seguem o reset abaixo
+        createContexts(needed);
+        LOG_INFO("Recording with %zu thread(s)", jobs ? jobs->getWorkerCount() + 1 : size_t(1));
+    }
+
+    for (auto& ctx : contexts) {
+        vkResetCommandPool(device, ctx.pool, 0);
+        ctx.used = 0;
+    }
+}
+
+VulkanCommandRecorder::ThreadContext& VulkanCommandRecorder::currentContext() {
+    // O ultimo contexto e de quem chamou record() sem slot no job system
+    size_t index = Yume::JobSystem::getThreadIndex();
+    return index < contexts.size() - 1 ? contexts[index] : contexts.back();
+}
+
+VkCommandBuffer VulkanCommandRecorder::acquire(ThreadContext& ctx) {
+    if (ctx.used == ctx.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = ctx.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        vkAllocateCommandBuffers(device, &allocInfo, &cmd);
+        ctx.buffers.push_back(cmd);
+    }
+    return ctx.buffers[ctx.used++];
+}
+
+void VulkanCommandRecorder::recordChunk(size_t chunk) {
+    VkCommandBuffer cmd = acquire(currentContext());
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                      VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = jobInheritance;
+    vkBeginCommandBuffer(cmd, &beginInfo);
+
+    size_t begin = jobCount * chunk / jobChunks;
+    size_t end = jobCount * (chunk + 1) / jobChunks;
+    (*jobFn)(cmd, begin, end);
+
+    vkEndCommandBuffer(cmd);
+    jobOutput[chunk] = cmd;
+}
+
+const std::vector<VkCommandBuffer>&
+VulkanCommandRecorder::record(size_t count, size_t minPerChunk,
+                              const VkCommandBufferInheritanceInfo& inheritance,
+                              const RecordFn& fn) {
+    size_t maxChunks = jobs ? jobs->getWorkerCount() + 1 : 1;
+    size_t chunks = (count + minPerChunk - 1) / std::max<size_t>(minPerChunk, 1);
+    chunks = std::clamp<size_t>(chunks, 1, maxChunks);
+
+    jobCount = count;
+    jobChunks = chunks;
+    jobInheritance = &inheritance;
+    jobFn = &fn;
+    jobOutput.assign(chunks, VK_NULL_HANDLE);
+
+    if (chunks == 1) {
+        recordChunk(0);
+        return jobOutput;
+    }
+
+    Yume::JobCounter counter;
+    for (size_t i = 1; i < chunks; i++) {
+        jobs->run([this, i]() { recordChunk(i); }, &counter);
+    }
+    recordChunk(0);
+    jobs->wait(counter);
+    return jobOutput;
+}
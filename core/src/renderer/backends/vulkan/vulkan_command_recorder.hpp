@@ -0,0 +1,67 @@
+#ifndef VULKAN_COMMAND_RECORDER_HPP
+#define VULKAN_COMMAND_RECORDER_HPP
+
+#include <vulkan/vulkan.h>
+#include <functional>
+#include <vector>
+
+namespace Yume {
+class JobSystem;
+}
+
+// Records a range of draws into secondary command buffers in parallel on the
+// engine job system. Every job-system thread owns its own VkCommandPool, so
+// no pool is ever touched by two threads at once.
+class VulkanCommandRecorder {
+  public:
+    // Called once per chunk with the secondary buffer to record into and the
+    // [begin, end) range of draws it covers.
+    using RecordFn = std::function<void(VkCommandBuffer cmd, size_t begin, size_t end)>;
+
+  private:
+    struct ThreadContext {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;
+        size_t used = 0;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    uint32_t queueFamily = 0;
+    Yume::JobSystem* jobs = nullptr;
+    // Um por slot do job system, mais um para um thread fora dele
+    std::vector<ThreadContext> contexts;
+
+    // Estado do record() em andamento
+    size_t jobCount = 0;
+    size_t jobChunks = 0;
+    const VkCommandBufferInheritanceInfo* jobInheritance = nullptr;
+    const RecordFn* jobFn = nullptr;
+    std::vector<VkCommandBuffer> jobOutput;
+
+    bool createContexts(size_t count);
+    void recordChunk(size_t chunk);
+    ThreadContext& currentContext();
+    VkCommandBuffer acquire(ThreadContext& ctx);
+
+  public:
+    ~VulkanCommandRecorder();
+
+    bool init(VkDevice device, uint32_t queueFamily);
+    void destroy();
+
+    // Resets every per-thread pool. Only valid once the GPU is done with the
+    // buffers recorded last frame (i.e. after the frame fence has been waited on).
+    // Without a job system everything is recorded on the calling thread.
+    void beginFrame(Yume::JobSystem* jobSystem);
+
+    // Splits [0, count) into chunks of at least minPerChunk draws and records
+    // them concurrently. Returns the secondaries in draw order, ready for
+    // vkCmdExecuteCommands.
+    const std::vector<VkCommandBuffer>& record(size_t count, size_t minPerChunk,
+                                               const VkCommandBufferInheritanceInfo& inheritance,
+                                               const RecordFn& fn);
+
+    size_t getThreadCount() const { return contexts.size(); }
+};
+
+#endif // VULKAN_COMMAND_RECORDER_HPP
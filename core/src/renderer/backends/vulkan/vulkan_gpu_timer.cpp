@@ -0,0 +1,63 @@
+#include "vulkan_gpu_timer.hpp"
+#include "../../../profiler.hpp"
+
+bool VulkanGpuTimer::init(VkPhysicalDevice physicalDevice, VkDevice device) {
+    this->device = device;
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    supported = props.limits.timestampComputeAndGraphics && props.limits.timestampPeriod > 0;
+    if (!supported) return true; // o resto do renderer funciona sem
+
+    periodNs = props.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_SCOPES * 2;
+    return vkCreateQueryPool(device, &poolInfo, nullptr, &pool) == VK_SUCCESS;
+}
+
+void VulkanGpuTimer::destroy() {
+    if (pool) vkDestroyQueryPool(device, pool, nullptr);
+    pool = VK_NULL_HANDLE;
+}
+
+void VulkanGpuTimer::beginFrame(VkCommandBuffer cmd) {
+    if (!pool) return;
+
+    if (count > 0) {
+        uint64_t results[MAX_SCOPES * 2];
+        if (vkGetQueryPoolResults(device, pool, 0, count * 2, sizeof(results), results,
+                                  sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+            uint64_t base = results[0];
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t start = submitNs + (uint64_t)((results[i * 2] - base) * periodNs);
+                uint64_t end = submitNs + (uint64_t)((results[i * 2 + 1] - base) * periodNs);
+                Profiler::record(names[i], start, end, Profiler::Track::GPU);
+            }
+        }
+        count = 0;
+    }
+
+    frameReset = Profiler::isEnabled();
+    if (frameReset) {
+        vkCmdResetQueryPool(cmd, pool, 0, MAX_SCOPES * 2);
+    }
+}
+
+int VulkanGpuTimer::begin(VkCommandBuffer cmd, const char* name) {
+    if (!frameReset || count == MAX_SCOPES) return -1;
+
+    int scope = count++;
+    names[scope] = name;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool, scope * 2);
+    return scope;
+}
+
+void VulkanGpuTimer::end(VkCommandBuffer cmd, int scope) {
+    if (scope < 0) return;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool, scope * 2 + 1);
+}
+
+void VulkanGpuTimer::markSubmit() { submitNs = Profiler::now(); }
@@ -0,0 +1,37 @@
+#ifndef VULKAN_GPU_TIMER_HPP
+#define VULKAN_GPU_TIMER_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+// Escopos de GPU com vkCmdWriteTimestamp. O backend tem um frame em voo, entao
+// os resultados do frame anterior sao lidos logo depois da fence. Sem
+// VK_EXT_calibrated_timestamps, o primeiro timestamp do frame e ancorado no
+// instante do vkQueueSubmit.
+class VulkanGpuTimer {
+  private:
+    static constexpr uint32_t MAX_SCOPES = 16;
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueryPool pool = VK_NULL_HANDLE;
+    double periodNs = 1.0;
+    bool supported = false;
+
+    const char* names[MAX_SCOPES] = {};
+    uint32_t count = 0;
+    bool frameReset = false; // queries so podem ser escritas depois do reset do frame
+    uint64_t submitNs = 0;
+
+  public:
+    bool init(VkPhysicalDevice physicalDevice, VkDevice device);
+    void destroy();
+
+    // Depois da fence: publica os escopos do frame anterior e reseta o pool
+    void beginFrame(VkCommandBuffer cmd);
+    // Retorna -1 quando o profiler esta desligado ou sem suporte
+    int begin(VkCommandBuffer cmd, const char* name);
+    void end(VkCommandBuffer cmd, int scope);
+    void markSubmit();
+};
+
+#endif // VULKAN_GPU_TIMER_HPP
@@ -3,6 +3,7 @@
 #include "renderer/backends/vulkan/vulkan_renderer_backend.hpp"
 #include <cstring>
 #include "log_macros.hpp"
+#include "stats.hpp"
 
 VulkanMeshBuffer::~VulkanMeshBuffer() {
     destroy();
@@ -47,6 +48,7 @@ bool VulkanMeshBuffer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
     if (vkAllocateMemory(backend->getDevice(), &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
         return false;
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
     
     vkBindBufferMemory(backend->getDevice(), buffer, bufferMemory, 0);
     return true;
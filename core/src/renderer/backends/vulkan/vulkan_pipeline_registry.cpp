@@ -0,0 +1,222 @@
+#define CLASS_NAME "VulkanPipelineRegistry"
+#include "../../../log_macros.hpp"
+
+#include "vulkan_pipeline_registry.hpp"
+#include <array>
+
+namespace {
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+void hashBytes(uint64_t& h, const void* data, size_t size) {
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= bytes[i];
+        h *= FNV_PRIME;
+    }
+}
+
+template <typename T> void hashValue(uint64_t& h, const T& value) {
+    hashBytes(h, &value, sizeof(T));
+}
+} // namespace
+
+uint64_t VulkanPipelineDesc::hashModulePath(const std::string& path) {
+    uint64_t h = FNV_OFFSET;
+    hashBytes(h, path.data(), path.size());
+    return h;
+}
+
+uint64_t VulkanPipelineDesc::hash() const {
+    uint64_t h = FNV_OFFSET;
+
+    for (const auto& s : stages) {
+        hashValue(h, s.stage);
+        hashValue(h, s.moduleId);
+    }
+    for (const auto& b : bindings) {
+        hashValue(h, b.binding);
+        hashValue(h, b.stride);
+        hashValue(h, b.inputRate);
+    }
+    for (const auto& a : attributes) {
+        hashValue(h, a.location);
+        hashValue(h, a.binding);
+        hashValue(h, a.format);
+        hashValue(h, a.offset);
+    }
+
+    hashValue(h, topology);
+    hashValue(h, polygonMode);
+    hashValue(h, cullMode);
+    hashValue(h, frontFace);
+    hashValue(h, blendEnable);
+    hashValue(h, srcBlendFactor);
+    hashValue(h, dstBlendFactor);
+    hashValue(h, depthTestEnable);
+    hashValue(h, depthWriteEnable);
+    hashValue(h, depthCompareOp);
+    hashValue(h, renderPass);
+    return h;
+}
+
+bool VulkanPipelineDesc::operator==(const VulkanPipelineDesc& o) const {
+    if (stages.size() != o.stages.size() || bindings.size() != o.bindings.size() ||
+        attributes.size() != o.attributes.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < stages.size(); i++) {
+        if (stages[i].stage != o.stages[i].stage || stages[i].moduleId != o.stages[i].moduleId)
+            return false;
+    }
+    for (size_t i = 0; i < bindings.size(); i++) {
+        if (bindings[i].binding != o.bindings[i].binding ||
+            bindings[i].stride != o.bindings[i].stride ||
+            bindings[i].inputRate != o.bindings[i].inputRate)
+            return false;
+    }
+    for (size_t i = 0; i < attributes.size(); i++) {
+        if (attributes[i].location != o.attributes[i].location ||
+            attributes[i].binding != o.attributes[i].binding ||
+            attributes[i].format != o.attributes[i].format ||
+            attributes[i].offset != o.attributes[i].offset)
+            return false;
+    }
+
+    return topology == o.topology && polygonMode == o.polygonMode && cullMode == o.cullMode &&
+           frontFace == o.frontFace && blendEnable == o.blendEnable &&
+           srcBlendFactor == o.srcBlendFactor && dstBlendFactor == o.dstBlendFactor &&
+           depthTestEnable == o.depthTestEnable && depthWriteEnable == o.depthWriteEnable &&
+           depthCompareOp == o.depthCompareOp && renderPass == o.renderPass;
+}
+
+void VulkanPipelineRegistry::init(VkDevice device, VkPipelineLayout layout) {
+    this->device = device;
+    this->layout = layout;
+}
+
+void VulkanPipelineRegistry::destroy() {
+    for (auto& pair : pipelines) {
+        vkDestroyPipeline(device, pair.second, nullptr);
+    }
+    pipelines.clear();
+}
+
+VkPipeline VulkanPipelineRegistry::getOrCreate(const VulkanPipelineDesc& desc) {
+    auto it = pipelines.find(desc);
+    if (it != pipelines.end()) {
+        return it->second;
+    }
+
+    VkPipeline pipeline = createPipeline(desc);
+    if (pipeline == VK_NULL_HANDLE) {
+        LOG_ERROR("Failed to create graphics pipeline");
+        return VK_NULL_HANDLE;
+    }
+
+    pipelines.emplace(desc, pipeline);
+    LOG_INFO("Created pipeline %zu (hash %016llx)", pipelines.size(),
+             (unsigned long long)desc.hash());
+    return pipeline;
+}
+
+VkPipeline VulkanPipelineRegistry::createPipeline(const VulkanPipelineDesc& desc) {
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+    for (const auto& s : desc.stages) {
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = static_cast<decltype(stageInfo.stage)>(s.stage);
+        stageInfo.module = s.module;
+        stageInfo.pName = "main";
+        shaderStages.push_back(stageInfo);
+    }
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount = desc.bindings.size();
+    vertexInputInfo.pVertexBindingDescriptions = desc.bindings.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = desc.attributes.size();
+    vertexInputInfo.pVertexAttributeDescriptions = desc.attributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = desc.topology;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    // Viewport e scissor são definidos por frame com vkCmdSetViewport/vkCmdSetScissor
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT,
+                                                   VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = dynamicStates.size();
+    dynamicState.pDynamicStates = dynamicStates.data();
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.depthClampEnable = VK_FALSE;
+    rasterizer.rasterizerDiscardEnable = VK_FALSE;
+    rasterizer.polygonMode = desc.polygonMode;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = desc.cullMode;
+    rasterizer.frontFace = desc.frontFace;
+    rasterizer.depthBiasEnable = VK_FALSE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.sampleShadingEnable = VK_FALSE;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = desc.depthTestEnable;
+    depthStencil.depthWriteEnable = desc.depthWriteEnable;
+    depthStencil.depthCompareOp = desc.depthCompareOp;
+    depthStencil.depthBoundsTestEnable = VK_FALSE;
+    depthStencil.stencilTestEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                          VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = desc.blendEnable;
+    colorBlendAttachment.srcColorBlendFactor = desc.srcBlendFactor;
+    colorBlendAttachment.dstColorBlendFactor = desc.dstBlendFactor;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.logicOpEnable = VK_FALSE;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = shaderStages.size();
+    pipelineInfo.pStages = shaderStages.data();
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = layout;
+    pipelineInfo.renderPass = desc.renderPass;
+    pipelineInfo.subpass = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) !=
+        VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return pipeline;
+}
@@ -0,0 +1,71 @@
+#ifndef VULKAN_PIPELINE_REGISTRY_HPP
+#define VULKAN_PIPELINE_REGISTRY_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct VulkanPipelineStage {
+    VkShaderStageFlags stage = VK_SHADER_STAGE_VERTEX_BIT;
+    VkShaderModule module = VK_NULL_HANDLE;
+    // Identifies the module contents; modules are created per ShaderAsset, so two
+    // materials using the same shader file get different handles but the same id.
+    uint64_t moduleId = 0;
+};
+
+// Everything that ends up baked into a VkPipeline. Viewport and scissor are
+// dynamic state and the pipeline layout is shared, so neither is part of the key.
+struct VulkanPipelineDesc {
+    std::vector<VulkanPipelineStage> stages;
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+    VkBool32 blendEnable = VK_FALSE;
+    VkBlendFactor srcBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    VkBlendFactor dstBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+
+    VkBool32 depthTestEnable = VK_TRUE;
+    VkBool32 depthWriteEnable = VK_TRUE;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+
+    uint64_t hash() const;
+    bool operator==(const VulkanPipelineDesc& other) const;
+
+    static uint64_t hashModulePath(const std::string& path);
+};
+
+struct VulkanPipelineDescHash {
+    size_t operator()(const VulkanPipelineDesc& desc) const {
+        return static_cast<size_t>(desc.hash());
+    }
+};
+
+class VulkanPipelineRegistry {
+  private:
+    VkDevice device = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    std::unordered_map<VulkanPipelineDesc, VkPipeline, VulkanPipelineDescHash> pipelines;
+
+    VkPipeline createPipeline(const VulkanPipelineDesc& desc);
+
+  public:
+    void init(VkDevice device, VkPipelineLayout layout);
+    void destroy();
+
+    // Returns the pipeline matching desc, compiling it on first request.
+    // Pipelines live until the registry is destroyed.
+    VkPipeline getOrCreate(const VulkanPipelineDesc& desc);
+
+    size_t size() const { return pipelines.size(); }
+};
+
+#endif // VULKAN_PIPELINE_REGISTRY_HPP
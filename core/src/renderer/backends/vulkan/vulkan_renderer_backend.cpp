@@ -9,17 +9,44 @@
 #include "vulkan_renderer_backend.hpp"
 #include "vulkan_shader_program.hpp"
 #include "vulkan_mesh_buffer.hpp"
+#include "../../../baked_texture.hpp"
+#include "../../../image_pipeline.hpp"
+#include "../../../profiler.hpp"
+#include "../../../stats.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <cstdio>
 #include <set>
 #include <array>
 #include <fstream>
 
+namespace {
+struct UniformBufferObject {
+    glm::mat4 model;
+    glm::mat4 view;
+    glm::mat4 projection;
+};
+
+// Abaixo disso nao compensa acordar as worker threads
+constexpr size_t MIN_DRAWS_PER_CHUNK = 256;
+} // namespace
+
+// Mesmos register(bN) do HLSL; ClusterData ainda nao existe no Vulkan
+const std::array<VulkanRendererBackend::UniformSlot, 3> VulkanRendererBackend::UNIFORM_SLOTS = {{
+    {"ModelViewProjection", 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+     VK_SHADER_STAGE_VERTEX_BIT, 4 * sizeof(glm::mat4), false},
+    {"MaterialData", 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+     sizeof(float) * 4, true},
+    {"LightData", 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
+     sizeof(LightBuffer), false},
+}};
+
 GraphicsAPI VulkanRendererBackend::getGraphicsAPI() const {
     return GraphicsAPI::VULKAN;
 }
@@ -46,29 +73,36 @@ VulkanRendererBackend::~VulkanRendererBackend() {
         if (renderFinishedSemaphore) vkDestroySemaphore(device, renderFinishedSemaphore, nullptr);
         if (imageAvailableSemaphore) vkDestroySemaphore(device, imageAvailableSemaphore, nullptr);
         
+        for (auto& texture : textures) {
+            if (texture.view) vkDestroyImageView(device, texture.view, nullptr);
+            if (texture.image) vkDestroyImage(device, texture.image, nullptr);
+            if (texture.memory) vkFreeMemory(device, texture.memory, nullptr);
+        }
+        for (auto& [key, sampler] : samplers) vkDestroySampler(device, sampler, nullptr);
+
+        commandRecorder.destroy();
+        gpuTimer.destroy();
         if (commandPool) vkDestroyCommandPool(device, commandPool, nullptr);
         
-        for (auto framebuffer : framebuffers) {
-            vkDestroyFramebuffer(device, framebuffer, nullptr);
+        destroySwapchainResources();
+        if (offscreenImage) vkDestroyImage(device, offscreenImage, nullptr);
+        if (offscreenImageMemory) vkFreeMemory(device, offscreenImageMemory, nullptr);
+        for (auto& slot : readbackSlots) {
+            destroyReadbackBuffer(slot);
         }
-        
+        releaseRetiredUniforms(true);
         if (renderPass) vkDestroyRenderPass(device, renderPass, nullptr);
         
-        for (auto imageView : swapchainImageViews) {
-            vkDestroyImageView(device, imageView, nullptr);
-        }
-        
-        if (depthImageView) vkDestroyImageView(device, depthImageView, nullptr);
-        if (depthImage) vkDestroyImage(device, depthImage, nullptr);
-        if (depthImageMemory) vkFreeMemory(device, depthImageMemory, nullptr);
-        
-        if (uniformBuffer) vkDestroyBuffer(device, uniformBuffer, nullptr);
-        if (uniformBufferMemory) vkFreeMemory(device, uniformBufferMemory, nullptr);
+        destroyUniformBuffer();
         if (materialBuffer) vkDestroyBuffer(device, materialBuffer, nullptr);
         if (materialBufferMemory) vkFreeMemory(device, materialBufferMemory, nullptr);
+        if (lightDataMapped) vkUnmapMemory(device, lightDataBufferMemory);
         if (lightDataBuffer) vkDestroyBuffer(device, lightDataBuffer, nullptr);
         if (lightDataBufferMemory) vkFreeMemory(device, lightDataBufferMemory, nullptr);
         
+        pipelineRegistry.destroy();
+        if (pipelineLayout) vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+
         if (descriptorPool) vkDestroyDescriptorPool(device, descriptorPool, nullptr);
         if (descriptorSetLayout) vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
         
@@ -85,9 +119,36 @@ unsigned int VulkanRendererBackend::getRequiredWindowFlags() const {
 };
 
 bool VulkanRendererBackend::init(SDL_Window* window) {
-    return true;
+    if (!window) {
+        LOG_ERROR("Window is null!");
+        return false;
+    }
+    setWindow(window);
+
+    if (!initWindowContext()) {
+        LOG_ERROR("Failed to create Vulkan instance!");
+        return false;
+    }
+
+    if (!SDL_Vulkan_CreateSurface(window, instance, &surface)) {
+        LOG_ERROR("Failed to create Vulkan surface: %s", SDL_GetError());
+        return false;
+    }
+
+    return init();
 };
 
+bool VulkanRendererBackend::initHeadless(int width, int height) {
+    headless = true;
+    swapchainExtent = {(uint32_t)width, (uint32_t)height};
+
+    if (!createInstance()) {
+        LOG_ERROR("Failed to create Vulkan instance!");
+        return false;
+    }
+    return init();
+}
+
 bool VulkanRendererBackend::initWindowContext() {
     printf("[Vulkan] initWindowContext - creating instance\n");
     return createInstance();
@@ -97,19 +158,36 @@ bool VulkanRendererBackend::init() {
     printf("[Vulkan] init - starting full initialization\n");
     if (!pickPhysicalDevice()) { printf("Failed to pick physical device\n"); return false; }
     if (!createLogicalDevice()) { printf("Failed to create logical device\n"); return false; }
-    if (!createSwapchain()) { printf("Failed to create swapchain\n"); return false; }
+    if (headless) {
+        if (!createOffscreenTarget()) {
+            LOG_ERROR("Failed to create offscreen target");
+            return false;
+        }
+    } else if (!createSwapchain()) { printf("Failed to create swapchain\n"); return false; }
     if (!createImageViews()) { printf("Failed to create image views\n"); return false; }
     if (!createRenderPass()) { printf("Failed to create render pass\n"); return false; }
     if (!createDepthResources()) { printf("Failed to create depth resources\n"); return false; }
     if (!createFramebuffers()) { printf("Failed to create framebuffers\n"); return false; }
     if (!createCommandPool()) { printf("Failed to create command pool\n"); return false; }
     if (!createDescriptorSetLayout()) { printf("Failed to create descriptor set layout\n"); return false; }
-    if (!createUniformBuffer()) { printf("Failed to create uniform buffer\n"); return false; }
+    if (!createPipelineLayout()) {
+        LOG_ERROR("Failed to create pipeline layout");
+        return false;
+    }
+    if (!createUniformBuffer(1)) { printf("Failed to create uniform buffer\n"); return false; }
     if (!createMaterialBuffer()) { printf("Failed to create material buffer\n"); return false; }
     if (!createLightDataBuffer()) { printf("Failed to create light data buffer\n"); return false; }
     if (!createDescriptorPool()) { printf("Failed to create descriptor pool\n"); return false; }
     if (!createCommandBuffers()) { printf("Failed to create command buffers\n"); return false; }
     if (!createSyncObjects()) { printf("Failed to create sync objects\n"); return false; }
+    if (!commandRecorder.init(device, graphicsQueueFamily)) {
+        LOG_ERROR("Failed to create command recorder");
+        return false;
+    }
+    if (!gpuTimer.init(physicalDevice, device)) {
+        LOG_ERROR("Failed to create timestamp query pool");
+        return false;
+    }
     
     printf("[Vulkan] Initialization complete!\n");
     return true;
@@ -129,11 +207,14 @@ bool VulkanRendererBackend::createInstance() {
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     createInfo.pApplicationInfo = &appInfo;
     
-    // SDL extensions
+    // SDL extensions; headless nao precisa de nenhuma extensao de superficie
     unsigned int extensionCount = 0;
-    SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, nullptr);
-    std::vector<const char*> extensions(extensionCount);
-    SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, extensions.data());
+    std::vector<const char*> extensions;
+    if (!headless) {
+        SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, nullptr);
+        extensions.resize(extensionCount);
+        SDL_Vulkan_GetInstanceExtensions(nullptr, &extensionCount, extensions.data());
+    }
     
     printf("[Vulkan] Required extensions: %u\n", extensionCount);
     
@@ -157,7 +238,29 @@ bool VulkanRendererBackend::pickPhysicalDevice() {
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
     
-    physicalDevice = devices[0]; // Simplificado: pega o primeiro
+    // Prefere GPU dedicada; sem GPU sobra o rasterizador em CPU (lavapipe)
+    auto score = [](VkPhysicalDeviceType type) {
+        switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return 4;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 3;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return 2;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return 1;
+        default: return 0;
+        }
+    };
+
+    int bestScore = -1;
+    VkPhysicalDeviceProperties props;
+    for (auto candidate : devices) {
+        vkGetPhysicalDeviceProperties(candidate, &props);
+        if (score(props.deviceType) > bestScore) {
+            bestScore = score(props.deviceType);
+            physicalDevice = candidate;
+        }
+    }
+
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    LOG_INFO("Using physical device: %s", props.deviceName);
     return true;
 }
 
@@ -166,7 +269,7 @@ bool VulkanRendererBackend::createLogicalDevice() {
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
     
-    LOG_INFO("Queue family count: " + std::to_string(queueFamilyCount));
+    LOG_INFO("Queue family count: %u", queueFamilyCount);
 
     std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
@@ -177,7 +280,7 @@ bool VulkanRendererBackend::createLogicalDevice() {
             graphicsQueueFamily = i;
             presentQueueFamily = i; 
             foundGraphicsQueue = true;
-            LOG_INFO("Found graphics queue family at index: " + std::to_string(i));
+            LOG_INFO("Found graphics queue family at index: %u", i);
             break;
         }
     }
@@ -194,7 +297,16 @@ bool VulkanRendererBackend::createLogicalDevice() {
     queueCreateInfo.queueCount = 1;
     queueCreateInfo.pQueuePriorities = &queuePriority;
     
+    // Liga so o que o dispositivo tem; loadTexture/getSampler consultam enabledFeatures
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
     VkPhysicalDeviceFeatures deviceFeatures{};
+    deviceFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
+    deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    maxSamplerAnisotropy = props.limits.maxSamplerAnisotropy;
     
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -203,26 +315,47 @@ bool VulkanRendererBackend::createLogicalDevice() {
     createInfo.pEnabledFeatures = &deviceFeatures;
     
     const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
-    createInfo.enabledExtensionCount = 1;
+    createInfo.enabledExtensionCount = headless ? 0 : 1;
     createInfo.ppEnabledExtensionNames = deviceExtensions;
     
     VkResult result = vkCreateDevice(physicalDevice, &createInfo, nullptr, &device);
     if (result != VK_SUCCESS) {
-        LOG_ERROR("Failed to create logical device! Error code: " + std::to_string(result));
+        LOG_ERROR("Failed to create logical device! Error code: %d", result);
         return false;
     }
 
-    std::ostringstream oss;
-    oss << "[Vulkan] Logical device created successfully, handle: " << device;
-    LOG_INFO(oss.str());
+    LOG_INFO("[Vulkan] Logical device created successfully, handle: %p", (void*)device);
     
+    enabledFeatures = deviceFeatures;
     vkGetDeviceQueue(device, graphicsQueueFamily, 0, &graphicsQueue);
     vkGetDeviceQueue(device, presentQueueFamily, 0, &presentQueue);
     
     return true;
 }
 
-bool VulkanRendererBackend::createSwapchain() {
+VkPresentModeKHR VulkanRendererBackend::choosePresentMode() {
+    VkPresentModeKHR wanted = VK_PRESENT_MODE_FIFO_KHR;
+    switch (presentMode) {
+    case PresentMode::FIFO_RELAXED: wanted = VK_PRESENT_MODE_FIFO_RELAXED_KHR; break;
+    case PresentMode::MAILBOX: wanted = VK_PRESENT_MODE_MAILBOX_KHR; break;
+    case PresentMode::IMMEDIATE: wanted = VK_PRESENT_MODE_IMMEDIATE_KHR; break;
+    case PresentMode::FIFO: break;
+    }
+
+    uint32_t modeCount = 0;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, nullptr);
+    std::vector<VkPresentModeKHR> modes(modeCount);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, modes.data());
+
+    for (auto mode : modes) {
+        if (mode == wanted) return mode;
+    }
+
+    LOG_WARN("Present mode %d not supported, using FIFO", wanted);
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+bool VulkanRendererBackend::createSwapchain(VkSwapchainKHR oldSwapchain) {
     VkSurfaceCapabilitiesKHR capabilities;
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities);
     
@@ -238,11 +371,30 @@ bool VulkanRendererBackend::createSwapchain() {
             break;
         }
     }
+    // Recriando: o render pass e os pipelines foram feitos para o formato atual
+    if (oldSwapchain != VK_NULL_HANDLE) {
+        for (const auto& format : formats) {
+            if (format.format == swapchainFormat) {
+                surfaceFormat = format;
+                break;
+            }
+        }
+    }
     
     swapchainFormat = surfaceFormat.format;
     swapchainExtent = capabilities.currentExtent;
+    if (swapchainExtent.width == UINT32_MAX) {
+        // Superficie sem tamanho definido (Wayland): usa o drawable da janela
+        int w = 0, h = 0;
+        SDL_Vulkan_GetDrawableSize(window, &w, &h);
+        swapchainExtent.width = std::clamp((uint32_t)w, capabilities.minImageExtent.width,
+                                           capabilities.maxImageExtent.width);
+        swapchainExtent.height = std::clamp((uint32_t)h, capabilities.minImageExtent.height,
+                                            capabilities.maxImageExtent.height);
+    }
     
-    uint32_t imageCount = capabilities.minImageCount + 1;
+    uint32_t imageCount = swapchainImageCount > 0 ? swapchainImageCount : capabilities.minImageCount + 1;
+    imageCount = std::max(imageCount, capabilities.minImageCount);
     if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
         imageCount = capabilities.maxImageCount;
     }
@@ -256,11 +408,19 @@ bool VulkanRendererBackend::createSwapchain() {
     createInfo.imageExtent = swapchainExtent;
     createInfo.imageArrayLayers = 1;
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    bool transferSource = capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    if (transferSource) {
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; // readback
+    } else if (readbackSupported) {
+        LOG_ERROR("Surface does not support TRANSFER_SRC swapchain images, readback disabled");
+    }
+    readbackSupported = transferSource;
     createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     createInfo.preTransform = capabilities.currentTransform;
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    createInfo.presentMode = choosePresentMode();
     createInfo.clipped = VK_TRUE;
+    createInfo.oldSwapchain = oldSwapchain;
     
     if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapchain) != VK_SUCCESS) {
         return false;
@@ -273,6 +433,109 @@ bool VulkanRendererBackend::createSwapchain() {
     return true;
 }
 
+bool VulkanRendererBackend::createOffscreenTarget() {
+    swapchainFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = swapchainExtent.width;
+    imageInfo.extent.height = swapchainExtent.height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = swapchainFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateImage(device, &imageInfo, nullptr, &offscreenImage) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(device, offscreenImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &offscreenImageMemory) != VK_SUCCESS) {
+        return false;
+    }
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    vkBindImageMemory(device, offscreenImage, offscreenImageMemory, 0);
+
+    swapchainImages = {offscreenImage};
+    return true;
+}
+
+void VulkanRendererBackend::destroySwapchainResources() {
+    for (auto framebuffer : framebuffers) {
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
+    }
+    framebuffers.clear();
+
+    if (depthImageView) vkDestroyImageView(device, depthImageView, nullptr);
+    if (depthImage) vkDestroyImage(device, depthImage, nullptr);
+    if (depthImageMemory) vkFreeMemory(device, depthImageMemory, nullptr);
+    depthImageView = VK_NULL_HANDLE;
+    depthImage = VK_NULL_HANDLE;
+    depthImageMemory = VK_NULL_HANDLE;
+
+    for (auto imageView : swapchainImageViews) {
+        vkDestroyImageView(device, imageView, nullptr);
+    }
+    swapchainImageViews.clear();
+}
+
+// Render pass, pipelines e descriptors continuam validos: viewport/scissor sao
+// dinamicos, so o que depende do tamanho das imagens e recriado. O formato tem
+// que continuar o mesmo; se a superficie nao o oferece mais, falha.
+bool VulkanRendererBackend::recreateSwapchain() {
+    int w = 0, h = 0;
+    SDL_Vulkan_GetDrawableSize(window, &w, &h);
+    if (w == 0 || h == 0) {
+        return false; // minimizada, tenta de novo no proximo frame
+    }
+
+    vkDeviceWaitIdle(device);
+    destroySwapchainResources();
+
+    VkSwapchainKHR oldSwapchain = swapchain;
+    VkFormat oldFormat = swapchainFormat;
+    swapchain = VK_NULL_HANDLE;
+    bool ok = createSwapchain(oldSwapchain);
+    vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+
+    if (ok && swapchainFormat != oldFormat) {
+        LOG_ERROR("Surface format changed from %d to %d, render pass and pipelines no longer "
+                  "match the swapchain", oldFormat, swapchainFormat);
+        swapchainFormat = oldFormat; // a proxima tentativa continua comparando com o original
+        return false;
+    }
+
+    if (!ok || !createImageViews() || !createDepthResources() || !createFramebuffers()) {
+        LOG_ERROR("Failed to recreate swapchain");
+        return false;
+    }
+
+    if (commandBuffers.size() != framebuffers.size()) {
+        vkFreeCommandBuffers(device, commandPool, commandBuffers.size(), commandBuffers.data());
+        if (!createCommandBuffers()) {
+            LOG_ERROR("Failed to reallocate command buffers");
+            return false;
+        }
+    }
+
+    swapchainDirty = false;
+    LOG_INFO("Swapchain recreated: %ux%u", swapchainExtent.width, swapchainExtent.height);
+    return true;
+}
+
 bool VulkanRendererBackend::createImageViews() {
     swapchainImageViews.resize(swapchainImages.size());
     
@@ -309,7 +572,7 @@ bool VulkanRendererBackend::createRenderPass() {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     
     VkAttachmentDescription depthAttachment{};
     depthAttachment.format = VK_FORMAT_D32_SFLOAT;
@@ -357,31 +620,36 @@ bool VulkanRendererBackend::createRenderPass() {
 }
 
 bool VulkanRendererBackend::createDescriptorSetLayout() {
-    VkDescriptorSetLayoutBinding bindings[3] = {};
-    
-    bindings[0].binding = 0;
-    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    bindings[0].descriptorCount = 1;
-    bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-    
-    bindings[1].binding = 1;
-    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    bindings[1].descriptorCount = 1;
-    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    
-    bindings[2].binding = 2;
-    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    bindings[2].descriptorCount = 1;
-    bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutBinding bindings[UNIFORM_SLOTS.size()] = {};
+    for (size_t i = 0; i < UNIFORM_SLOTS.size(); i++) {
+        bindings[i].binding = UNIFORM_SLOTS[i].binding;
+        bindings[i].descriptorType = UNIFORM_SLOTS[i].type;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = UNIFORM_SLOTS[i].stages;
+    }
     
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = 3;
+    layoutInfo.bindingCount = UNIFORM_SLOTS.size();
     layoutInfo.pBindings = bindings;
     
     return vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) == VK_SUCCESS;
 }
 
+bool VulkanRendererBackend::createPipelineLayout() {
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        return false;
+    }
+
+    pipelineRegistry.init(device, pipelineLayout);
+    return true;
+}
+
 bool VulkanRendererBackend::createFramebuffers() {
     framebuffers.resize(swapchainImageViews.size());
     
@@ -450,6 +718,7 @@ bool VulkanRendererBackend::createDepthResources() {
     if (vkAllocateMemory(device, &allocInfo, nullptr, &depthImageMemory) != VK_SUCCESS) {
         return false;
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
     
     vkBindImageMemory(device, depthImage, depthImageMemory, 0);
     
@@ -467,13 +736,23 @@ bool VulkanRendererBackend::createDepthResources() {
     return vkCreateImageView(device, &viewInfo, nullptr, &depthImageView) == VK_SUCCESS;
 }
 
-bool VulkanRendererBackend::createUniformBuffer() {
+bool VulkanRendererBackend::createUniformBuffer(uint32_t slotCount) {
     if (device == VK_NULL_HANDLE) {
-        LOG_WARN("Device is null in createUniformBuffer\n");
+        LOG_WARN("Device is null in createUniformBuffer");
         return false;
     }
 
-    VkDeviceSize bufferSize = 4 * sizeof(glm::mat4);
+    if (uniformStride == 0) {
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(physicalDevice, &props);
+        VkDeviceSize alignment = props.limits.minUniformBufferOffsetAlignment;
+        uniformStride = 4 * sizeof(glm::mat4);
+        if (alignment > 0) {
+            uniformStride = (uniformStride + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    VkDeviceSize bufferSize = uniformStride * slotCount;
     
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -497,8 +776,58 @@ bool VulkanRendererBackend::createUniformBuffer() {
     if (vkAllocateMemory(device, &allocInfo, nullptr, &uniformBufferMemory) != VK_SUCCESS) {
         return false;
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
     
     vkBindBufferMemory(device, uniformBuffer, uniformBufferMemory, 0);
+
+    // Fica mapeado enquanto o buffer existir; as workers escrevem direto aqui
+    if (vkMapMemory(device, uniformBufferMemory, 0, bufferSize, 0, &uniformBufferMapped) !=
+        VK_SUCCESS) {
+        return false;
+    }
+    uniformCapacity = slotCount;
+    return true;
+}
+
+void VulkanRendererBackend::destroyUniformBuffer() {
+    if (uniformBufferMapped) vkUnmapMemory(device, uniformBufferMemory);
+    if (uniformBuffer) vkDestroyBuffer(device, uniformBuffer, nullptr);
+    if (uniformBufferMemory) vkFreeMemory(device, uniformBufferMemory, nullptr);
+    uniformBufferMapped = nullptr;
+    uniformBuffer = VK_NULL_HANDLE;
+    uniformBufferMemory = VK_NULL_HANDLE;
+    uniformCapacity = 0;
+}
+
+// So pode ser chamado antes de qualquer comando do frame usar os descriptor sets,
+// ja que todos sao reescritos apontando para o buffer novo.
+bool VulkanRendererBackend::ensureUniformCapacity(uint32_t slotCount) {
+    if (slotCount <= uniformCapacity) {
+        return true;
+    }
+
+    destroyUniformBuffer();
+    if (!createUniformBuffer(std::max(slotCount, uniformCapacity * 2))) {
+        LOG_ERROR("Failed to grow uniform buffer to %u slots", slotCount);
+        return false;
+    }
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = uniformBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = UNIFORM_SLOTS[0].range;
+
+    std::vector<VkWriteDescriptorSet> writes(descriptorSets.size());
+    for (size_t i = 0; i < descriptorSets.size(); i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = descriptorSets[i];
+        writes[i].dstBinding = UNIFORM_SLOTS[0].binding;
+        writes[i].dstArrayElement = 0;
+        writes[i].descriptorType = UNIFORM_SLOTS[0].type;
+        writes[i].descriptorCount = 1;
+        writes[i].pBufferInfo = &bufferInfo;
+    }
+    vkUpdateDescriptorSets(device, writes.size(), writes.data(), 0, nullptr);
     return true;
 }
 
@@ -527,13 +856,14 @@ bool VulkanRendererBackend::createMaterialBuffer() {
     if (vkAllocateMemory(device, &allocInfo, nullptr, &materialBufferMemory) != VK_SUCCESS) {
         return false;
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
     
     vkBindBufferMemory(device, materialBuffer, materialBufferMemory, 0);
     return true;
 }
 
 bool VulkanRendererBackend::createLightDataBuffer() {
-    VkDeviceSize bufferSize = sizeof(float) * 3;
+    VkDeviceSize bufferSize = sizeof(LightBuffer);
     
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -557,21 +887,32 @@ bool VulkanRendererBackend::createLightDataBuffer() {
     if (vkAllocateMemory(device, &allocInfo, nullptr, &lightDataBufferMemory) != VK_SUCCESS) {
         return false;
     }
+    Stats::add(Stat::GPU_ALLOCATIONS);
     
     vkBindBufferMemory(device, lightDataBuffer, lightDataBufferMemory, 0);
-    return true;
+
+    // Um frame em voo: depois da fence do clear() da para escrever direto
+    return vkMapMemory(device, lightDataBufferMemory, 0, bufferSize, 0, &lightDataMapped) ==
+           VK_SUCCESS;
 }
 
 bool VulkanRendererBackend::createDescriptorPool() {
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSize.descriptorCount = 3;
+    // O set compartilhado mais um por programa com reflexao
+    const uint32_t setCount = MAX_DESCRIPTOR_SETS + 1;
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    for (const UniformSlot& slot : UNIFORM_SLOTS) {
+        VkDescriptorPoolSize& size = slot.type == poolSizes[0].type ? poolSizes[0] : poolSizes[1];
+        size.descriptorCount += setCount;
+    }
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
+    poolInfo.maxSets = setCount;
     
     if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         return false;
@@ -587,50 +928,124 @@ bool VulkanRendererBackend::createDescriptorPool() {
     if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
         return false;
     }
-    
-    VkDescriptorBufferInfo bufferInfos[3] = {};
-    bufferInfos[0].buffer = uniformBuffer;
-    bufferInfos[0].offset = 0;
-    bufferInfos[0].range = 4 * sizeof(glm::mat4);
-    
-    bufferInfos[1].buffer = materialBuffer;
-    bufferInfos[1].offset = 0;
-    bufferInfos[1].range = sizeof(float) * 4;
-    
-    bufferInfos[2].buffer = lightDataBuffer;
-    bufferInfos[2].offset = 0;
-    bufferInfos[2].range = sizeof(float) * 3;
-    
-    VkWriteDescriptorSet descriptorWrites[3] = {};
-    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptorWrites[0].dstSet = descriptorSets[0];
-    descriptorWrites[0].dstBinding = 0;
-    descriptorWrites[0].dstArrayElement = 0;
-    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    descriptorWrites[0].descriptorCount = 1;
-    descriptorWrites[0].pBufferInfo = &bufferInfos[0];
-    
-    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptorWrites[1].dstSet = descriptorSets[0];
-    descriptorWrites[1].dstBinding = 1;
-    descriptorWrites[1].dstArrayElement = 0;
-    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    descriptorWrites[1].descriptorCount = 1;
-    descriptorWrites[1].pBufferInfo = &bufferInfos[1];
-    
-    descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptorWrites[2].dstSet = descriptorSets[0];
-    descriptorWrites[2].dstBinding = 2;
-    descriptorWrites[2].dstArrayElement = 0;
-    descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    descriptorWrites[2].descriptorCount = 1;
-    descriptorWrites[2].pBufferInfo = &bufferInfos[2];
-    
-    vkUpdateDescriptorSets(device, 3, descriptorWrites, 0, nullptr);
-    
+
+    // Programas sem reflexao dividem o buffer de material global
+    writeDescriptorSet(descriptorSets[0], materialBuffer, UNIFORM_SLOTS[1].range);
     return true;
 }
 
+void VulkanRendererBackend::writeDescriptorSet(VkDescriptorSet set, VkBuffer programBuffer,
+                                               VkDeviceSize programRange) {
+    VkDescriptorBufferInfo bufferInfos[UNIFORM_SLOTS.size()] = {};
+    VkWriteDescriptorSet descriptorWrites[UNIFORM_SLOTS.size()] = {};
+    for (size_t i = 0; i < UNIFORM_SLOTS.size(); i++) {
+        const UniformSlot& slot = UNIFORM_SLOTS[i];
+        if (slot.perProgram) {
+            bufferInfos[i].buffer = programBuffer;
+            bufferInfos[i].range = programRange;
+        } else {
+            // Os dois buffers do backend: matrizes (dinamico) e luzes
+            bufferInfos[i].buffer = slot.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+                                        ? uniformBuffer
+                                        : lightDataBuffer;
+            bufferInfos[i].range = slot.range;
+        }
+        bufferInfos[i].offset = 0;
+
+        descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].dstSet = set;
+        descriptorWrites[i].dstBinding = slot.binding;
+        descriptorWrites[i].dstArrayElement = 0;
+        descriptorWrites[i].descriptorType = slot.type;
+        descriptorWrites[i].descriptorCount = 1;
+        descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+    }
+    vkUpdateDescriptorSets(device, UNIFORM_SLOTS.size(), descriptorWrites, 0, nullptr);
+}
+
+bool VulkanRendererBackend::createProgramUniforms(VkDeviceSize size,
+                                                  VulkanProgramUniforms& uniforms) {
+    if (descriptorSets.size() + retiredUniforms.size() > MAX_DESCRIPTOR_SETS) {
+        LOG_WARN("Descriptor pool full (%u program sets)", MAX_DESCRIPTOR_SETS);
+        return false;
+    }
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &uniforms.buffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, uniforms.buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &uniforms.memory) != VK_SUCCESS) {
+        freeProgramUniforms(uniforms); // nunca chegou a GPU
+        return false;
+    }
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    vkBindBufferMemory(device, uniforms.buffer, uniforms.memory, 0);
+
+    VkDescriptorSetAllocateInfo setInfo{};
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setInfo.descriptorPool = descriptorPool;
+    setInfo.descriptorSetCount = 1;
+    setInfo.pSetLayouts = &descriptorSetLayout;
+
+    if (vkMapMemory(device, uniforms.memory, 0, size, 0, &uniforms.mapped) != VK_SUCCESS ||
+        vkAllocateDescriptorSets(device, &setInfo, &uniforms.set) != VK_SUCCESS) {
+        freeProgramUniforms(uniforms); // nunca chegou a GPU
+        return false;
+    }
+    uniforms.size = size;
+
+    writeDescriptorSet(uniforms.set, uniforms.buffer, size);
+    descriptorSets.push_back(uniforms.set);
+    return true;
+}
+
+void VulkanRendererBackend::destroyProgramUniforms(VulkanProgramUniforms& uniforms) {
+    if (!uniforms.set && !uniforms.buffer && !uniforms.memory) return;
+
+    // Sai da lista ja (ensureUniformCapacity nao reescreve mais o set), mas o
+    // frame em voo e o que esta sendo gravado ainda podem ler set e buffer
+    if (uniforms.set) {
+        descriptorSets.erase(std::remove(descriptorSets.begin() + 1, descriptorSets.end(),
+                                         uniforms.set),
+                             descriptorSets.end());
+    }
+    retiredUniforms.push_back({uniforms, submitCount + 1});
+    uniforms = VulkanProgramUniforms();
+}
+
+void VulkanRendererBackend::freeProgramUniforms(VulkanProgramUniforms& uniforms) {
+    if (uniforms.set) vkFreeDescriptorSets(device, descriptorPool, 1, &uniforms.set);
+    if (uniforms.mapped) vkUnmapMemory(device, uniforms.memory);
+    if (uniforms.buffer) vkDestroyBuffer(device, uniforms.buffer, nullptr);
+    if (uniforms.memory) vkFreeMemory(device, uniforms.memory, nullptr);
+    uniforms = VulkanProgramUniforms();
+}
+
+void VulkanRendererBackend::releaseRetiredUniforms(bool all) {
+    auto done = std::remove_if(retiredUniforms.begin(), retiredUniforms.end(),
+                               [&](RetiredUniforms& retired) {
+                                   if (!all && retired.frame > completedCount) return false;
+                                   freeProgramUniforms(retired.uniforms);
+                                   return true;
+                               });
+    retiredUniforms.erase(done, retiredUniforms.end());
+}
+
 bool VulkanRendererBackend::createCommandBuffers() {
     commandBuffers.resize(framebuffers.size());
     
@@ -672,26 +1087,81 @@ void VulkanRendererBackend::onCameraSet() {
     // Atualizar clear color se necessário
 }
 
+void VulkanRendererBackend::bindCamera(Camera* camera) {
+    if (!camera) {
+        LOG_ERROR("Camera is null");
+        return;
+    }
+
+    auto& camPos = camera->getPosition();
+    auto& camTarget = camera->getTarget();
+    viewMatrix = glm::lookAt({camPos.x, camPos.y, camPos.z}, {camTarget.x, camTarget.y, camTarget.z},
+                             glm::vec3(0.0f, 1.0f, 0.0f));
+
+    if (camera->isOrthographic()) {
+        float orthoSize = camera->getOrthoSize();
+        float aspect = camera->getAspectRatio();
+        projectionMatrix = glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize,
+                                      orthoSize, camera->getNearDistance(), camera->getFarDistance());
+    } else {
+        projectionMatrix = glm::perspective(glm::radians(camera->getFov()), camera->getAspectRatio(),
+                                            camera->getNearDistance(), camera->getFarDistance());
+    }
+    // fix temporario pra deixar eixo y igual opengl
+    projectionMatrix[1][1] *= -1;
+}
+
 void VulkanRendererBackend::clear(Camera* camera) {
-    vkWaitForFences(device, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
+    {
+        PROFILE_SCOPE("WaitForFence");
+        vkWaitForFences(device, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
+    }
+    completedCount = submitCount; // um frame em voo: a fence cobre tudo que foi submetido
+    if (!retiredUniforms.empty()) releaseRetiredUniforms(false);
+
+    if (headless) {
+        currentImageIndex = 0;
+        frameSkipped = false;
+    } else {
+        int w = 0, h = 0;
+        SDL_Vulkan_GetDrawableSize(window, &w, &h);
+        if ((uint32_t)w != swapchainExtent.width || (uint32_t)h != swapchainExtent.height) {
+            swapchainDirty = true;
+        }
+
+        frameSkipped = swapchainDirty && !recreateSwapchain();
+        if (frameSkipped) return;
+
+        VkResult result = vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphore,
+                                                VK_NULL_HANDLE, &currentImageIndex);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            // Nada foi submetido, a fence continua sinalizada para o proximo frame
+            recreateSwapchain();
+            frameSkipped = true;
+            return;
+        }
+        if (result == VK_SUBOPTIMAL_KHR) {
+            swapchainDirty = true; // a imagem ainda pode ser apresentada
+        } else if (result != VK_SUCCESS) {
+            LOG_ERROR("Failed to acquire swapchain image: %d", result);
+            frameSkipped = true;
+            return;
+        }
+    }
+
     vkResetFences(device, 1, &inFlightFence);
     
-    vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &currentImageIndex);
-    
     vkResetCommandBuffer(commandBuffers[currentImageIndex], 0);
+    // A GPU terminou o frame anterior, as secundarias dele podem ser recicladas
+    commandRecorder.beginFrame(jobSystem);
     
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     vkBeginCommandBuffer(commandBuffers[currentImageIndex], &beginInfo);
+
+    gpuTimer.beginFrame(commandBuffers[currentImageIndex]);
+    gpuFrameScope = gpuTimer.begin(commandBuffers[currentImageIndex], "GPU Frame");
     
-    VkRenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = renderPass;
-    renderPassInfo.framebuffer = framebuffers[currentImageIndex];
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = swapchainExtent;
-    
-    std::array<VkClearValue, 2> clearValues{};
     if (mainCamera) {
         auto& bgColor = mainCamera->getBackgroundColor();
         clearValues[0].color = {{bgColor.r, bgColor.g, bgColor.b, bgColor.a}};
@@ -699,35 +1169,199 @@ void VulkanRendererBackend::clear(Camera* camera) {
         clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
     }
     clearValues[1].depthStencil = {1.0f, 0};
-    
+
+    // O render pass so comeca quando se sabe se o conteudo vem inline ou de
+    // command buffers secundarios (ver submitQueue)
+    renderPassActive = false;
+}
+
+void VulkanRendererBackend::beginRenderPass(VkSubpassContents contents) {
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = renderPass;
+    renderPassInfo.framebuffer = framebuffers[currentImageIndex];
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = swapchainExtent;
     renderPassInfo.clearValueCount = clearValues.size();
     renderPassInfo.pClearValues = clearValues.data();
     
-    vkCmdBeginRenderPass(commandBuffers[currentImageIndex], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffers[currentImageIndex], &renderPassInfo, contents);
+    renderPassActive = true;
+    renderPassContents = contents;
+
+    if (contents == VK_SUBPASS_CONTENTS_INLINE) {
+        setViewportAndScissor(commandBuffers[currentImageIndex]);
+    }
+}
+
+void VulkanRendererBackend::setViewportAndScissor(VkCommandBuffer cmd) {
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)swapchainExtent.width;
+    viewport.height = (float)swapchainExtent.height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = swapchainExtent;
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+}
+
+// Chamado em paralelo pelas workers; so le o render queue e escreve nos slots
+// [begin + 1, end + 1) do UBO, entao chunks diferentes nunca se sobrepoem.
+void VulkanRendererBackend::recordDraws(VkCommandBuffer cmd, size_t begin, size_t end) {
+    PROFILE_SCOPE("RecordChunk");
+    setViewportAndScissor(cmd);
+
+    auto* base = static_cast<uint8_t*>(uniformBufferMapped);
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    // Acumulado localmente: varias workers gravam ao mesmo tempo
+    int64_t draws = 0, triangles = 0, pipelineBinds = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        const DrawItem& item = (*activeQueue)[i];
+        if (!item.mesh) continue; // sprites ainda nao sao suportados no Vulkan
+
+        auto* program = item.material->getShaderProgram();
+        if (!program || !program->isValid()) continue;
+
+        VkPipeline pipeline = static_cast<VkPipeline>(program->getHandle());
+        if (pipeline != boundPipeline) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            boundPipeline = pipeline;
+            pipelineBinds++;
+        }
+
+        uint32_t offset = static_cast<uint32_t>((i + 1) * uniformStride);
+        auto* ubo = reinterpret_cast<UniformBufferObject*>(base + offset);
+        ubo->model = item.model;
+        ubo->view = viewMatrix;
+        ubo->projection = projectionMatrix;
+
+        VkDescriptorSet set = static_cast<VulkanShaderProgram*>(program)->getDescriptorSet();
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &set,
+                                1, &offset);
+
+        auto* vkMeshBuffer = static_cast<VulkanMeshBuffer*>(item.mesh->getMeshBuffer());
+        VkBuffer vertexBuffers[] = {vkMeshBuffer->getVertexBuffer(),
+                                    vkMeshBuffer->getNormalBuffer()};
+        VkDeviceSize offsets[] = {0, 0};
+        vkCmdBindVertexBuffers(cmd, 0, 2, vertexBuffers, offsets);
+        uint32_t vertexCount = item.mesh->getVertices().size() / 3;
+        vkCmdDraw(cmd, vertexCount, 1, 0, 0);
+        draws++;
+        triangles += vertexCount / 3;
+    }
+
+    Stats::add(Stat::DRAW_CALLS, draws);
+    Stats::add(Stat::TRIANGLES, triangles);
+    Stats::add(Stat::PROGRAM_BINDS, pipelineBinds);
+    Stats::add(Stat::UBO_UPLOADS, draws);
+    Stats::add(Stat::UBO_BYTES, draws * sizeof(UniformBufferObject));
+}
+
+void VulkanRendererBackend::renderGameObjects(std::vector<GameObject*>* gameObjects,
+                                              std::vector<Light>* lights) {
+    if (!gameObjects) return;
+
+    // Caminho antigo, sem FramePacket: as luzes sobem aqui mesmo
+    if (lights) {
+        LightBuffer lightBuffer;
+        lightBuffer.pack(*lights);
+        submitLights(lightBuffer);
+    }
+
+    {
+        PROFILE_SCOPE("BuildRenderQueue");
+        renderQueue.build(*gameObjects);
+    }
+    submitQueue(renderQueue, lights);
+}
+
+void VulkanRendererBackend::submitLights(const LightBuffer& lights) {
+    if (!lightDataMapped) return;
+    memcpy(lightDataMapped, &lights, lights.getUsedBytes());
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, lights.getUsedBytes());
+}
+
+void VulkanRendererBackend::submitQueue(const RenderQueue& queue, std::vector<Light>* lights) {
+    if (frameSkipped || !mainCamera) return;
+
+    if (renderPassActive) {
+        // Os slots do UBO sao do frame inteiro; um segundo queue no mesmo frame os sobrescreveria
+        LOG_WARN("submitQueue called after the render pass started, skipping");
+        return;
+    }
+
+    if (queue.empty() || !ensureUniformCapacity(queue.size() + 1)) {
+        beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+        return;
+    }
+
+    PROFILE_SCOPE("RecordDraws");
+    VkCommandBuffer primary = commandBuffers[currentImageIndex];
+    activeQueue = &queue;
+
+    if (queue.size() < 2 * MIN_DRAWS_PER_CHUNK) {
+        beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+        recordDraws(primary, 0, queue.size());
+        return;
+    }
+
+    beginRenderPass(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = renderPass;
+    inheritance.subpass = 0;
+    inheritance.framebuffer = framebuffers[currentImageIndex];
+
+    const auto& secondaries = commandRecorder.record(
+        queue.size(), MIN_DRAWS_PER_CHUNK, inheritance,
+        [this](VkCommandBuffer cmd, size_t begin, size_t end) { recordDraws(cmd, begin, end); });
+
+    vkCmdExecuteCommands(primary, secondaries.size(), secondaries.data());
 }
 
 void VulkanRendererBackend::draw(const Mesh& mesh) {
+    if (frameSkipped) return;
+    if (!renderPassActive) beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+    if (renderPassContents != VK_SUBPASS_CONTENTS_INLINE) return;
+
     auto* vkMeshBuffer = static_cast<VulkanMeshBuffer*>(mesh.getMeshBuffer());
     VkBuffer vertexBuffers[] = {vkMeshBuffer->getVertexBuffer(), vkMeshBuffer->getNormalBuffer()};
     VkDeviceSize offsets[] = {0, 0};
     vkCmdBindVertexBuffers(commandBuffers[currentImageIndex], 0, 2, vertexBuffers, offsets);
-    vkCmdDraw(commandBuffers[currentImageIndex], mesh.getVertices().size() / 3, 1, 0, 0);
+    uint32_t vertexCount = mesh.getVertices().size() / 3;
+    vkCmdDraw(commandBuffers[currentImageIndex], vertexCount, 1, 0, 0);
+
+    Stats::add(Stat::DRAW_CALLS);
+    Stats::add(Stat::TRIANGLES, vertexCount / 3);
 }
 
 void VulkanRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
-    if (!mainCamera) return;
+    if (frameSkipped || !mainCamera) return;
+
+    if (!renderPassActive) beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+    // Comandos inline nao sao permitidos num subpass aberto para secundarias
+    if (renderPassContents != VK_SUBPASS_CONTENTS_INLINE) return;
     
     // Bind pipeline do material atual
     auto* program = static_cast<ShaderProgram*>(shaderProgram);
     if (program && program->isValid()) {
         VkPipeline pipeline = static_cast<VkPipeline>(program->getHandle());
         vkCmdBindPipeline(commandBuffers[currentImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        Stats::add(Stat::PROGRAM_BINDS);
         
-        // Bind descriptor sets usando o pipeline layout do material
-        auto* vkProgram = static_cast<VulkanShaderProgram*>(program);
-        VkPipelineLayout layout = vkProgram->getPipelineLayout();
+        // Slot 0 do UBO dinamico e reservado para este caminho imediato
+        uint32_t dynamicOffset = 0;
+        VkDescriptorSet set = static_cast<VulkanShaderProgram*>(program)->getDescriptorSet();
         vkCmdBindDescriptorSets(commandBuffers[currentImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                               layout, 0, 1, &descriptorSets[0], 0, nullptr);
+                               pipelineLayout, 0, 1, &set, 1, &dynamicOffset);
     }
     
     glm::mat4 model = glm::rotate(glm::mat4(1.0f), 0.0f, glm::vec3(1.0f, 0.0f, 1.0f));
@@ -749,20 +1383,14 @@ void VulkanRendererBackend::setUniforms(ShaderProgram* shaderProgram) {
     // fix temporario pra deixar eixo y igual opengl
     projection[1][1] *= -1;
     
-    struct UniformBufferObject {
-        glm::mat4 model;
-        glm::mat4 view;
-        glm::mat4 projection;
-    } ubo;
-    
+    UniformBufferObject ubo;
     ubo.model = model;
     ubo.view = view;
     ubo.projection = projection;
     
-    void* data;
-    vkMapMemory(device, uniformBufferMemory, 0, sizeof(ubo), 0, &data);
-    memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(device, uniformBufferMemory);
+    memcpy(uniformBufferMapped, &ubo, sizeof(ubo));
+    Stats::add(Stat::UBO_UPLOADS);
+    Stats::add(Stat::UBO_BYTES, sizeof(ubo));
 }
 
 unsigned int VulkanRendererBackend::createCubemapTexture(const std::vector<std::string>& faces) {
@@ -774,7 +1402,20 @@ void VulkanRendererBackend::renderSkybox(const Mesh& mesh, unsigned int shaderPr
 }
 
 void VulkanRendererBackend::present(SDL_Window* window) {
+    if (frameSkipped) return;
+
+    // Frame sem draws: o render pass ainda precisa rodar para limpar e transicionar a imagem
+    if (!renderPassActive) beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
     vkCmdEndRenderPass(commandBuffers[currentImageIndex]);
+    renderPassActive = false;
+
+    gpuTimer.end(commandBuffers[currentImageIndex], gpuFrameScope);
+
+    bool readbackRecorded = false;
+    if (readbackRequested) {
+        readbackRecorded = recordReadbackCopy(commandBuffers[currentImageIndex]);
+        readbackRequested = false;
+    }
     
     if (vkEndCommandBuffer(commandBuffers[currentImageIndex]) != VK_SUCCESS) {
         printf("Failed to record command buffer\n");
@@ -786,20 +1427,31 @@ void VulkanRendererBackend::present(SDL_Window* window) {
     
     VkSemaphore waitSemaphores[] = {imageAvailableSemaphore};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = headless ? 0 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffers[currentImageIndex];
     
     VkSemaphore signalSemaphores[] = {renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = headless ? 0 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
     
-    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFence) != VK_SUCCESS) {
-        printf("Failed to submit draw command buffer\n");
-        return;
+    {
+        PROFILE_SCOPE("QueueSubmit");
+        gpuTimer.markSubmit();
+        if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFence) != VK_SUCCESS) {
+            printf("Failed to submit draw command buffer\n");
+            return;
+        }
+    }
+    submitCount++;
+    if (readbackRecorded) {
+        readbackHead = (readbackHead + 1) % readbackSlots.size();
+        readbackPending++;
     }
+
+    if (headless) return;
     
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -811,9 +1463,493 @@ void VulkanRendererBackend::present(SDL_Window* window) {
     presentInfo.pSwapchains = swapchains;
     presentInfo.pImageIndices = &currentImageIndex;
     
-    vkQueuePresentKHR(presentQueue, &presentInfo);
+    PROFILE_SCOPE("QueuePresent");
+    VkResult result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        // Recria no proximo clear(), depois de esperar a fence deste frame
+        swapchainDirty = true;
+    } else if (result != VK_SUCCESS) {
+        LOG_ERROR("Failed to present swapchain image: %d", result);
+    }
+}
+
+VkCommandBuffer VulkanRendererBackend::beginUploadCommands() {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer cmd;
+    vkAllocateCommandBuffers(device, &allocInfo, &cmd);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cmd, &beginInfo);
+    return cmd;
+}
+
+// Uploads acontecem no load da cena, entao esperar a fila aqui e aceitavel
+void VulkanRendererBackend::endUploadCommands(VkCommandBuffer cmd) {
+    vkEndCommandBuffer(cmd);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmd;
+    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueWaitIdle(graphicsQueue);
+
+    vkFreeCommandBuffers(device, commandPool, 1, &cmd);
+}
+
+VkSampler VulkanRendererBackend::getSampler(const SamplerDesc& desc) {
+    auto it = samplers.find(desc.key());
+    if (it != samplers.end()) return it->second;
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter =
+        desc.filter == TextureFilter::NEAREST ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+    samplerInfo.minFilter = samplerInfo.magFilter;
+    samplerInfo.mipmapMode = desc.filter == TextureFilter::TRILINEAR
+                                 ? VK_SAMPLER_MIPMAP_MODE_LINEAR
+                                 : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+    if (desc.maxAnisotropy > 1 && enabledFeatures.samplerAnisotropy) {
+        samplerInfo.anisotropyEnable = VK_TRUE;
+        samplerInfo.maxAnisotropy = std::min((float)desc.maxAnisotropy, maxSamplerAnisotropy);
+    }
+
+    VkSampler sampler = VK_NULL_HANDLE;
+    if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create sampler");
+        return VK_NULL_HANDLE;
+    }
+    samplers.emplace(desc.key(), sampler);
+    return sampler;
 }
 
-unsigned int VulkanRendererBackend::loadTexture(const std::string& path, uint8_t filterType) { return 0; };
+unsigned int VulkanRendererBackend::loadTexture(const std::string& path,
+                                                const SamplerDesc& sampler) {
+    if (!device) return 0;
+
+    // Baked: todos os mips ja vem no arquivo. Senao decodifica e gera os mips com blits
+    BakedTexture baked;
+    bool useBaked = !BakedTexture::isStale(path) && baked.load(bakedTexturePath(path)) &&
+                    (!isBlockCompressed(baked.format) || enabledFeatures.textureCompressionBC);
+
+    std::vector<VkBufferImageCopy> regions;
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    uint32_t width, height, mipLevels;
+    VkDeviceSize dataSize;
+    std::vector<ImagePipeline::DecodeTarget> images;
+
+    if (useBaked) {
+        if (baked.format == TextureFormat::BC1) format = VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        if (baked.format == TextureFormat::BC3) format = VK_FORMAT_BC3_UNORM_BLOCK;
+        width = baked.width;
+        height = baked.height;
+        mipLevels = (uint32_t)baked.mips.size();
+        dataSize = baked.data.size();
+        for (uint32_t level = 0; level < mipLevels; level++) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = baked.mipOffset(level);
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            region.imageExtent = {baked.mips[level].width, baked.mips[level].height, 1};
+            regions.push_back(region);
+        }
+    } else {
+        // So o cabecalho agora; o decode escreve direto no staging mapeado
+        images.resize(1);
+        images[0].path = path;
+        if (!ImagePipeline::probe(path, images[0].info)) {
+            LOG_ERROR("Failed to load texture: %s", path.c_str());
+            return 0;
+        }
+        width = (uint32_t)images[0].info.width;
+        height = (uint32_t)images[0].info.height;
+        dataSize = (VkDeviceSize)width * height * 4;
+
+        VkFormatProperties formatProps;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProps);
+        bool canBlit = formatProps.optimalTilingFeatures &
+                       VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        mipLevels = canBlit ? (uint32_t)std::log2(std::max(width, height)) + 1 : 1;
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {width, height, 1};
+        regions.push_back(region);
+    }
+
+    // Staging
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = dataSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer staging;
+    VkDeviceMemory stagingMemory;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &staging) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create texture staging buffer: %s", path.c_str());
+        return 0;
+    }
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, staging, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &stagingMemory) != VK_SUCCESS) {
+        LOG_ERROR("Failed to allocate texture staging memory: %s", path.c_str());
+        vkDestroyBuffer(device, staging, nullptr);
+        return 0;
+    }
+    vkBindBufferMemory(device, staging, stagingMemory, 0);
+
+    void* mapped;
+    if (vkMapMemory(device, stagingMemory, 0, dataSize, 0, &mapped) != VK_SUCCESS) {
+        LOG_ERROR("Failed to map texture staging memory: %s", path.c_str());
+        vkDestroyBuffer(device, staging, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+        return 0;
+    }
+    bool filled = true;
+    if (useBaked) {
+        memcpy(mapped, baked.data.data(), dataSize);
+    } else {
+        images[0].pixels = static_cast<uint8_t*>(mapped);
+        filled = ImagePipeline::decode(images, ImagePipeline::ConvertOptions(), jobSystem) == 1;
+    }
+    vkUnmapMemory(device, stagingMemory);
+    if (!filled) {
+        LOG_ERROR("Failed to load texture: %s", path.c_str());
+        vkDestroyBuffer(device, staging, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+        return 0;
+    }
+
+    Texture texture;
+    texture.mipLevels = mipLevels;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                      VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateImage(device, &imageInfo, nullptr, &texture.image) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create texture image: %s", path.c_str());
+        vkDestroyBuffer(device, staging, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+        return 0;
+    }
+
+    vkGetImageMemoryRequirements(device, texture.image, &memRequirements);
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex =
+        findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &texture.memory) != VK_SUCCESS) {
+        LOG_ERROR("Failed to allocate texture memory: %s", path.c_str());
+        vkDestroyImage(device, texture.image, nullptr);
+        vkDestroyBuffer(device, staging, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+        return 0;
+    }
+    vkBindImageMemory(device, texture.image, texture.memory, 0);
+    texture.bytes = memRequirements.size;
+    Stats::add(Stat::GPU_ALLOCATIONS);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1};
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    VkCommandBuffer cmd = beginUploadCommands();
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+    vkCmdCopyBufferToImage(cmd, staging, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           (uint32_t)regions.size(), regions.data());
+
+    // Cada mip sai do anterior; o anterior vai para leitura no shader logo em seguida
+    uint32_t firstUnreadLevel = 0;
+    if (!useBaked) {
+        int32_t mipWidth = (int32_t)width, mipHeight = (int32_t)height;
+        for (uint32_t level = 1; level < mipLevels; level++) {
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1, 0, 1};
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                                 &barrier);
+
+            VkImageBlit blit{};
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+            blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
+            mipWidth = std::max(mipWidth / 2, 1);
+            mipHeight = std::max(mipHeight / 2, 1);
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            blit.dstOffsets[1] = {mipWidth, mipHeight, 1};
+            vkCmdBlitImage(cmd, texture.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, texture.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                                 1, &barrier);
+        }
+        firstUnreadLevel = mipLevels - 1;
+    }
+
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, firstUnreadLevel,
+                                mipLevels - firstUnreadLevel, 0, 1};
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                         &barrier);
+    endUploadCommands(cmd);
+
+    vkDestroyBuffer(device, staging, nullptr);
+    vkFreeMemory(device, stagingMemory, nullptr);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = texture.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1};
+    if (vkCreateImageView(device, &viewInfo, nullptr, &texture.view) != VK_SUCCESS) {
+        LOG_ERROR("Failed to create texture view: %s", path.c_str());
+        vkDestroyImage(device, texture.image, nullptr);
+        vkFreeMemory(device, texture.memory, nullptr);
+        return 0;
+    }
+
+    texture.sampler = getSampler(sampler);
+
+    LOG_INFO("Texture loaded: %s (%ux%u, %u mips%s)", path.c_str(), width, height, mipLevels,
+             useBaked ? ", baked" : "");
+    if (!freeTextureSlots.empty()) {
+        uint32_t slot = freeTextureSlots.back();
+        freeTextureSlots.pop_back();
+        textures[slot] = texture;
+        return slot + 1;
+    }
+    textures.push_back(texture);
+    return (unsigned int)textures.size();
+}
+
+void VulkanRendererBackend::deleteTexture(unsigned int textureID) {
+    if (textureID == 0 || textureID > textures.size()) return;
+    Texture& texture = textures[textureID - 1];
+    if (!texture.image) return;
+
+    // Pode estar em um command buffer em voo; despejo e raro, esperar e aceitavel
+    vkDeviceWaitIdle(device);
+    vkDestroyImageView(device, texture.view, nullptr);
+    vkDestroyImage(device, texture.image, nullptr);
+    vkFreeMemory(device, texture.memory, nullptr);
+    texture = Texture();
+    freeTextureSlots.push_back(textureID - 1);
+}
+
+size_t VulkanRendererBackend::getTextureBytes(unsigned int textureID) const {
+    if (textureID == 0 || textureID > textures.size()) return 0;
+    return (size_t)textures[textureID - 1].bytes;
+}
     
 void VulkanRendererBackend::drawSprite(const Sprite& sprite) {};
+
+void VulkanRendererBackend::destroyReadbackBuffer(ReadbackSlot& slot) {
+    if (slot.mapped) vkUnmapMemory(device, slot.memory);
+    if (slot.buffer) vkDestroyBuffer(device, slot.buffer, nullptr);
+    if (slot.memory) vkFreeMemory(device, slot.memory, nullptr);
+    slot = ReadbackSlot{};
+}
+
+bool VulkanRendererBackend::createReadbackBuffer(ReadbackSlot& slot, VkDeviceSize size) {
+    destroyReadbackBuffer(slot);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &slot.buffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, slot.buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &slot.memory) != VK_SUCCESS) {
+        return false;
+    }
+    Stats::add(Stat::GPU_ALLOCATIONS);
+    vkBindBufferMemory(device, slot.buffer, slot.memory, 0);
+
+    if (vkMapMemory(device, slot.memory, 0, size, 0, &slot.mapped) != VK_SUCCESS) {
+        return false;
+    }
+    slot.size = size;
+    return true;
+}
+
+// O slot so entra no ring depois que o submit deste command buffer der certo
+bool VulkanRendererBackend::recordReadbackCopy(VkCommandBuffer cmd) {
+    if (!readbackSupported) return false; // swapchain recriada sem TRANSFER_SRC
+    ReadbackSlot& slot = readbackSlots[readbackHead];
+
+    VkDeviceSize size = (VkDeviceSize)swapchainExtent.width * swapchainExtent.height * 4;
+    if (size != slot.size) {
+        LOG_ERROR("Readback buffer no longer matches the swapchain");
+        return false;
+    }
+
+    VkImage image = swapchainImages[currentImageIndex];
+    VkImageLayout srcLayout =
+        headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkImageMemoryBarrier toTransfer{};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = srcLayout;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = image;
+    toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    toTransfer.subresourceRange.levelCount = 1;
+    toTransfer.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {swapchainExtent.width, swapchainExtent.height, 1};
+    vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer, 1,
+                           &region);
+
+    VkBufferMemoryBarrier toHost{};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot.buffer;
+    toHost.size = size;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0,
+                         nullptr, 1, &toHost, 0, nullptr);
+
+    if (!headless) {
+        VkImageMemoryBarrier toPresent = toTransfer;
+        toPresent.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toPresent.dstAccessMask = 0;
+        toPresent.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                             &toPresent);
+    }
+
+    slot.extent = swapchainExtent;
+    slot.frame = submitCount + 1; // este command buffer sera o proximo submit
+    return true;
+}
+
+bool VulkanRendererBackend::requestReadback() {
+    if (frameSkipped || readbackRequested || !readbackSupported) {
+        return false;
+    }
+    if (readbackSlots.size() != readbackSlotCount && readbackPending == 0) {
+        for (auto& slot : readbackSlots) {
+            destroyReadbackBuffer(slot);
+        }
+        readbackSlots.resize(readbackSlotCount);
+        readbackHead = readbackTail = 0;
+    }
+    if (readbackPending == readbackSlots.size()) {
+        return false; // ring cheio, o consumidor esta atrasado
+    }
+
+    // Cria o buffer ja: se falhar, quem pediu fica sabendo agora e nao espera a copia
+    ReadbackSlot& slot = readbackSlots[readbackHead];
+    VkDeviceSize size = (VkDeviceSize)swapchainExtent.width * swapchainExtent.height * 4;
+    if (size != slot.size && !createReadbackBuffer(slot, size)) {
+        LOG_ERROR("Failed to create readback buffer");
+        return false;
+    }
+    readbackRequested = true;
+    return true;
+}
+
+bool VulkanRendererBackend::pollReadback(std::vector<uint8_t>& pixels, int& width, int& height) {
+    if (readbackPending == 0) {
+        return false;
+    }
+
+    ReadbackSlot& slot = readbackSlots[readbackTail];
+    if (slot.frame > submitCount) {
+        return false; // ainda nao submetido
+    }
+    if (slot.frame > completedCount) {
+        if (vkGetFenceStatus(device, inFlightFence) != VK_SUCCESS) {
+            return false;
+        }
+        completedCount = submitCount;
+    }
+    readbackTail = (readbackTail + 1) % readbackSlots.size();
+    readbackPending--;
+
+    width = (int)slot.extent.width;
+    height = (int)slot.extent.height;
+    size_t size = (size_t)width * height * 4;
+    pixels.resize(size);
+    memcpy(pixels.data(), slot.mapped, size);
+
+    // Swapchains costumam ser BGRA; a saida e sempre RGBA
+    if (swapchainFormat == VK_FORMAT_B8G8R8A8_SRGB || swapchainFormat == VK_FORMAT_B8G8R8A8_UNORM) {
+        for (size_t i = 0; i < size; i += 4) {
+            std::swap(pixels[i], pixels[i + 2]);
+        }
+    }
+    return true;
+}
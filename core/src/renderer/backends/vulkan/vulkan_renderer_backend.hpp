@@ -3,9 +3,27 @@
 
 #include <vulkan/vulkan.h>
 #include "../../renderer_backend.hpp"
+#include "../../render_queue.hpp"
+#include "vulkan_command_recorder.hpp"
+#include "vulkan_gpu_timer.hpp"
+#include "vulkan_pipeline_registry.hpp"
+#include <array>
+#include <unordered_map>
+#include <glm/glm.hpp>
 #include <vector>
 
 struct SDL_Window;
+
+// Set e buffer proprios de um VulkanShaderProgram com reflexao: o bloco do
+// material com o tamanho que o shader declara, mapeado enquanto existir
+struct VulkanProgramUniforms {
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    void* mapped = nullptr;
+    VkDeviceSize size = 0;
+};
+
 class VulkanRendererBackend : public RendererBackend {
 private:
     VkInstance instance = VK_NULL_HANDLE;
@@ -19,23 +37,80 @@ private:
     VkCommandPool commandPool = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
-    std::vector<VkDescriptorSet> descriptorSets;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets; // [0] compartilhado, o resto dos programas
+    VulkanPipelineRegistry pipelineRegistry;
+    VulkanCommandRecorder commandRecorder;
+    VulkanGpuTimer gpuTimer;
+    int gpuFrameScope = -1;
+    RenderQueue renderQueue;               // so para renderGameObjects
+    const RenderQueue* activeQueue = nullptr; // lido por recordDraws
     
     std::vector<VkImage> swapchainImages;
     std::vector<VkImageView> swapchainImageViews;
     std::vector<VkFramebuffer> framebuffers;
     std::vector<VkCommandBuffer> commandBuffers;
     
+    // Headless: uma unica imagem offscreen faz o papel da swapchain
+    VkImage offscreenImage = VK_NULL_HANDLE;
+    VkDeviceMemory offscreenImageMemory = VK_NULL_HANDLE;
+
+    struct ReadbackSlot {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        VkDeviceSize size = 0;
+        VkExtent2D extent{};
+        uint64_t frame = 0; // submitCount do frame que gravou a copia
+    };
+    std::vector<ReadbackSlot> readbackSlots;
+    size_t readbackHead = 0;
+    size_t readbackTail = 0;
+    size_t readbackPending = 0;
+    bool readbackRequested = false;
+    bool readbackSupported = true; // a superficie aceita TRANSFER_SRC na swapchain
+    uint64_t submitCount = 0;
+    uint64_t completedCount = 0;
+
+    // Uniforms de programas destruidos; liberados em clear() quando completedCount
+    // passa de `frame`, sem parar a GPU por programa
+    struct RetiredUniforms {
+        VulkanProgramUniforms uniforms;
+        uint64_t frame = 0;
+    };
+    std::vector<RetiredUniforms> retiredUniforms;
+
+    // Texturas amostradas; o handle devolvido por loadTexture e indice + 1.
+    // Ainda sem descriptor de textura: drawSprite nao desenha no Vulkan.
+    struct Texture {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkSampler sampler = VK_NULL_HANDLE;
+        uint32_t mipLevels = 1;
+        VkDeviceSize bytes = 0;
+    };
+    std::vector<Texture> textures;
+    std::vector<uint32_t> freeTextureSlots;
+    std::unordered_map<uint32_t, VkSampler> samplers; // SamplerDesc::key() -> sampler
+    VkPhysicalDeviceFeatures enabledFeatures{};
+    float maxSamplerAnisotropy = 1.0f;
+
     VkImage depthImage = VK_NULL_HANDLE;
     VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
     VkImageView depthImageView = VK_NULL_HANDLE;
     
+    // Binding 0 e um UBO dinamico: um slot alinhado por draw, slot 0 fica para setUniforms()
     VkBuffer uniformBuffer = VK_NULL_HANDLE;
     VkDeviceMemory uniformBufferMemory = VK_NULL_HANDLE;
+    void* uniformBufferMapped = nullptr;
+    VkDeviceSize uniformStride = 0;
+    uint32_t uniformCapacity = 0;
     VkBuffer materialBuffer = VK_NULL_HANDLE;
     VkDeviceMemory materialBufferMemory = VK_NULL_HANDLE;
     VkBuffer lightDataBuffer = VK_NULL_HANDLE;
     VkDeviceMemory lightDataBufferMemory = VK_NULL_HANDLE;
+    void* lightDataMapped = nullptr; // LightBuffer do frame, escrito por submitLights
     
     VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
     VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
@@ -44,6 +119,13 @@ private:
     uint32_t graphicsQueueFamily = 0;
     uint32_t presentQueueFamily = 0;
     uint32_t currentImageIndex = 0;
+    bool renderPassActive = false;
+    bool swapchainDirty = false; // present() viu OUT_OF_DATE/SUBOPTIMAL
+    bool frameSkipped = false;   // janela minimizada ou swapchain sendo recriada
+    VkSubpassContents renderPassContents = VK_SUBPASS_CONTENTS_INLINE;
+    std::array<VkClearValue, 2> clearValues{};
+    glm::mat4 viewMatrix = glm::mat4(1.0f);
+    glm::mat4 projectionMatrix = glm::mat4(1.0f);
     VkFormat swapchainFormat;
     VkExtent2D swapchainExtent;
     SDL_Window* window;
@@ -51,32 +133,73 @@ private:
     bool createInstance();
     bool pickPhysicalDevice();
     bool createLogicalDevice();
-    bool createSwapchain();
+    bool createSwapchain(VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
+    bool createOffscreenTarget();
+    bool recreateSwapchain();
+    void destroySwapchainResources();
+    VkPresentModeKHR choosePresentMode();
     bool createImageViews();
     bool createRenderPass();
     bool createDescriptorSetLayout();
+    bool createPipelineLayout();
     bool createFramebuffers();
     bool createCommandPool();
     bool createDepthResources();
-    bool createUniformBuffer();
+    bool createUniformBuffer(uint32_t slotCount);
+    void destroyUniformBuffer();
+    bool ensureUniformCapacity(uint32_t slotCount);
     bool createMaterialBuffer();
     bool createLightDataBuffer();
     bool createDescriptorPool();
+    void writeDescriptorSet(VkDescriptorSet set, VkBuffer programBuffer, VkDeviceSize programRange);
     bool createCommandBuffers();
     bool createSyncObjects();
     
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    VkSampler getSampler(const SamplerDesc& desc);
+    VkCommandBuffer beginUploadCommands();
+    void endUploadCommands(VkCommandBuffer cmd);
+
+    void beginRenderPass(VkSubpassContents contents);
+    void setViewportAndScissor(VkCommandBuffer cmd);
+    void recordDraws(VkCommandBuffer cmd, size_t begin, size_t end);
+    bool createReadbackBuffer(ReadbackSlot& slot, VkDeviceSize size);
+    void destroyReadbackBuffer(ReadbackSlot& slot);
+    void freeProgramUniforms(VulkanProgramUniforms& uniforms);
+    void releaseRetiredUniforms(bool all);
+    bool recordReadbackCopy(VkCommandBuffer cmd);
     
 public:
+    // Um binding do set 0. O VulkanPipelineRegistry usa um pipelineLayout so,
+    // entao o layout e este para todos os programas; cada um confere contra ele
+    // o que o SPIR-V declara. perProgram: o buffer vem do programa (material),
+    // e range e so o do buffer compartilhado de quem nao tem reflexao.
+    struct UniformSlot {
+        const char* name;
+        uint32_t binding;
+        VkDescriptorType type;
+        VkShaderStageFlags stages;
+        VkDeviceSize range;
+        bool perProgram;
+    };
+    static const std::array<UniformSlot, 3> UNIFORM_SLOTS;
+    // Sets de programa que o pool comporta; acima disso o programa usa o compartilhado
+    static constexpr uint32_t MAX_DESCRIPTOR_SETS = 1024;
+
     ~VulkanRendererBackend();
 
-    unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) override;
+    unsigned int loadTexture(const std::string& path,
+                             const SamplerDesc& sampler = SamplerDesc()) override;
+    void deleteTexture(unsigned int textureID) override;
+    size_t getTextureBytes(unsigned int textureID) const override;
     void drawSprite(const Sprite& sprite) override;
     bool init() override;
     bool initWindowContext() override;
-    void bindCamera(Camera* camera) override {return;};
+    void bindCamera(Camera* camera) override;
     void applyMaterial(Material* material) override {};
-    void renderGameObjects(std::vector<GameObject*>* gameObjects, std::vector<Light>* lights) override {};
+    void renderGameObjects(std::vector<GameObject*>* gameObjects, std::vector<Light>* lights) override;
+    void submitQueue(const RenderQueue& queue, std::vector<Light>* lights) override;
+    void submitLights(const LightBuffer& lights) override;
     void setBufferDataImpl(const std::string& name, const void* data, size_t size) override {};
     void clear(Camera* camera) override;
     void draw(const Mesh&) override;
@@ -96,14 +219,24 @@ public:
     VkCommandPool getCommandPool() const { return commandPool; }
     VkInstance getInstance() const { return instance; }
     VkDeviceMemory getMaterialBufferMemory() const { return materialBufferMemory; }
-    VkDeviceMemory getLightDataBufferMemory() const { return lightDataBufferMemory; }
+    VkDescriptorSet getSharedDescriptorSet() const { return descriptorSets[0]; }
+    bool createProgramUniforms(VkDeviceSize size, VulkanProgramUniforms& uniforms);
+    void destroyProgramUniforms(VulkanProgramUniforms& uniforms);
     VkExtent2D getSwapchainExtent() const { return swapchainExtent; }
     VkRenderPass getRenderPass() const { return renderPass; }
     VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
+    VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+    VulkanPipelineRegistry& getPipelineRegistry() { return pipelineRegistry; }
     void setSurface(VkSurfaceKHR surf) { surface = surf; }
     void setWindow(SDL_Window* win) { window = win; }
     unsigned int getRequiredWindowFlags() const override;
     bool init(SDL_Window* window) override;
+    bool initHeadless(int width, int height) override;
+    bool requestReadback() override;
+    bool pollReadback(std::vector<uint8_t>& pixels, int& width, int& height) override;
+    size_t getPendingReadbacks() const override {
+        return readbackPending + (readbackRequested ? 1 : 0);
+    }
 };
 
 #endif // VULKAN_RENDERER_BACKEND_HPP
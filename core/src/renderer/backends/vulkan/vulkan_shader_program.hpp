@@ -4,19 +4,24 @@
 #include "../../../shader_program.hpp"
 #include "../../../shader_type.hpp"
 #include "material.hpp"
+#include "vulkan_renderer_backend.hpp"
 #include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
 #include <vector>
 
-class VulkanRendererBackend;
-
 class VulkanShaderProgram : public ShaderProgram {
 private:
     VulkanRendererBackend* backend;
     std::vector<VkShaderModule> shaderModules;
     std::vector<ShaderType> shaderTypes;
+    std::vector<uint64_t> shaderIds;
     VkPipeline pipeline = VK_NULL_HANDLE;
-    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    // So com reflexao; sem ela o programa usa o set compartilhado do backend
+    VulkanProgramUniforms uniforms;
+    std::string uniformsBlock; // nome do bloco que vive em uniforms
     
+    bool createUniforms();
     bool createPipeline();
     
 public:
@@ -31,7 +36,10 @@ public:
     bool isValid() const override;
     
     VkPipeline getPipeline() const { return pipeline; }
-    VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+    VkPipelineLayout getPipelineLayout() const;
+    VkDescriptorSet getDescriptorSet() const {
+        return uniforms.set ? uniforms.set : backend->getSharedDescriptorSet();
+    }
 };
 
 #endif // VULKAN_SHADER_PROGRAM_HPP
@@ -0,0 +1,63 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include "renderer_backend.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat { PNG, RAW };
+
+// Grava frames em disco sem travar o render: o backend copia cada frame para
+// um ring de buffers (PBO / host-visible), os frames sao recolhidos alguns
+// frames depois quando a fence ja passou, e a codificacao roda numa worker.
+class FrameCapture {
+  private:
+    struct EncodeJob {
+        uint64_t frame;
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;
+    };
+
+    RendererBackend* backend = nullptr;
+    std::string outputDir;
+    CaptureFormat format = CaptureFormat::PNG;
+    bool recording = false;
+
+    uint64_t collected = 0; // copias que ja voltaram da GPU
+    uint64_t dropped = 0;   // frames sem slot livre no ring ou na fila
+    std::atomic<uint64_t> written{0};
+
+    std::thread encoder;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<EncodeJob> queue;
+    size_t maxQueued = 8;
+    bool stopping = false;
+
+    void encoderLoop();
+    void collect();
+
+  public:
+    ~FrameCapture();
+
+    bool start(RendererBackend& backend, const std::string& outputDir,
+               CaptureFormat format = CaptureFormat::PNG);
+    // Espera as copias pendentes e os arquivos na fila terminarem
+    void stop();
+
+    // Chamar uma vez por frame entre render e present
+    void onFrameRendered();
+
+    bool isRecording() const { return recording; }
+    uint64_t getDroppedFrames() const { return dropped; }
+    uint64_t getWrittenFrames() const { return written; }
+};
+
+#endif // FRAME_CAPTURE_HPP
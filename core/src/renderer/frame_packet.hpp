@@ -0,0 +1,49 @@
+#ifndef FRAME_PACKET_HPP
+#define FRAME_PACKET_HPP
+
+#include "../camera.hpp"
+#include "../light.hpp"
+#include "../linear_arena.hpp"
+#include "light_buffer.hpp"
+#include "light_clusters.hpp"
+#include "render_queue.hpp"
+#include "shadow_cascades.hpp"
+#include <cstdint>
+#include <vector>
+
+// Everything the backend needs to draw one frame, copied out of the scene by
+// the simulation thread. Once handed to the render thread it is read-only; the
+// draw items still point at meshes and materials, which the scene owns, so the
+// render thread has to be flushed before a scene is unloaded.
+//
+// The draw items live in the packet's own arena, which is recycled each time
+// the simulation starts refilling the packet (the render thread is done with
+// it by then), so building a packet does not use the general heap.
+struct FramePacket {
+    LinearArena arena;
+    uint64_t frameIndex = 0;
+    bool hasCamera = false;
+    Camera camera; // sem skybox, so os parametros
+    std::vector<Light> lights; // mantem a capacidade entre frames
+    LightBuffer lightBuffer;     // lights no layout do LightData
+    LightClusters lightClusters; // point e spot de lights, em view space
+    ShadowCascades shadows;      // casters montados junto com a fila
+    RenderQueue queue;
+
+    FramePacket() {
+        queue.setArena(&arena);
+        shadows.setArena(&arena);
+    }
+    FramePacket(const FramePacket&) = delete;
+    FramePacket& operator=(const FramePacket&) = delete;
+
+    // Solta os containers antes de reciclar a arena
+    void reset() {
+        queue.clear();
+        shadows.clear();
+        arena.reset();
+        hasCamera = false;
+    }
+};
+
+#endif // FRAME_PACKET_HPP
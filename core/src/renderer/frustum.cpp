@@ -0,0 +1,29 @@
+#include "frustum.hpp"
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // glm e column-major: a linha i e (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum f;
+    f.planes[0] = r3 + r0; // left
+    f.planes[1] = r3 - r0; // right
+    f.planes[2] = r3 + r1; // bottom
+    f.planes[3] = r3 - r1; // top
+    f.planes[4] = r3 + r2; // near
+    f.planes[5] = r3 - r2; // far
+
+    for (auto& p : f.planes) {
+        p /= glm::length(glm::vec3(p));
+    }
+    return f;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius, bool testNear) const {
+    for (int i = 0; i < 6; i++) {
+        if (i == 4 && !testNear) continue;
+        const glm::vec4& p = planes[i];
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius) return false;
+    }
+    return true;
+}
@@ -0,0 +1,16 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+
+// Os seis planos de uma matriz view-projection (Gribb/Hartmann), normalizados
+// e apontando para dentro.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+    // Sem o near, o que esta antes do frustum tambem passa (casters de sombra)
+    bool intersectsSphere(const glm::vec3& center, float radius, bool testNear = true) const;
+};
+
+#endif // FRUSTUM_HPP
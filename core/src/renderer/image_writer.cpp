@@ -0,0 +1,132 @@
+#include "image_writer.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace {
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    const auto& table = crcTable();
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(v >> 24);
+    out.push_back(v >> 16);
+    out.push_back(v >> 8);
+    out.push_back(v);
+}
+
+void writeChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> header;
+    putU32(header, (uint32_t)data.size());
+    header.insert(header.end(), type, type + 4);
+
+    uint32_t crc = crc32(0xFFFFFFFFu, header.data() + 4, 4);
+    crc = crc32(crc, data.data(), data.size()) ^ 0xFFFFFFFFu;
+
+    std::vector<uint8_t> footer;
+    putU32(footer, crc);
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+}
+
+} // namespace
+
+namespace ImageWriter {
+
+bool writePNG(const std::string& path, int width, int height, const std::vector<uint8_t>& pixels,
+              int channels) {
+    if (width <= 0 || height <= 0 || (channels != 3 && channels != 4) ||
+        pixels.size() < (size_t)width * height * channels) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<uint8_t> ihdr;
+    putU32(ihdr, width);
+    putU32(ihdr, height);
+    ihdr.push_back(8); // bits por canal
+    ihdr.push_back(channels == 4 ? 6 : 2); // RGBA ou RGB
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    writeChunk(file, "IHDR", ihdr);
+
+    // Scanlines com filtro 0 na frente de cada linha
+    size_t rowSize = (size_t)width * channels;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowSize + 1) * height);
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), pixels.begin() + y * rowSize, pixels.begin() + (y + 1) * rowSize);
+    }
+
+    // zlib: cabecalho, blocos stored de ate 65535 bytes, adler32
+    std::vector<uint8_t> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+
+    uint32_t a = 1, b = 0;
+    size_t pos = 0;
+    do {
+        size_t len = std::min<size_t>(65535, raw.size() - pos);
+        bool last = pos + len == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back(len & 0xFF);
+        idat.push_back(len >> 8);
+        idat.push_back(~len & 0xFF);
+        idat.push_back((~len >> 8) & 0xFF);
+        for (size_t i = 0; i < len; i++) {
+            uint8_t v = raw[pos + i];
+            idat.push_back(v);
+            a = (a + v) % 65521;
+            b = (b + a) % 65521;
+        }
+        pos += len;
+    } while (pos < raw.size());
+    putU32(idat, (b << 16) | a);
+
+    writeChunk(file, "IDAT", idat);
+    writeChunk(file, "IEND", {});
+    return file.good();
+}
+
+bool writeRaw(const std::string& path, const std::vector<uint8_t>& rgba) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(rgba.data()), rgba.size());
+    return file.good();
+}
+
+} // namespace ImageWriter
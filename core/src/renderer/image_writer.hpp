@@ -0,0 +1,21 @@
+#ifndef IMAGE_WRITER_HPP
+#define IMAGE_WRITER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ImageWriter {
+
+// PNG RGBA8 (ou RGB8 com channels = 3) com deflate "stored" (sem compressao):
+// arquivos maiores, mas codificar custa praticamente so o CRC, o que importa
+// para gravar em tempo real.
+bool writePNG(const std::string& path, int width, int height, const std::vector<uint8_t>& pixels,
+              int channels = 4);
+
+// Pixels crus RGBA8, linha 0 no topo, sem cabecalho.
+bool writeRaw(const std::string& path, const std::vector<uint8_t>& rgba);
+
+} // namespace ImageWriter
+
+#endif // IMAGE_WRITER_HPP
@@ -0,0 +1,69 @@
+#include "light_buffer.hpp"
+#include "shadow_cascades.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+
+void packEntry(const Light& light, LightBuffer::Entry& entry) {
+    entry.directionType[0] = light.direction.x;
+    entry.directionType[1] = light.direction.y;
+    entry.directionType[2] = light.direction.z;
+    entry.directionType[3] = (float)light.type;
+
+    entry.color[0] = light.color.r;
+    entry.color[1] = light.color.g;
+    entry.color[2] = light.color.b;
+    entry.color[3] = light.intensity;
+
+    entry.positionRange[0] = light.position.x;
+    entry.positionRange[1] = light.position.y;
+    entry.positionRange[2] = light.position.z;
+    entry.positionRange[3] = light.range;
+
+    entry.cone[0] = std::cos(light.innerAngle * DEG_TO_RAD);
+    entry.cone[1] = std::cos(light.outerAngle * DEG_TO_RAD);
+    entry.cone[2] = 0.0f;
+    entry.cone[3] = 0.0f;
+}
+
+} // namespace
+
+void LightBuffer::pack(const std::vector<Light>& sceneLights) {
+    // Direcionais na frente: o shader faz o sol com um loop ate counts[1]. A
+    // primeira com castShadows e a mesma que o ShadowCascades escolhe.
+    uint32_t count = 0;
+    shadowParams[3] = -1.0f;
+    for (const Light& light : sceneLights) {
+        if (count == MAX_LIGHTS) break;
+        if (light.type != LightType::DIRECTIONAL) continue;
+        if (light.castShadows && shadowParams[3] < 0.0f) shadowParams[3] = (float)count;
+        packEntry(light, lights[count++]);
+    }
+    counts[1] = count;
+    for (const Light& light : sceneLights) {
+        if (count == MAX_LIGHTS) break;
+        if (light.type != LightType::DIRECTIONAL) packEntry(light, lights[count++]);
+    }
+    counts[0] = count;
+}
+
+void LightBuffer::packShadows(const ShadowCascades& shadows) {
+    uint32_t count = shadowParams[3] >= 0.0f ? shadows.getCascadeCount() : 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const ShadowCascades::Cascade& cascade = shadows.getCascade(i);
+        std::memcpy(shadowMatrices[i], glm::value_ptr(cascade.viewProjection),
+                    sizeof(shadowMatrices[i]));
+        cascadeSplits[i] = cascade.splitDepth;
+    }
+    shadowParams[0] = (float)count;
+    shadowParams[1] = shadows.getBias();
+    shadowParams[2] = 1.0f / ShadowCascades::MAP_SIZE;
+}
+
+size_t LightBuffer::getUsedBytes() const {
+    return offsetof(LightBuffer, lights) + counts[0] * sizeof(Entry);
+}
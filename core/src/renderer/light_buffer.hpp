@@ -0,0 +1,49 @@
+#ifndef LIGHT_BUFFER_HPP
+#define LIGHT_BUFFER_HPP
+
+#include "../light.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Every scene light packed once per frame into the std140 layout of the
+// "LightData" uniform block, directional lights first. Backends upload it once
+// before drawing and materials only index into it, so the upload cost follows
+// the number of lights rather than the number of draws. Point and spot lights
+// past MAX_LIGHTS still reach the shaders through LightClusters. The cascaded
+// shadow of one directional light (ShadowCascades) rides in the same block.
+class ShadowCascades;
+
+struct LightBuffer {
+    static constexpr uint32_t MAX_LIGHTS = 128;
+    static constexpr uint32_t MAX_SHADOW_CASCADES = 4;
+
+    struct Entry {
+        float directionType[4]; // direcao (mundo), LightType
+        float color[4];         // rgb, intensidade
+        float positionRange[4]; // posicao (mundo), alcance
+        float cone[4];          // cos interno, cos externo, 0, 0
+    };
+
+    uint32_t counts[4] = {}; // total, direcionais, 0, 0
+    // Sombra da direcional em lights[shadowParams[3]]; matrizes column-major
+    float shadowMatrices[MAX_SHADOW_CASCADES][16] = {};
+    float cascadeSplits[4] = {}; // profundidade (view space) onde cada cascata termina
+    float shadowParams[4] = {};  // cascatas, bias, 1 / ShadowCascades::MAP_SIZE, luz
+    Entry lights[MAX_LIGHTS];
+
+    void pack(const std::vector<Light>& sceneLights);
+    // Depois de pack(); sem cascatas ativas o shader ve zero cascatas
+    void packShadows(const ShadowCascades& shadows);
+    // So o cabecalho e as luzes em uso vao para a GPU
+    size_t getUsedBytes() const;
+};
+
+// Espelho do #define em scene_lights.hlsli: os dois mudam juntos
+constexpr uint32_t LIGHT_BUFFER_MAX_LIGHTS = 128;
+static_assert(LightBuffer::MAX_LIGHTS == LIGHT_BUFFER_MAX_LIGHTS,
+              "LightBuffer::MAX_LIGHTS must match LIGHT_BUFFER_MAX_LIGHTS in scene_lights.hlsli");
+static_assert(sizeof(LightBuffer::Entry) == 64, "LightBuffer::Entry must match std140");
+static_assert(offsetof(LightBuffer, lights) % 16 == 0, "LightBuffer::lights must match std140");
+
+#endif // LIGHT_BUFFER_HPP
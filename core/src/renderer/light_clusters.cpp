@@ -0,0 +1,260 @@
+#define CLASS_NAME "LightClusters"
+#include "../log_macros.hpp"
+
+#include "../job_system.hpp"
+#include "../profiler.hpp"
+#include "light_clusters.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+
+// Profundidade (positiva) onde comeca o slice; exponencial, como o lookup do shader
+float sliceDepth(uint32_t slice, float nearDistance, float farDistance) {
+    return nearDistance *
+           std::pow(farDistance / nearDistance, (float)slice / LightClusters::GRID_Z);
+}
+
+} // namespace
+
+void LightClusters::clear() {
+    lights.clear();
+    lightIndices.clear();
+    clusters.assign(CLUSTER_COUNT, Cluster{0, 0});
+    params.gridSize[3] = 0;
+}
+
+void LightClusters::updateBounds(const glm::mat4& projection, float nearDistance,
+                                 float farDistance) {
+    if (clusterBounds.size() == CLUSTER_COUNT && projection == boundsProjection &&
+        nearDistance == boundsNear && farDistance == boundsFar) {
+        return;
+    }
+    boundsProjection = projection;
+    boundsNear = nearDistance;
+    boundsFar = farDistance;
+    clusterBounds.resize(CLUSTER_COUNT);
+
+    // Cada canto do tile vira um raio (near -> far do clip); o froxel e o
+    // trecho dos quatro raios entre as duas profundidades do slice. Vale para
+    // perspectiva e ortografica.
+    glm::mat4 inverse = glm::inverse(projection);
+    auto unproject = [&](float x, float y, float z) {
+        glm::vec4 p = inverse * glm::vec4(x, y, z, 1.0f);
+        return glm::vec3(p) / p.w;
+    };
+
+    for (uint32_t y = 0; y < GRID_Y; y++) {
+        for (uint32_t x = 0; x < GRID_X; x++) {
+            glm::vec3 rayNear[4], rayFar[4];
+            for (int corner = 0; corner < 4; corner++) {
+                float ndcX = -1.0f + 2.0f * (float)(x + (corner & 1)) / GRID_X;
+                float ndcY = -1.0f + 2.0f * (float)(y + (corner >> 1)) / GRID_Y;
+                rayNear[corner] = unproject(ndcX, ndcY, -1.0f);
+                rayFar[corner] = unproject(ndcX, ndcY, 1.0f);
+            }
+
+            for (uint32_t z = 0; z < GRID_Z; z++) {
+                float depths[2] = {sliceDepth(z, nearDistance, farDistance),
+                                   sliceDepth(z + 1, nearDistance, farDistance)};
+                Bounds bounds{glm::vec3(INFINITY), glm::vec3(-INFINITY)};
+                for (int corner = 0; corner < 4; corner++) {
+                    glm::vec3 ray = rayFar[corner] - rayNear[corner];
+                    for (float depth : depths) {
+                        float t = (-depth - rayNear[corner].z) / ray.z;
+                        glm::vec3 p = rayNear[corner] + ray * t;
+                        bounds.min = glm::min(bounds.min, p);
+                        bounds.max = glm::max(bounds.max, p);
+                    }
+                }
+                clusterBounds[(z * GRID_Y + y) * GRID_X + x] = bounds;
+            }
+        }
+    }
+}
+
+// Tiles cobertos pela caixa da esfera projetada; se a esfera cruza o plano
+// near a projecao nao vale e ela cobre a tela toda
+LightClusters::TileRect LightClusters::tileRect(const glm::vec3& center, float radius,
+                                                const glm::mat4& projection,
+                                                float nearDistance) const {
+    TileRect full{0, 0, GRID_X - 1, GRID_Y - 1};
+    if (-center.z - radius < nearDistance) return full;
+
+    glm::vec2 lo(INFINITY), hi(-INFINITY);
+    for (int corner = 0; corner < 8; corner++) {
+        glm::vec3 p = center + radius * glm::vec3(corner & 1 ? 1.0f : -1.0f,
+                                                  corner & 2 ? 1.0f : -1.0f,
+                                                  corner & 4 ? 1.0f : -1.0f);
+        glm::vec4 clip = projection * glm::vec4(p, 1.0f);
+        glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        lo = glm::min(lo, ndc);
+        hi = glm::max(hi, ndc);
+    }
+
+    auto tile = [](float ndc, uint32_t count) {
+        float t = std::floor((ndc * 0.5f + 0.5f) * count);
+        return (uint8_t)std::clamp(t, 0.0f, (float)(count - 1));
+    };
+    if (hi.x < -1.0f || lo.x > 1.0f || hi.y < -1.0f || lo.y > 1.0f) {
+        return TileRect{1, 1, 0, 0}; // fora da tela: retangulo vazio
+    }
+    return TileRect{tile(lo.x, GRID_X), tile(lo.y, GRID_Y), tile(hi.x, GRID_X),
+                    tile(hi.y, GRID_Y)};
+}
+
+void LightClusters::binSlice(uint32_t z) {
+    Slice& slice = slices[z];
+    slice.candidates.clear();
+    slice.hits.clear();
+    slice.overflow = false;
+
+    float depthBegin = sliceDepth(z, params.depthParams[0], params.depthParams[1]);
+    float depthEnd = sliceDepth(z + 1, params.depthParams[0], params.depthParams[1]);
+    for (uint32_t i = 0; i < lightDepths.size(); i++) {
+        if (lightDepths[i].x <= depthEnd && lightDepths[i].y >= depthBegin) {
+            slice.candidates.push_back(i);
+        }
+    }
+
+    // Cada luz so testa os tiles do proprio retangulo; os acertos (tile, luz)
+    // viram listas por cluster com um counting sort, mantendo a ordem das luzes
+    constexpr uint32_t TILES = GRID_X * GRID_Y;
+    uint32_t counts[TILES] = {};
+    const uint32_t first = z * TILES;
+    for (uint32_t i : slice.candidates) {
+        const TileRect& rect = lightTiles[i];
+        glm::vec3 center = glm::vec3(lights[i].positionRange);
+        float rangeSquared = lights[i].positionRange.w * lights[i].positionRange.w;
+        for (uint32_t y = rect.y0; y <= rect.y1; y++) {
+            for (uint32_t x = rect.x0; x <= rect.x1; x++) {
+                uint32_t tile = y * GRID_X + x;
+                const Bounds& bounds = clusterBounds[first + tile];
+                glm::vec3 delta = glm::clamp(center, bounds.min, bounds.max) - center;
+                if (glm::dot(delta, delta) > rangeSquared) continue;
+                if (counts[tile] == MAX_LIGHTS_PER_CLUSTER) continue;
+                if (slice.hits.size() == MAX_INDICES_PER_SLICE) {
+                    slice.overflow = true;
+                    continue;
+                }
+                counts[tile]++;
+                slice.hits.push_back(tile << 16 | i);
+            }
+        }
+    }
+
+    // Offsets relativos ao slice; build() soma a base depois de juntar tudo
+    uint32_t offset = 0;
+    for (uint32_t tile = 0; tile < TILES; tile++) {
+        clusters[first + tile] = Cluster{offset, 0};
+        offset += counts[tile];
+    }
+    slice.indices.resize(slice.hits.size());
+    for (uint32_t hit : slice.hits) {
+        Cluster& cluster = clusters[first + (hit >> 16)];
+        slice.indices[cluster.offset + cluster.count++] = hit & 0xFFFF;
+    }
+}
+
+void LightClusters::build(const std::vector<Light>& sceneLights, const glm::mat4& view,
+                          const glm::mat4& projection, float nearDistance, float farDistance,
+                          Yume::JobSystem* jobs) {
+    PROFILE_SCOPE("BuildLightClusters");
+
+    clear();
+    if (nearDistance <= 0.0f || farDistance <= nearDistance) return;
+
+    params.gridSize[0] = GRID_X;
+    params.gridSize[1] = GRID_Y;
+    params.gridSize[2] = GRID_Z;
+    float logRatio = std::log(farDistance / nearDistance);
+    params.depthParams[0] = nearDistance;
+    params.depthParams[1] = farDistance;
+    params.depthParams[2] = GRID_Z / logRatio;
+    params.depthParams[3] = -(float)GRID_Z * std::log(nearDistance) / logRatio;
+
+    // Tudo com tamanho maximo conhecido: depois do primeiro frame nada realoca
+    if (slices.empty()) {
+        slices.resize(GRID_Z);
+        for (Slice& slice : slices) {
+            slice.candidates.reserve(MAX_LIGHTS);
+            slice.hits.reserve(MAX_INDICES_PER_SLICE);
+            slice.indices.reserve(MAX_INDICES_PER_SLICE);
+        }
+        lights.reserve(MAX_LIGHTS);
+        lightDepths.reserve(MAX_LIGHTS);
+        lightTiles.reserve(MAX_LIGHTS);
+        lightIndices.reserve(GRID_Z * MAX_INDICES_PER_SLICE);
+    }
+
+    // Spot usa a esfera do alcance inteiro: conservador, mas o teste continua
+    // o mesmo para os dois tipos
+    lightDepths.clear();
+    lightTiles.clear();
+    glm::mat3 rotation(view);
+    for (const Light& light : sceneLights) {
+        if (light.type == LightType::DIRECTIONAL || light.range <= 0.0f) continue;
+        if (lights.size() == MAX_LIGHTS) {
+            if (!warnedOverflow) {
+                LOG_WARN("More than %u point/spot lights; the rest are ignored", MAX_LIGHTS);
+                warnedOverflow = true;
+            }
+            break;
+        }
+
+        glm::vec3 position =
+            glm::vec3(view * glm::vec4(light.position.x, light.position.y, light.position.z, 1.0f));
+        glm::vec2 depth(-position.z - light.range, -position.z + light.range);
+        if (depth.y < nearDistance || depth.x > farDistance) continue;
+        TileRect rect = tileRect(position, light.range, projection, nearDistance);
+        if (rect.x0 > rect.x1) continue;
+
+        GpuLight gpu;
+        gpu.positionRange = glm::vec4(position, light.range);
+        glm::vec3 color = glm::vec3(light.color.r, light.color.g, light.color.b) * light.intensity;
+        if (light.type == LightType::SPOT) {
+            glm::vec3 direction = glm::normalize(
+                rotation * glm::vec3(light.direction.x, light.direction.y, light.direction.z));
+            gpu.colorCosInner = glm::vec4(color, std::cos(light.innerAngle * DEG_TO_RAD));
+            gpu.directionCosOuter =
+                glm::vec4(direction, std::cos(light.outerAngle * DEG_TO_RAD));
+        } else {
+            // Cone que cobre tudo: o smoothstep do shader sempre da 1
+            gpu.colorCosInner = glm::vec4(color, -1.0f);
+            gpu.directionCosOuter = glm::vec4(0.0f, 0.0f, -1.0f, -2.0f);
+        }
+        lights.push_back(gpu);
+        lightDepths.push_back(depth);
+        lightTiles.push_back(rect);
+    }
+    params.gridSize[3] = (uint32_t)lights.size();
+    if (lights.empty()) return;
+
+    updateBounds(projection, nearDistance, farDistance);
+
+    auto binRange = [this](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; z++) binSlice((uint32_t)z);
+    };
+    if (jobs) {
+        jobs->parallelFor(GRID_Z, 1, binRange);
+    } else {
+        binRange(0, GRID_Z);
+    }
+
+    bool overflow = false;
+    for (uint32_t z = 0; z < GRID_Z; z++) {
+        overflow |= slices[z].overflow;
+        uint32_t base = (uint32_t)lightIndices.size();
+        lightIndices.insert(lightIndices.end(), slices[z].indices.begin(),
+                            slices[z].indices.end());
+        for (uint32_t c = z * GRID_X * GRID_Y; c < (z + 1) * GRID_X * GRID_Y; c++) {
+            clusters[c].offset += base;
+        }
+    }
+    if (overflow && !warnedIndexOverflow) {
+        LOG_WARN("Light index list full; some clusters are missing lights");
+        warnedIndexOverflow = true;
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef LIGHT_CLUSTERS_HPP
+#define LIGHT_CLUSTERS_HPP
+
+#include "../light.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Yume {
+class JobSystem;
+}
+
+// Point and spot lights binned into a view-space froxel grid (GRID_X x GRID_Y
+// tiles, GRID_Z exponential depth slices) so a fragment only loops over the
+// lights that can reach its cluster. Built once per frame on the simulation
+// thread, one job per depth slice; the buffers keep their capacity, so after
+// the first frames a rebuild does not touch the heap.
+//
+// Layout the shaders read (see getParams for the lookup constants):
+//   lights:  3 x vec4 per light, view space
+//            (position, range) (color * intensity, cos inner) (direction, cos outer)
+//   grid:    (offset, count) into lightIndices per cluster, x fastest
+//   indices: light numbers, grouped by cluster
+class LightClusters {
+  public:
+    static constexpr uint32_t GRID_X = 16;
+    static constexpr uint32_t GRID_Y = 9;
+    static constexpr uint32_t GRID_Z = 24;
+    static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+    static constexpr uint32_t MAX_LIGHTS = 1024;
+    static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 256;
+    // Orcamento fixo da lista de indices (media de 64 por cluster): reservado
+    // uma vez, entao o tamanho do buffer na GPU tambem nao cresce
+    static constexpr uint32_t MAX_INDICES_PER_SLICE = GRID_X * GRID_Y * 64;
+
+    struct GpuLight {
+        glm::vec4 positionRange;
+        glm::vec4 colorCosInner;
+        glm::vec4 directionCosOuter;
+    };
+
+    struct Cluster {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    // Constantes do lookup no shader (std140)
+    struct Params {
+        uint32_t gridSize[4]; // x, y, z, numero de luzes
+        float depthParams[4]; // near, far, escala e bias do slice: log(z) * escala + bias
+    };
+
+    void build(const std::vector<Light>& sceneLights, const glm::mat4& view,
+               const glm::mat4& projection, float nearDistance, float farDistance,
+               Yume::JobSystem* jobs = nullptr);
+    void clear();
+
+    const std::vector<GpuLight>& getLights() const { return lights; }
+    const std::vector<Cluster>& getClusters() const { return clusters; }
+    const std::vector<uint32_t>& getLightIndices() const { return lightIndices; }
+    const Params& getParams() const { return params; }
+    bool empty() const { return lights.empty(); }
+
+  private:
+    struct Bounds {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    std::vector<GpuLight> lights;
+    std::vector<Cluster> clusters;
+    std::vector<uint32_t> lightIndices;
+    Params params{};
+
+    // Caixas dos froxels em view space; so recalculam quando a projecao muda
+    std::vector<Bounds> clusterBounds;
+    glm::mat4 boundsProjection = glm::mat4(0.0f);
+    float boundsNear = 0.0f;
+    float boundsFar = 0.0f;
+
+    // Rascunho de cada slice: luzes que cruzam a faixa de profundidade, os
+    // pares (tile << 16 | luz) que se tocam e as listas dos clusters dele,
+    // antes de juntar em lightIndices
+    struct Slice {
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> hits;
+        std::vector<uint32_t> indices;
+        bool overflow = false;
+    };
+    std::vector<Slice> slices;
+    // Por luz: [near, far] positivo e os tiles (x0, y0, x1, y1) que a esfera cobre
+    std::vector<glm::vec2> lightDepths;
+    struct TileRect {
+        uint8_t x0, y0, x1, y1; // inclusivo
+    };
+    std::vector<TileRect> lightTiles;
+    bool warnedOverflow = false;
+    bool warnedIndexOverflow = false;
+
+    void updateBounds(const glm::mat4& projection, float nearDistance, float farDistance);
+    TileRect tileRect(const glm::vec3& center, float radius, const glm::mat4& projection,
+                         float nearDistance) const;
+    void binSlice(uint32_t slice);
+};
+
+#endif // LIGHT_CLUSTERS_HPP
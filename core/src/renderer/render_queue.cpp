@@ -0,0 +1,109 @@
+#include "render_queue.hpp"
+#include "../frame_memory.hpp"
+#include "../game_object.hpp"
+#include "../job_system.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Maior fator de escala das tres colunas da matriz, para levar o raio ao mundo
+float maxScale(const glm::mat4& m) {
+    float sx = glm::dot(glm::vec3(m[0]), glm::vec3(m[0]));
+    float sy = glm::dot(glm::vec3(m[1]), glm::vec3(m[1]));
+    float sz = glm::dot(glm::vec3(m[2]), glm::vec3(m[2]));
+    return std::sqrt(std::max(sx, std::max(sy, sz)));
+}
+
+enum class ItemResult { SKIPPED, CULLED, VISIBLE };
+
+ItemResult makeItem(GameObject* go, const Frustum* frustum, ShadowCascades* shadows,
+                    size_t index, DrawItem& item) {
+    item = DrawItem();
+    if (go->getTransform()) {
+        item.model = go->getTransform()->getModelMatrix();
+    }
+
+    glm::vec3 localCenter(0.0f);
+    float localRadius = 0.0f;
+
+    if (go->hasSprite() && go->hasSpriteRenderer()) {
+        item.sprite = go->getSprite();
+        item.material = go->getSpriteRenderer()->getMaterial();
+        localRadius = 0.5f * std::sqrt(item.sprite->getWidth() * item.sprite->getWidth() +
+                                       item.sprite->getHeight() * item.sprite->getHeight());
+    } else if (go->hasMesh() && go->hasMeshRenderer()) {
+        item.mesh = go->getMesh();
+        item.material = go->getMeshRenderer()->getMaterial();
+        localCenter = item.mesh->getBoundsCenter();
+        localRadius = item.mesh->getBoundsRadius();
+    }
+
+    if (!item.material) return ItemResult::SKIPPED;
+    if (!frustum && !shadows) return ItemResult::VISIBLE;
+
+    glm::vec3 center = glm::vec3(item.model * glm::vec4(localCenter, 1.0f));
+    float radius = localRadius * maxScale(item.model);
+    // Antes do culling da camera: quem esta fora da tela ainda projeta sombra
+    if (shadows && item.mesh) {
+        shadows->testCaster(index, *item.mesh, item.model, center, radius);
+    }
+    if (frustum && !frustum->intersectsSphere(center, radius)) {
+        return ItemResult::CULLED;
+    }
+    return ItemResult::VISIBLE;
+}
+
+// Abaixo disso dividir entre threads custa mais do que economiza
+constexpr size_t MIN_OBJECTS_PER_JOB = 256;
+
+} // namespace
+
+void RenderQueue::build(const std::vector<GameObject*>& gameObjects, const Frustum* frustum,
+                        Yume::JobSystem* jobs, ShadowCascades* shadows) {
+    clear();
+    if (shadows && !shadows->isActive()) shadows = nullptr;
+    if (shadows) shadows->beginCasters(gameObjects.size());
+
+    if (!jobs || jobs->getWorkerCount() == 0 || gameObjects.size() < 2 * MIN_OBJECTS_PER_JOB) {
+        items.reserve(gameObjects.size());
+        DrawItem item;
+        for (size_t i = 0; i < gameObjects.size(); i++) {
+            ItemResult result = makeItem(gameObjects[i], frustum, shadows, i, item);
+            if (result == ItemResult::VISIBLE) {
+                items.push_back(item);
+            } else if (result == ItemResult::CULLED) {
+                culledCount++;
+            }
+        }
+        if (shadows) shadows->endCasters();
+        return;
+    }
+
+    // Cada job escreve no indice do proprio objeto; a compactacao depois
+    // mantem a ordem da cena
+    items.resize(gameObjects.size());
+    // Resultado do culling, rascunho do frame: 1 por GameObject
+    ArenaVector<uint8_t> visible(gameObjects.size(), 0, FrameMemory::allocator<uint8_t>());
+    std::atomic<size_t> culled{0};
+    jobs->parallelFor(gameObjects.size(), MIN_OBJECTS_PER_JOB, [&](size_t begin, size_t end) {
+        size_t localCulled = 0;
+        for (size_t i = begin; i < end; i++) {
+            ItemResult result = makeItem(gameObjects[i], frustum, shadows, i, items[i]);
+            visible[i] = result == ItemResult::VISIBLE;
+            localCulled += result == ItemResult::CULLED;
+        }
+        culled.fetch_add(localCulled, std::memory_order_relaxed);
+    });
+
+    size_t count = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (visible[i]) {
+            if (count != i) items[count] = items[i];
+            count++;
+        }
+    }
+    items.resize(count);
+    culledCount = culled.load();
+    if (shadows) shadows->endCasters();
+}
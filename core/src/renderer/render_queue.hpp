@@ -0,0 +1,64 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include "../linear_arena.hpp"
+#include "../material.hpp"
+#include "../mesh.hpp"
+#include "../sprite.hpp"
+#include "frustum.hpp"
+#include "shadow_cascades.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class GameObject;
+
+namespace Yume {
+class JobSystem;
+}
+
+// Copia do que o backend precisa de um objeto: o FramePacket vai para o render
+// thread e nao pode apontar para o GameObject, que a simulacao segue mudando
+struct DrawItem {
+    const Mesh* mesh = nullptr;
+    const Sprite* sprite = nullptr;
+    Material* material = nullptr;
+    glm::mat4 model = glm::mat4(1.0f);
+};
+
+// Flat list of everything that has to be drawn this frame, extracted from the
+// scene graph so backends can iterate (or split) it without touching GameObjects.
+class RenderQueue {
+  private:
+    ArenaVector<DrawItem> items;
+    size_t culledCount = 0;
+
+  public:
+    // Com arena a memoria dos itens so vale ate a arena ser resetada; clear()
+    // solta o armazenamento e precisa vir antes do reset
+    void setArena(LinearArena* arena) {
+        items = ArenaVector<DrawItem>(ArenaAllocator<DrawItem>(arena));
+    }
+    void clear() {
+        if (items.get_allocator().arena) {
+            items = ArenaVector<DrawItem>(items.get_allocator());
+        } else {
+            items.clear();
+        }
+        culledCount = 0;
+    }
+    // Objects whose bounding sphere falls outside `frustum` are skipped. With a
+    // job system the matrices and culling run in parallel; order is preserved.
+    // Active `shadows` get their casters culled in the same pass, camera-culled
+    // objects included.
+    void build(const std::vector<GameObject*>& gameObjects, const Frustum* frustum = nullptr,
+               Yume::JobSystem* jobs = nullptr, ShadowCascades* shadows = nullptr);
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    size_t getCulledCount() const { return culledCount; }
+    const DrawItem& operator[](size_t i) const { return items[i]; }
+    const ArenaVector<DrawItem>& getItems() const { return items; }
+};
+
+#endif // RENDER_QUEUE_HPP
@@ -0,0 +1,190 @@
+#define CLASS_NAME "RenderThread"
+#include "../log_macros.hpp"
+
+#include "render_thread.hpp"
+#include "../job_system.hpp"
+#include "../profiler.hpp"
+#include "renderer.hpp"
+#include <chrono>
+
+RenderThread::~RenderThread() { stop(); }
+
+void RenderThread::setRenderer(Renderer& renderer, SDL_Window* window) {
+    this->renderer = &renderer;
+    this->window = window;
+}
+
+bool RenderThread::start() {
+    if (running) return true;
+    if (!renderer || !renderer->getRendererBackend()) {
+        LOG_ERROR("Can not start the render thread without a renderer backend!");
+        return false;
+    }
+
+    writeIndex = 0;
+    pendingIndex = drawingIndex = -1;
+    stopping = pauseRequested = paused = false;
+
+    // O contexto so pode estar ativo em um thread por vez
+    renderer->getRendererBackend()->releaseCurrent(window);
+
+    bool started = false;
+    bool contextOk = false;
+    thread = std::thread([this, &started, &contextOk]() {
+        Yume::JobSystem* jobs = this->renderer->getJobSystem();
+        if (!jobs || jobs->registerThread("Render") == Yume::JobSystem::NO_THREAD) {
+            Profiler::setThreadName("Render");
+        }
+
+        bool ok = this->renderer->getRendererBackend()->makeCurrent(this->window);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            started = true;
+            contextOk = ok;
+        }
+        ready.notify_all();
+        if (ok) threadLoop();
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&] { return started; });
+    }
+    if (!contextOk) {
+        LOG_ERROR("Render thread could not take the graphics context");
+        thread.join();
+        renderer->getRendererBackend()->makeCurrent(window);
+        return false;
+    }
+
+    running = true;
+    LOG_INFO("Render thread started");
+    return true;
+}
+
+void RenderThread::stop() {
+    if (!running) return;
+
+    bool wasPaused;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        wasPaused = pauseRequested;
+    }
+    wake.notify_all();
+    thread.join();
+    running = false;
+
+    // Pausado, o contexto ja estava com quem chama
+    if (!wasPaused) {
+        renderer->getRendererBackend()->makeCurrent(window);
+    }
+    LOG_INFO("Render thread stopped");
+}
+
+FramePacket& RenderThread::beginFrame() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [&] { return drawingIndex != writeIndex && pendingIndex != writeIndex; });
+    return packets[writeIndex];
+}
+
+void RenderThread::submitFrame() {
+    if (!running) {
+        // Sem thread: desenha na hora, no thread que chama
+        FramePacket& packet = packets[writeIndex];
+        renderer->submitFramePacket(packet);
+        if (frameRendered) frameRendered();
+        renderer->present(window);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&] { return pendingIndex == -1; });
+        pendingIndex = writeIndex;
+        writeIndex ^= 1;
+    }
+    wake.notify_one();
+}
+
+void RenderThread::flush() {
+    if (!running) return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [&] { return pendingIndex == -1 && drawingIndex == -1; });
+}
+
+void RenderThread::pause() {
+    if (!running) return;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        pauseRequested = true;
+        wake.notify_one();
+        ready.wait(lock, [&] { return paused; });
+    }
+    renderer->getRendererBackend()->makeCurrent(window);
+}
+
+void RenderThread::resume() {
+    if (!running) return;
+
+    renderer->getRendererBackend()->releaseCurrent(window);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pauseRequested = false;
+    }
+    wake.notify_one();
+}
+
+void RenderThread::threadLoop() {
+    RendererBackend* backend = renderer->getRendererBackend();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return pendingIndex != -1 || pauseRequested || stopping; });
+
+        // Packets publicados sao desenhados antes de pausar ou parar
+        if (pendingIndex != -1) {
+            drawingIndex = pendingIndex;
+            pendingIndex = -1;
+            lock.unlock();
+            ready.notify_all();
+
+            auto start = std::chrono::steady_clock::now();
+            renderer->submitFramePacket(packets[drawingIndex]);
+            if (frameRendered) frameRendered();
+            {
+                PROFILE_SCOPE("Present");
+                renderer->present(window);
+            }
+            lastSubmitMs.store(std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count(),
+                               std::memory_order_relaxed);
+
+            lock.lock();
+            drawingIndex = -1;
+            ready.notify_all();
+            continue;
+        }
+
+        if (pauseRequested) {
+            backend->releaseCurrent(window);
+            paused = true;
+            ready.notify_all();
+            wake.wait(lock, [&] { return !pauseRequested || stopping; });
+            paused = false;
+            if (pauseRequested) return; // parou pausado, o contexto fica com quem chamou stop()
+
+            lock.unlock();
+            backend->makeCurrent(window);
+            lock.lock();
+            continue;
+        }
+
+        if (stopping) break;
+    }
+    lock.unlock();
+    backend->releaseCurrent(window);
+}
@@ -0,0 +1,75 @@
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include "frame_packet.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct SDL_Window;
+class Renderer;
+
+// Submits frames on a dedicated thread so the simulation of frame N+1 overlaps
+// with the API calls of frame N. The simulation fills one of two packets while
+// the render thread draws the other; at most one finished packet waits in
+// between, so input latency grows by a single frame.
+//
+// The graphics context belongs to the render thread while it runs. Anything
+// that creates or destroys GPU resources (scene loads, frame capture) goes
+// between pause() and resume(), which hand the context to the calling thread.
+class RenderThread {
+  private:
+    Renderer* renderer = nullptr;
+    SDL_Window* window = nullptr;
+
+    FramePacket packets[2];
+    int writeIndex = 0;     // packet sendo preenchido pela simulacao
+    int pendingIndex = -1;  // publicado, ainda nao pego pelo render
+    int drawingIndex = -1;  // sendo desenhado agora
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;  // acorda o render thread
+    std::condition_variable ready; // acorda a simulacao
+    bool running = false;
+    bool stopping = false;
+    bool pauseRequested = false;
+    bool paused = false;
+
+    std::function<void()> frameRendered;
+    std::atomic<double> lastSubmitMs{0.0};
+
+    void threadLoop();
+
+  public:
+    ~RenderThread();
+
+    // Sem start() os frames sao desenhados no proprio submitFrame()
+    void setRenderer(Renderer& renderer, SDL_Window* window);
+    // Chamar no thread que criou o contexto, depois de carregar a cena inicial
+    bool start();
+    // Desenha o que ainda estiver pendente e devolve o contexto a quem chama
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Packet livre para a simulacao; espera se o render ainda estiver nele
+    FramePacket& beginFrame();
+    // Publica o packet de beginFrame() e troca de buffer
+    void submitFrame();
+    // Espera todos os packets publicados terminarem de ser desenhados
+    void flush();
+
+    void pause();
+    void resume();
+
+    // Roda no render thread entre submit e present (ex.: readback de captura)
+    void setFrameRenderedCallback(std::function<void()> callback) {
+        frameRendered = std::move(callback);
+    }
+    // Tempo gasto no ultimo submit + present, medido no render thread
+    double getLastSubmitMs() const { return lastSubmitMs.load(std::memory_order_relaxed); }
+};
+
+#endif // RENDER_THREAD_HPP
@@ -3,6 +3,9 @@
 
 #include "../game_object.hpp"
 #include "../material.hpp"
+#include "../profiler.hpp"
+#include "../stats.hpp"
+#include "frustum.hpp"
 #include "../log_macros.hpp"
 #include "renderer_factory.hpp"
 #include "renderer.hpp"
@@ -10,21 +13,44 @@
 #include <cstdio>
 
 Renderer::~Renderer() {
+    // Texturas e shaders antes do backend que os criou
+    textures.clear();
+    shaders.clear();
     if (backend) {
         delete backend;
     }
 }
 
-void Renderer::setRendererBackend(RendererBackend* backend) { this->backend = backend; }
+void Renderer::setRendererBackend(RendererBackend* backend) {
+    this->backend = backend;
+    textures.setRendererBackend(backend);
+    shaders.setRendererBackend(backend);
+    if (backend) {
+        backend->setTextureManager(&textures);
+        backend->setShaderCache(&shaders);
+    }
+}
 
 RendererBackend* Renderer::getRendererBackend() { return backend; }
 
+void Renderer::setJobSystem(Yume::JobSystem* jobs) {
+    jobSystem = jobs;
+    if (backend) {
+        backend->setJobSystem(jobs);
+    }
+}
+
 bool Renderer::initBackend(const GraphicsAPI& graphicsApi) {
     backend = RendererFactory::create(graphicsApi);
     if (!backend) {
         LOG_ERROR("Unsupported graphics API!");
         return false;
     }
+    backend->setJobSystem(jobSystem);
+    backend->setTextureManager(&textures);
+    backend->setShaderCache(&shaders);
+    textures.setRendererBackend(backend);
+    shaders.setRendererBackend(backend);
 
     return true;
 }
@@ -37,26 +63,87 @@ bool Renderer::initWindow(SDL_Window* win) {
     return false;
 }
 
+bool Renderer::initHeadless(int width, int height) {
+    if (backend) {
+        return backend->initHeadless(width, height);
+    }
+
+    return false;
+}
+
 void Renderer::render(const Scene& scene) {
+    PROFILE_SCOPE("Renderer::render");
 
-    if (!backend) {
-        LOG_ERROR("Can not render without a renderer backend!");
-        return;
+    if (buildFramePacket(scene, framePacket)) {
+        submitFramePacket(framePacket);
     }
+}
+
+bool Renderer::buildFramePacket(const Scene& scene, FramePacket& packet) {
+    PROFILE_SCOPE("BuildFramePacket");
 
-    if (!scene.getCamera()) {
+    packet.reset();
+    packet.frameIndex = Stats::getFrameIndex();
+    packet.hasCamera = scene.getCamera() != nullptr;
+    if (!packet.hasCamera) {
         LOG_WARN("Scene doesn't have a main camera to render!");
+        return false;
+    }
+
+    const Camera* camera = scene.getCamera();
+    packet.camera.copyParametersFrom(*camera);
+    if (scene.getLights()) {
+        packet.lights = *scene.getLights();
+    } else {
+        packet.lights.clear();
+    }
+    packet.lightBuffer.pack(packet.lights);
+    packet.lightClusters.build(packet.lights, camera->getViewMatrix(),
+                               camera->getProjectionMatrix(), camera->getNearDistance(),
+                               camera->getFarDistance(), jobSystem);
+    // Sem passe de sombra no backend as cascatas ficam inativas (reset) e o
+    // shader ve zero cascatas
+    if (backend && backend->supportsShadows()) {
+        packet.shadows.fit(packet.lights, camera->getViewMatrix(),
+                           camera->getProjectionMatrix(), camera->getNearDistance(),
+                           camera->getFarDistance());
+    }
+    packet.lightBuffer.packShadows(packet.shadows);
+
+    if (scene.getGameObjects()) {
+        Frustum frustum =
+            Frustum::fromMatrix(camera->getProjectionMatrix() * camera->getViewMatrix());
+        packet.queue.build(*scene.getGameObjects(), cullingEnabled ? &frustum : nullptr,
+                           jobSystem, &packet.shadows);
+        Stats::add(Stat::CULLED_OBJECTS, packet.queue.getCulledCount());
+    }
+    Stats::add(Stat::FRAME_ARENA_BYTES, packet.arena.getUsed());
+    return true;
+}
+
+void Renderer::submitFramePacket(const FramePacket& packet) {
+    PROFILE_SCOPE("SubmitFramePacket");
+
+    if (!backend) {
+        LOG_ERROR("Can not render without a renderer backend!");
         return;
     }
+    if (!packet.hasCamera) return;
+
+    // O backend guarda o ponteiro; a copia do packet vive ate o proximo submit
+    Camera* camera = const_cast<Camera*>(&packet.camera);
+    backend->setCamera(camera);
 
     // Order is important here
 
-    backend->bindCamera(scene.getCamera());
+    backend->bindCamera(camera);
 
-    backend->clear(scene.getCamera());
+    backend->clear(camera);
 
-    backend->renderGameObjects(const_cast<std::vector<GameObject*>*>(scene.getGameObjects()),
-                               const_cast<std::vector<Light>*>(scene.getLights()));
+    backend->submitShadows(packet.shadows);
+    backend->submitLights(packet.lightBuffer);
+    backend->submitLightClusters(packet.lightClusters);
+    backend->submitQueue(packet.queue, const_cast<std::vector<Light>*>(&packet.lights));
 }
 
 void Renderer::present(SDL_Window* window) {
@@ -4,6 +4,10 @@
 #include "../game_object.hpp"
 #include "../graphics_api.hpp"
 #include "../scene.hpp"
+#include "../shader_cache.hpp"
+#include "../texture_manager.hpp"
+#include "frame_packet.hpp"
+#include "render_queue.hpp"
 #include "renderer_backend.hpp"
 
 class Material;
@@ -11,6 +15,11 @@ class Material;
 class Renderer{
 private: 
     RendererBackend* backend = nullptr;
+    FramePacket framePacket; // usado por render(scene), sem render thread
+    bool cullingEnabled = true;
+    Yume::JobSystem* jobSystem = nullptr;
+    TextureManager textures;
+    ShaderCache shaders;
 
 public:
     ~Renderer();
@@ -18,10 +27,25 @@ public:
     RendererBackend* getRendererBackend();
     bool initBackend(const GraphicsAPI& graphicsApi);
     bool initWindow(SDL_Window* win);
+    bool initHeadless(int width, int height);
     void preRender();
     void render(const std::vector<GameObject*>* objects);
     void render(const Scene& scene);
     void present(SDL_Window* window);
+
+    // Simulacao: copia camera, luzes e a fila cullada da cena para o packet.
+    // Retorna false quando a cena nao tem camera.
+    bool buildFramePacket(const Scene& scene, FramePacket& packet);
+    // Render: desenha um packet ja montado; so le o packet, nunca a cena
+    void submitFramePacket(const FramePacket& packet);
+
+    void setCullingEnabled(bool enabled) { cullingEnabled = enabled; }
+    // Repassado ao backend; a montagem da fila tambem passa a rodar em paralelo
+    void setJobSystem(Yume::JobSystem* jobs);
+    Yume::JobSystem* getJobSystem() const { return jobSystem; }
+    TextureManager& getTextureManager() { return textures; }
+    ShaderCache& getShaderCache() { return shaders; }
+    const RenderQueue& getRenderQueue() const { return framePacket.queue; }
 };
 
 #endif // RENDERER_HPP
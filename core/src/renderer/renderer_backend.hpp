@@ -6,22 +6,52 @@
 #include "../graphics_api.hpp"
 #include "../light.hpp"
 #include "../mesh.hpp"
+#include "../present_mode.hpp"
+#include "../shader_cache.hpp"
 #include "../shader_program.hpp"
 #include "../sprite.hpp"
+#include "../texture_manager.hpp"
+#include "light_buffer.hpp"
+#include "light_clusters.hpp"
+#include "render_queue.hpp"
+#include "shadow_cascades.hpp"
+#include "sampler_desc.hpp"
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 struct SDL_Window;
 
+namespace Yume {
+class JobSystem;
+}
+
 class RendererBackend {
   protected:
     Camera* mainCamera = nullptr;
     std::vector<Light> lights;
+    PresentMode presentMode = PresentMode::FIFO;
+    unsigned int swapchainImageCount = 0;
+    bool headless = false;
+    unsigned int readbackSlotCount = 3;
+    Yume::JobSystem* jobSystem = nullptr;
+    TextureManager* textureManager = nullptr;
+    ShaderCache* shaderCache = nullptr;
+    bool textureStreaming = false;
+
+    // Id do TextureManager (o que o Sprite guarda) -> textura deste backend
+    unsigned int resolveTexture(unsigned int id) {
+        return textureManager ? textureManager->resolve(id) : id;
+    }
 
   public:
     virtual ~RendererBackend() = default;
 
-    virtual unsigned int loadTexture(const std::string& path, uint8_t filterType = 0) = 0;
+    virtual unsigned int loadTexture(const std::string& path,
+                                     const SamplerDesc& sampler = SamplerDesc()) = 0;
+    virtual void deleteTexture(unsigned int textureID) = 0;
+    // Memoria de GPU da textura, para o orcamento do TextureManager
+    virtual size_t getTextureBytes(unsigned int textureID) const = 0;
     virtual void drawSprite(const Sprite& sprite) = 0;
     virtual bool init() = 0;
     virtual bool init(SDL_Window* window) = 0;
@@ -44,21 +74,94 @@ class RendererBackend {
     virtual void renderGameObjects(std::vector<GameObject*>* gameObjects,
                                    std::vector<Light>* lights) = 0;
 
+    // Desenha uma fila ja montada (e cullada) pelo Renderer. O padrao so liga o
+    // material e desenha, para backends sem caminho proprio (sem matriz model).
+    virtual void submitQueue(const RenderQueue& queue, std::vector<Light>* /*lights*/) {
+        for (const DrawItem& item : queue.getItems()) {
+            item.material->use();
+            applyMaterial(item.material);
+            if (item.sprite) {
+                drawSprite(*item.sprite);
+            } else if (item.mesh) {
+                draw(*item.mesh);
+            }
+        }
+    }
+
+    // Passe de profundidade das cascatas, uma vez por frame antes de submitQueue;
+    // tem que deixar o framebuffer e o viewport da camera como achou. Backends
+    // sem sombra ignoram e devolvem false em supportsShadows(): o Renderer nem
+    // ajusta as cascatas e o LightData sai com zero, sem amostrar o mapa.
+    virtual void submitShadows(const ShadowCascades& /*shadows*/) {}
+    virtual bool supportsShadows() const { return false; }
+    // Todas as luzes da cena, uma vez por frame antes de submitQueue; os
+    // materiais so leem o bloco LightData, nada de luz sobe por draw
+    virtual void submitLights(const LightBuffer& lights) = 0;
+    // Luzes point/spot ja binadas pelo Renderer; chamado uma vez por frame, antes
+    // de submitQueue. Backends sem luz em clusters ignoram.
+    virtual void submitLightClusters(const LightClusters& /*clusters*/) {}
+
     virtual void renderSkybox(const Mesh& mesh, unsigned int shaderProgram,
                               unsigned int textureID) = 0;
 
     virtual void setBufferDataImpl(const std::string& name, const void* data, size_t size) = 0;
+
+    // Renderiza num alvo offscreen do tamanho pedido, sem janela nem superficie
+    virtual bool initHeadless(int /*width*/, int /*height*/) { return false; }
+    bool isHeadless() const { return headless; }
+
+    // Agenda a copia do frame atual para a CPU; chamar entre render e present.
+    // Retorna false quando todos os slots do ring ainda estao esperando a GPU.
+    virtual bool requestReadback() { return false; }
+    // Nao bloqueia: entrega a copia pendente mais antiga se a GPU ja terminou
+    // (RGBA8, primeira linha no topo)
+    virtual bool pollReadback(std::vector<uint8_t>& /*pixels*/, int& /*width*/, int& /*height*/) {
+        return false;
+    }
+    // Copias aceitas que pollReadback ainda vai entregar; um submit que falhou
+    // nao conta
+    virtual size_t getPendingReadbacks() const { return 0; }
+    // Mais slots = mais frames de latencia tolerados antes de descartar capturas
+    void setReadbackSlotCount(unsigned int count) { readbackSlotCount = count > 0 ? count : 1; }
     template <typename T> void setBufferData(const std::string& name, const T* data) {
         setBufferDataImpl(name, static_cast<const void*>(data), sizeof(T));
     }
 
     Camera* getCamera() { return mainCamera; }
 
+    // Passa o contexto da API para o thread que chama (render thread, ou de
+    // volta ao principal para criar recursos). So o OpenGL tem contexto por thread.
+    virtual bool makeCurrent(SDL_Window* /*window*/) { return true; }
+    virtual void releaseCurrent(SDL_Window* /*window*/) {}
+
+    // Opcional; sem job system o backend grava tudo no thread que chama
+    void setJobSystem(Yume::JobSystem* jobs) { jobSystem = jobs; }
+    Yume::JobSystem* getJobSystem() const { return jobSystem; }
+
+    // Dono das texturas de sprite; o Renderer liga o dele aqui
+    void setTextureManager(TextureManager* textures) { textureManager = textures; }
+    TextureManager* getTextureManager() const { return textureManager; }
+
+    // Variantes de shader ja compiladas; o Renderer liga o dele aqui
+    void setShaderCache(ShaderCache* shaders) { shaderCache = shaders; }
+    ShaderCache* getShaderCache() const { return shaderCache; }
+
+    // Texturas baked abrem so com os mips pequenos e o resto chega em segundo
+    // plano conforme o tamanho na tela. Vale para o que for carregado depois.
+    void setTextureStreaming(bool enabled) { textureStreaming = enabled; }
+    bool isTextureStreaming() const { return textureStreaming; }
+
     void setCamera(Camera* camera) {
         mainCamera = camera;
         onCameraSet();
     }
 
+    // Precisa ser chamado antes de init(SDL_Window*)
+    void setPresentMode(PresentMode mode, unsigned int imageCount = 0) {
+        presentMode = mode;
+        swapchainImageCount = imageCount;
+    }
+
     void setLights(const std::vector<Light>& sceneLights) { lights = sceneLights; }
     const std::vector<Light>& getLights() const { return lights; }
 };
@@ -1,4 +1,5 @@
 #include "renderer_factory.hpp"
+#include "backends/null/null_renderer_backend.hpp"
 
 #ifdef PLATFORM_WEBGL
     #include "backends/webgl/web_gl_renderer_backend.hpp"
@@ -41,6 +42,9 @@ RendererBackend* RendererFactory::create(const GraphicsAPI& api) {
             return nullptr;
         #endif
 
+        case GraphicsAPI::NULL_BACKEND:
+            return new NullRendererBackend();
+
         default:
             return nullptr;
     }
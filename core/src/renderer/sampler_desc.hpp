@@ -0,0 +1,21 @@
+#ifndef SAMPLER_DESC_HPP
+#define SAMPLER_DESC_HPP
+
+#include <cstdint>
+
+enum class TextureFilter : uint8_t {
+    NEAREST = 0,   // pixel art: mip mais proximo, sem interpolacao
+    LINEAR = 1,    // bilinear dentro do mip mais proximo
+    TRILINEAR = 2, // bilinear interpolando entre dois mips
+};
+
+// How a texture is sampled. Backends keep one sampler object per distinct
+// description and share it between every texture that asks for it.
+struct SamplerDesc {
+    TextureFilter filter = TextureFilter::NEAREST;
+    uint8_t maxAnisotropy = 1; // 1 = desligado; limitado ao maximo do driver
+
+    uint32_t key() const { return (uint32_t)filter << 8 | maxAnisotropy; }
+};
+
+#endif // SAMPLER_DESC_HPP
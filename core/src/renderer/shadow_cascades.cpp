@@ -0,0 +1,205 @@
+#include "shadow_cascades.hpp"
+#include "../frame_memory.hpp"
+#include "../profiler.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+void ShadowCascades::setArena(LinearArena* arena) {
+    runs = ArenaVector<Run>(ArenaAllocator<Run>(arena));
+    instanceModels = ArenaVector<glm::mat4>(ArenaAllocator<glm::mat4>(arena));
+}
+
+void ShadowCascades::clear() {
+    if (runs.get_allocator().arena) {
+        runs = ArenaVector<Run>(runs.get_allocator());
+        instanceModels = ArenaVector<glm::mat4>(instanceModels.get_allocator());
+    } else {
+        runs.clear();
+        instanceModels.clear();
+    }
+    candidates = ArenaVector<Candidate>();
+    cascadeMasks = ArenaVector<uint8_t>();
+    cascadeCount = 0;
+}
+
+void ShadowCascades::fit(const std::vector<Light>& sceneLights, const glm::mat4& view,
+                         const glm::mat4& projection, float nearDistance, float farDistance) {
+    cascadeCount = 0;
+
+    const Light* light = nullptr;
+    for (const Light& candidate : sceneLights) {
+        if (candidate.type == LightType::DIRECTIONAL && candidate.castShadows) {
+            light = &candidate;
+            break;
+        }
+    }
+    if (!light || nearDistance <= 0.0f || farDistance <= nearDistance) return;
+
+    glm::vec3 direction(light->direction.x, light->direction.y, light->direction.z);
+    float shadowFar = std::min(farDistance, light->shadowDistance);
+    if (glm::dot(direction, direction) < 1e-8f || shadowFar <= nearDistance) return;
+    direction = glm::normalize(direction);
+    bias = light->shadowBias;
+    uint32_t count = std::clamp<uint32_t>(light->shadowCascades, 1, MAX_CASCADES);
+    float lambda = std::clamp(light->shadowSplitLambda, 0.0f, 1.0f);
+
+    // Raios dos cantos da tela em view space (near -> far do clip), como nos
+    // froxels do LightClusters; vale para perspectiva e ortografica
+    glm::mat4 inverseProjection = glm::inverse(projection);
+    glm::mat4 inverseView = glm::inverse(view);
+    auto unproject = [&](float x, float y, float z) {
+        glm::vec4 p = inverseProjection * glm::vec4(x, y, z, 1.0f);
+        return glm::vec3(p) / p.w;
+    };
+    glm::vec3 rayNear[4], ray[4];
+    for (int corner = 0; corner < 4; corner++) {
+        float x = corner & 1 ? 1.0f : -1.0f;
+        float y = corner & 2 ? 1.0f : -1.0f;
+        rayNear[corner] = unproject(x, y, -1.0f);
+        ray[corner] = unproject(x, y, 1.0f) - rayNear[corner];
+    }
+
+    // A luz olha ao longo da direcao; o up so precisa nao ser paralelo a ela
+    glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f)
+                                                      : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+
+    float begin = nearDistance;
+    for (uint32_t i = 0; i < count; i++) {
+        // Mistura das divisoes uniforme e logaritmica (practical split scheme)
+        float t = (float)(i + 1) / count;
+        float uniformSplit = nearDistance + (shadowFar - nearDistance) * t;
+        float logSplit = nearDistance * std::pow(shadowFar / nearDistance, t);
+        float end = uniformSplit + (logSplit - uniformSplit) * lambda;
+
+        glm::vec3 corners[8];
+        glm::vec3 center(0.0f);
+        for (int corner = 0; corner < 4; corner++) {
+            float depths[2] = {begin, end};
+            for (int d = 0; d < 2; d++) {
+                float along = (-depths[d] - rayNear[corner].z) / ray[corner].z;
+                glm::vec3 p = rayNear[corner] + ray[corner] * along;
+                corners[corner * 2 + d] = glm::vec3(inverseView * glm::vec4(p, 1.0f));
+                center += corners[corner * 2 + d];
+            }
+        }
+        center /= 8.0f;
+
+        // Esfera em vez de caixa: o tamanho nao muda quando a camera gira, e o
+        // centro preso a grade de texels nao deixa a borda da sombra tremer
+        float radius = 0.0f;
+        for (const glm::vec3& corner : corners) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+        float texel = 2.0f * radius / MAP_SIZE;
+        glm::vec3 lightCenter = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+        lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+        lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+
+        glm::mat4 lightProjection =
+            glm::ortho(lightCenter.x - radius, lightCenter.x + radius, lightCenter.y - radius,
+                       lightCenter.y + radius, -lightCenter.z - radius, -lightCenter.z + radius);
+        cascades[i].viewProjection = lightProjection * lightRotation;
+        cascades[i].splitDepth = end;
+        cascades[i].firstRun = 0;
+        cascades[i].runCount = 0;
+        cascades[i].instanceCount = 0;
+        frusta[i] = Frustum::fromMatrix(cascades[i].viewProjection);
+        begin = end;
+    }
+    cascadeCount = count;
+}
+
+void ShadowCascades::beginCasters(size_t objectCount) {
+    candidates = ArenaVector<Candidate>(objectCount, FrameMemory::allocator<Candidate>());
+    cascadeMasks = ArenaVector<uint8_t>(objectCount, 0, FrameMemory::allocator<uint8_t>());
+}
+
+void ShadowCascades::testCaster(size_t index, const Mesh& mesh, const glm::mat4& model,
+                                const glm::vec3& center, float radius) {
+    uint8_t mask = 0;
+    for (uint32_t i = 0; i < cascadeCount; i++) {
+        if (frusta[i].intersectsSphere(center, radius, false)) mask |= (uint8_t)(1u << i);
+    }
+    cascadeMasks[index] = mask;
+    if (!mask) return;
+
+    Candidate& candidate = candidates[index];
+    candidate.meshHandle = reinterpret_cast<uintptr_t>(mesh.getMeshBufferHandle());
+    candidate.mesh = &mesh;
+    candidate.model = model;
+}
+
+void ShadowCascades::endCasters() {
+    PROFILE_SCOPE("BuildShadowCasters");
+
+    // Agrupa por mesh com um counting sort em vez de ordenar: sao poucos meshes
+    // para muitos objetos. Uma tabela hash leva o handle ao grupo, os grupos
+    // saem em ordem de handle e, dentro de cada um, na ordem da cena, entao a
+    // mesma cena gera sempre os mesmos runs. A direcao da luz e uma so, e a
+    // mesma ordem serve para todas as cascatas.
+    const size_t objectCount = cascadeMasks.size();
+    uint32_t tableBits = 4;
+    while (((size_t)1 << tableBits) < 2 * objectCount) tableBits++;
+    const size_t tableMask = ((size_t)1 << tableBits) - 1;
+    ArenaVector<uint32_t> table(tableMask + 1, UINT32_MAX, FrameMemory::allocator<uint32_t>());
+    ArenaVector<uintptr_t> groupHandles(FrameMemory::allocator<uintptr_t>());
+    ArenaVector<uint32_t> groupCounts(FrameMemory::allocator<uint32_t>());
+    ArenaVector<uint32_t> groupOf(objectCount, 0, FrameMemory::allocator<uint32_t>());
+    size_t casterCount = 0, instanceTotal = 0;
+    for (size_t i = 0; i < objectCount; i++) {
+        if (!cascadeMasks[i]) continue;
+        uintptr_t handle = candidates[i].meshHandle;
+        size_t slot = (size_t)(((uint64_t)handle * 0x9E3779B97F4A7C15ull) >> (64 - tableBits));
+        while (table[slot] != UINT32_MAX && groupHandles[table[slot]] != handle) {
+            slot = (slot + 1) & tableMask;
+        }
+        if (table[slot] == UINT32_MAX) {
+            table[slot] = (uint32_t)groupHandles.size();
+            groupHandles.push_back(handle);
+            groupCounts.push_back(0);
+        }
+        groupOf[i] = table[slot];
+        groupCounts[table[slot]]++;
+        casterCount++;
+        for (uint8_t mask = cascadeMasks[i]; mask; mask &= mask - 1) instanceTotal++;
+    }
+
+    ArenaVector<uint32_t> groups(groupHandles.size(), 0, FrameMemory::allocator<uint32_t>());
+    for (uint32_t g = 0; g < groups.size(); g++) groups[g] = g;
+    std::sort(groups.begin(), groups.end(),
+              [&](uint32_t a, uint32_t b) { return groupHandles[a] < groupHandles[b]; });
+    ArenaVector<uint32_t> groupOffsets(groups.size(), 0, FrameMemory::allocator<uint32_t>());
+    uint32_t offset = 0;
+    for (uint32_t g : groups) {
+        groupOffsets[g] = offset;
+        offset += groupCounts[g];
+    }
+    ArenaVector<uint32_t> order(casterCount, 0, FrameMemory::allocator<uint32_t>());
+    for (uint32_t i = 0; i < objectCount; i++) {
+        if (cascadeMasks[i]) order[groupOffsets[groupOf[i]]++] = i;
+    }
+
+    instanceModels.reserve(instanceModels.size() + instanceTotal);
+    for (uint32_t c = 0; c < cascadeCount; c++) {
+        Cascade& cascade = cascades[c];
+        cascade.firstRun = (uint32_t)runs.size();
+        cascade.instanceCount = 0;
+        for (uint32_t i : order) {
+            if (!(cascadeMasks[i] & (1u << c))) continue;
+            const Candidate& candidate = candidates[i];
+            if (runs.size() == cascade.firstRun || runs.back().mesh != candidate.mesh) {
+                runs.push_back(Run{candidate.mesh, (uint32_t)instanceModels.size(), 0});
+            }
+            runs.back().count++;
+            instanceModels.push_back(candidate.model);
+            cascade.instanceCount++;
+        }
+        cascade.runCount = (uint32_t)runs.size() - cascade.firstRun;
+    }
+
+    candidates = ArenaVector<Candidate>();
+    cascadeMasks = ArenaVector<uint8_t>();
+}
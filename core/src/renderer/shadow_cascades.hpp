@@ -0,0 +1,89 @@
+#ifndef SHADOW_CASCADES_HPP
+#define SHADOW_CASCADES_HPP
+
+#include "../light.hpp"
+#include "../linear_arena.hpp"
+#include "../mesh.hpp"
+#include "frustum.hpp"
+#include "light_buffer.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cascaded shadow maps for the first directional light with castShadows. The
+// camera range up to Light::shadowDistance is split into cascades, each with a
+// texel-snapped orthographic projection fitted around its slice of the view
+// frustum.
+//
+// Casters are not culled in a pass of their own: RenderQueue::build tests every
+// mesh against all cascades while it already has the world bounds for camera
+// culling. The survivors are grouped once by mesh, and each cascade becomes a
+// few instanced runs (one per mesh) over a single array of model matrices, so
+// the depth pass does one draw per mesh and cascade instead of one per object.
+class ShadowCascades {
+  public:
+    static constexpr uint32_t MAX_CASCADES = LightBuffer::MAX_SHADOW_CASCADES;
+    static constexpr uint32_t MAP_SIZE = 2048; // texels por lado de cada camada
+
+    // Desenho instanciado de um mesh: instanceModels[first, first + count)
+    struct Run {
+        const Mesh* mesh;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct Cascade {
+        glm::mat4 viewProjection;
+        float splitDepth; // profundidade (view space, positiva) onde a cascata termina
+        uint32_t firstRun;
+        uint32_t runCount;
+        uint32_t instanceCount;
+    };
+
+    // Com arena os runs e as matrizes so valem ate a arena ser resetada;
+    // clear() solta o armazenamento e precisa vir antes do reset
+    void setArena(LinearArena* arena);
+    void clear();
+
+    // Escolhe a luz e ajusta as cascatas a camera; sem luz com sombra fica inativo
+    void fit(const std::vector<Light>& sceneLights, const glm::mat4& view,
+             const glm::mat4& projection, float nearDistance, float farDistance);
+    bool isActive() const { return cascadeCount > 0; }
+
+    // Chamados pelo RenderQueue::build. testCaster roda nos jobs do culling,
+    // cada um no proprio indice; endCasters ordena e monta os runs.
+    void beginCasters(size_t objectCount);
+    void testCaster(size_t index, const Mesh& mesh, const glm::mat4& model,
+                    const glm::vec3& center, float radius);
+    void endCasters();
+
+    uint32_t getCascadeCount() const { return cascadeCount; }
+    const Cascade& getCascade(uint32_t i) const { return cascades[i]; }
+    const ArenaVector<Run>& getRuns() const { return runs; }
+    const ArenaVector<glm::mat4>& getInstanceModels() const { return instanceModels; }
+    float getBias() const { return bias; }
+
+  private:
+    struct Candidate {
+        uintptr_t meshHandle; // o que o passe de profundidade troca entre draws
+        const Mesh* mesh;
+        glm::mat4 model;
+    };
+
+    Cascade cascades[MAX_CASCADES] = {};
+    uint32_t cascadeCount = 0;
+    float bias = 0.0f;
+    // Planos das cascatas sem o near: quem esta entre a luz e a cascata ainda
+    // projeta sombra, e o passe achata a profundidade deles (depth clamp)
+    Frustum frusta[MAX_CASCADES];
+
+    ArenaVector<Run> runs;
+    ArenaVector<glm::mat4> instanceModels;
+
+    // Rascunho do frame (FrameMemory) entre beginCasters e endCasters
+    ArenaVector<Candidate> candidates;
+    ArenaVector<uint8_t> cascadeMasks; // bit i = toca a cascata i
+};
+
+#endif // SHADOW_CASCADES_HPP
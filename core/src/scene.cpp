@@ -1,10 +1,9 @@
 #include "scene.hpp"
+#include <algorithm>
 
 Scene::~Scene() {
+    // Os objetos sao do storage, que libera tudo por slab no proprio destrutor
     if (gameObjects) {
-        for (GameObject* obj : *gameObjects) {
-            delete obj;
-        }
         delete gameObjects;
     }
 
@@ -47,4 +46,26 @@ std::vector<Light>* Scene::getLights() {
 
 const std::vector<Light>* Scene::getLights() const { 
     return lights; 
-};
\ No newline at end of file
+};
+
+GameObject* Scene::createGameObject(GameObjectHandle* handle) {
+    GameObjectHandle created = storage.createGameObject();
+    GameObject* gameObject = storage.getGameObject(created);
+    if (!gameObjects) {
+        gameObjects = new std::vector<GameObject*>();
+    }
+    gameObjects->push_back(gameObject);
+    if (handle) *handle = created;
+    return gameObject;
+}
+
+void Scene::destroyGameObject(GameObjectHandle handle) {
+    GameObject* gameObject = storage.getGameObject(handle);
+    if (!gameObject) return;
+
+    if (gameObjects) {
+        gameObjects->erase(std::remove(gameObjects->begin(), gameObjects->end(), gameObject),
+                           gameObjects->end());
+    }
+    storage.destroyGameObject(handle);
+}
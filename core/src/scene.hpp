@@ -4,12 +4,15 @@
 #include "camera.hpp"
 #include "game_object.hpp"
 #include "light.hpp"
+#include "scene_storage.hpp"
 
 class Scene {
   private:
     Camera* mainCamera = nullptr;
     std::vector<GameObject*>* gameObjects = nullptr;
     std::vector<Light>* lights = nullptr;
+    // Dona dos GameObjects e componentes; gameObjects so lista os vivos
+    SceneStorage storage;
 
   public:
     ~Scene();
@@ -23,6 +26,11 @@ class Scene {
     void setLights(std::vector<Light>* l);
     std::vector<Light>* getLights();
     const std::vector<Light>* getLights() const;
+
+    SceneStorage& getStorage() { return storage; }
+    // Cria no storage e ja coloca na lista de objetos da cena
+    GameObject* createGameObject(GameObjectHandle* handle = nullptr);
+    void destroyGameObject(GameObjectHandle handle);
 };
 
 #endif
\ No newline at end of file
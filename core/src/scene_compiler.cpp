@@ -1,16 +1,49 @@
 #include "color.hpp"
 #include "scene_format.hpp"
+#include "shader_features.hpp"
+#include "texture_baker.hpp"
 #include "vector3.hpp"
+#include <algorithm>
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 using json = nlohmann::json;
 
+// Imagens lidas nesta compilacao, para o depfile do build
+std::vector<std::string> bakedSources;
+
+// O .ytex fica ao lado da imagem original; o runtime procura por ele e cai no
+// decode da imagem se nao existir
+void bakeTexture(const std::string& path, const json& options) {
+    bakedSources.push_back(path);
+    TextureBaker::BakeOptions bakeOptions;
+    bakeOptions.compress = options.value("compress", true);
+    bakeOptions.mipmaps = options.value("mipmaps", true);
+    TextureBaker::bake(path, bakedTexturePath(path), bakeOptions);
+}
+
+// "features": ["LIT", "TEXTURED"] -> ShaderKey; o build precisa ter a variante
+// listada no .variants de cada shader
+uint32_t compileShaderFeatures(const json& material) {
+    uint32_t key = 0;
+    for (const std::string& name : material.value("features", std::vector<std::string>())) {
+        ShaderKey bit = ShaderFeature::fromName(name);
+        if (!bit) {
+            std::cerr << "Unknown shader feature: " << name << std::endl;
+        }
+        key |= bit;
+    }
+    return key;
+}
+
 void compileCamera(CompiledScene& scene, const json& cam) {
     for (int i = 0; i < 4; i++)
         scene.camera.background_color[i] = cam["background_color"][i];
@@ -36,11 +69,13 @@ void compileCamera(CompiledScene& scene, const json& cam) {
         std::snprintf(scene.camera.skybox.material.fragmentShaderPath,
                       sizeof(scene.camera.skybox.material.fragmentShaderPath), "%s",
                       fragPath.c_str());
+        scene.camera.skybox.material.features = compileShaderFeatures(skybox["material"]);
 
         for (int i = 0; i < 6; i++) {
             std::string texPath = skybox["cubeMapTextures"][i];
             std::snprintf(scene.camera.skybox.cubeMapTextures[i],
                           sizeof(scene.camera.skybox.cubeMapTextures[i]), "%s", texPath.c_str());
+            bakeTexture(texPath, skybox);
         }
     } else {
         scene.camera.hasSkybox = false;
@@ -53,8 +88,12 @@ void compileLights(CompiledScene& scene, const json& j) {
         return;
 
     auto& lights = j["lights"];
-    scene.lightCount = lights.size();
-    for (size_t i = 0; i < lights.size() && i < 32; i++) {
+    if (lights.size() > MAX_SCENE_LIGHTS) {
+        std::cerr << "Scene has " << lights.size() << " lights, keeping the first "
+                  << MAX_SCENE_LIGHTS << std::endl;
+    }
+    scene.lightCount = std::min<uint32_t>(lights.size(), MAX_SCENE_LIGHTS);
+    for (size_t i = 0; i < scene.lightCount; i++) {
         std::string type = lights[i]["type"];
         if (type == "DIRECTIONAL")
             scene.lights[i].type = 0;
@@ -65,15 +104,34 @@ void compileLights(CompiledScene& scene, const json& j) {
         else
             scene.lights[i].type = 0;
 
-        Vector3 direction;
-        direction.x = lights[i]["direction"][0];
-        direction.y = lights[i]["direction"][1];
-        direction.z = lights[i]["direction"][2];
+        // Point nao tem direcao
+        Vector3 direction = {0.0f, -1.0f, 0.0f};
+        if (lights[i].contains("direction")) {
+            direction.x = lights[i]["direction"][0];
+            direction.y = lights[i]["direction"][1];
+            direction.z = lights[i]["direction"][2];
+        }
         scene.lights[i].direction = direction;
         scene.lights[i].intensity = lights[i]["intensity"];
 
         for (int c = 0; c < 4; c++)
             scene.lights[i].color[c] = lights[i]["color"][c];
+
+        Vector3 position = {0.0f, 0.0f, 0.0f};
+        if (lights[i].contains("position")) {
+            position.x = lights[i]["position"][0];
+            position.y = lights[i]["position"][1];
+            position.z = lights[i]["position"][2];
+        }
+        scene.lights[i].position = position;
+        scene.lights[i].range = lights[i].value("range", 10.0f);
+        scene.lights[i].innerAngle = lights[i].value("innerAngle", 30.0f);
+        scene.lights[i].outerAngle = lights[i].value("outerAngle", 45.0f);
+        scene.lights[i].castShadows = lights[i].value("castShadows", false) ? 1 : 0;
+        scene.lights[i].shadowCascades = (uint8_t)lights[i].value("shadowCascades", 3);
+        scene.lights[i].shadowDistance = lights[i].value("shadowDistance", 50.0f);
+        scene.lights[i].shadowSplitLambda = lights[i].value("shadowSplitLambda", 0.75f);
+        scene.lights[i].shadowBias = lights[i].value("shadowBias", 0.002f);
     }
 }
 
@@ -96,6 +154,7 @@ void compileMeshRenderer(ComponentData& compData, const json& comp) {
                   fragPath.c_str());
 
     compData.meshRenderer.material.color = {color[0], color[1], color[2], color[3]};
+    compData.meshRenderer.material.features = compileShaderFeatures(comp["material"]);
 }
 
 void compileSpriteRenderer(ComponentData& compData, const json& comp) {
@@ -113,6 +172,8 @@ void compileSpriteRenderer(ComponentData& compData, const json& comp) {
     if (!stbi_info(texPath.c_str(), &width, &height, &channels)) {
         std::cerr << "Failed to read texture info: " << texPath << std::endl;
         width = height = 1;
+    } else {
+        bakeTexture(texPath, comp["texture"]);
     }
 
     std::snprintf(compData.spriteRenderer.texture.path,
@@ -121,7 +182,11 @@ void compileSpriteRenderer(ComponentData& compData, const json& comp) {
     compData.spriteRenderer.texture.width = static_cast<float>(width);
     compData.spriteRenderer.texture.height = static_cast<float>(height);
     compData.spriteRenderer.texture.scaleFactor = scaleFactor;
-    compData.spriteRenderer.texture.filterType = (filter == "LINEAR") ? 1 : 0;
+    compData.spriteRenderer.texture.filterType = (filter == "TRILINEAR") ? 2
+                                                 : (filter == "LINEAR")  ? 1
+                                                                         : 0;
+    compData.spriteRenderer.texture.maxAnisotropy =
+        (uint8_t)std::clamp(comp["texture"].value("anisotropy", 1), 1, 16);
 
     std::snprintf(compData.spriteRenderer.material.vertexShaderPath,
                   sizeof(compData.spriteRenderer.material.vertexShaderPath), "%s",
@@ -131,6 +196,7 @@ void compileSpriteRenderer(ComponentData& compData, const json& comp) {
                   fragPath.c_str());
 
     compData.spriteRenderer.material.color = {color[0], color[1], color[2], color[3]};
+    compData.spriteRenderer.material.features = compileShaderFeatures(comp["material"]);
 }
 
 void compileTransform(ComponentData& compData, const json& comp) {
@@ -195,5 +261,24 @@ int main(int argc, char* argv[]) {
     std::ofstream output(argv[2], std::ios::binary);
     output.write(reinterpret_cast<char*>(&scene), sizeof(CompiledScene));
 
+    // scene_compiler cena.scn cena.scnb --depfile cena.scnb.d: o build recompila
+    // (e refaz os .ytex) quando uma imagem da cena muda
+    if (argc >= 5 && std::string(argv[3]) == "--depfile") {
+        // Caminhos absolutos: o build le o depfile de outro diretorio
+        auto escape = [](const std::string& relative) {
+            std::string path = std::filesystem::absolute(relative).string();
+            for (size_t pos = 0; (pos = path.find(' ', pos)) != std::string::npos; pos += 2) {
+                path.insert(pos, 1, '\\');
+            }
+            return path;
+        };
+        std::ofstream depfile(argv[4]);
+        depfile << escape(argv[2]) << ": " << escape(argv[1]);
+        for (const std::string& source : bakedSources) {
+            depfile << " " << escape(source);
+        }
+        depfile << "\n";
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -10,13 +10,26 @@ struct LightData {
     Vector3 direction;
     float color[4];
     float intensity;
-    // float position[3];
+    Vector3 position;
+    float range;
+    float innerAngle; // graus, metade do cone (so spot)
+    float outerAngle;
+    uint8_t castShadows; // so direcional
+    uint8_t shadowCascades;
+    float shadowDistance;
+    float shadowSplitLambda;
+    float shadowBias;
 };
 
+// Point e spot sao baratos com os clusters; a cena aceita bem mais que as 32
+// luzes que cabiam antes
+constexpr uint32_t MAX_SCENE_LIGHTS = 256;
+
 struct MaterialData {
     char vertexShaderPath[256];
     char fragmentShaderPath[256];
     ColorRGBA color;
+    uint32_t features; // ShaderKey: bits de ShaderFeature, escolhe a variante
 };
 
 struct TextureData {
@@ -24,7 +37,8 @@ struct TextureData {
     float width;
     float height;
     float scaleFactor;
-    uint8_t filterType; // 0=NEAREST, 1=LINEAR
+    uint8_t filterType;    // 0=NEAREST, 1=LINEAR, 2=TRILINEAR
+    uint8_t maxAnisotropy; // 1 = desligado
 };
 
 struct MeshData {
@@ -87,7 +101,7 @@ struct CompiledScene {
     uint32_t gameObjectCount;
     GameObjectData gameObjects[32];
     uint32_t lightCount;
-    LightData lights[32];
+    LightData lights[MAX_SCENE_LIGHTS];
 };
 
 #endif
\ No newline at end of file
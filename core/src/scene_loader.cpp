@@ -4,130 +4,166 @@
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tinyobjloader/tiny_obj_loader.h"
 
+#include "job_system.hpp"
 #include "material.hpp"
 #include "mesh_renderer.hpp"
+#include "profiler.hpp"
 #include "renderer/renderer_backend.hpp"
 #include "scene_format.hpp"
 #include "scene_loader.hpp"
-#include "shader_asset.hpp"
+#include "shader_cache.hpp"
 #include "skybox.hpp"
 #include "stb_image.h"
+#include <algorithm>
 #include <fstream>
+#include <unordered_set>
+
+namespace {
+
+std::string meshKey(const char* path, bool shadeSmooth) {
+    return std::string(path) + (shadeSmooth ? "#smooth" : "#flat");
+}
+
+std::string materialKey(const MaterialData& data) {
+    std::string key = std::string(data.vertexShaderPath) + '#' + data.fragmentShaderPath + '#' +
+                      std::to_string(data.features) + '#';
+    key.append(reinterpret_cast<const char*>(&data.color), sizeof(data.color));
+    return key;
+}
+
+} // namespace
 
 SceneLoader::SceneLoader() : rendererBackend(nullptr) {}
 
 void SceneLoader::setRendererBackend(RendererBackend& backend) { rendererBackend = &backend; }
 
 CompiledScene* SceneLoader::loadCompiledScene(const std::string& filepath) {
+    PROFILE_SCOPE("ReadSceneFile");
     if (!validateSceneFile(filepath))
         return nullptr;
 
     std::ifstream file(filepath, std::ios::binary);
     auto scene = new CompiledScene();
     if (!file.read(reinterpret_cast<char*>(scene), sizeof(CompiledScene))) {
-        LOG_ERROR("Failed to read scene file: " + filepath);
+        LOG_ERROR("Failed to read scene file: %s", filepath.c_str());
         delete scene;
         return nullptr;
     }
 
-    LOG_INFO("Loaded scene with " + std::to_string(scene->gameObjectCount) + " game objects");
+    LOG_INFO("Loaded scene with %u game objects", scene->gameObjectCount);
 
     return scene;
 }
 
-void SceneLoader::loadTransformComponent(GameObject* gameObject, const ComponentData& comp) {
-    auto transform = std::make_unique<Transform>();
+void SceneLoader::loadTransformComponent(SceneStorage& storage, GameObject* gameObject,
+                                         const ComponentData& comp) {
+    Transform* transform = storage.addTransform(gameObject);
     transform->setPosition(comp.transform.position);
     transform->setRotation(comp.transform.rotation);
     transform->setScale(comp.transform.scale);
-    gameObject->setTransform(std::move(transform));
 }
 
-void SceneLoader::loadMeshRendererComponent(GameObject* gameObject, const ComponentData& comp) {
+void SceneLoader::loadMeshRendererComponent(SceneStorage& storage, GameObject* gameObject,
+                                            const ComponentData& comp) {
     auto& meshData = comp.meshRenderer.mesh;
     auto& materialData = comp.meshRenderer.material;
 
-    auto mesh = loadObjMesh(meshData.path, meshData.shadeSmooth);
+    std::shared_ptr<Mesh> mesh;
+    auto decoded = decodedMeshes.find(meshKey(meshData.path, meshData.shadeSmooth));
+    if (decoded != decodedMeshes.end()) {
+        mesh = decoded->second;
+    } else {
+        mesh = loadObjMesh(meshData.path, meshData.shadeSmooth);
+    }
     if (!mesh) {
-        LOG_ERROR("Failed to load mesh: " + std::string(meshData.path));
+        LOG_ERROR("Failed to load mesh: %s", meshData.path);
         return;
     }
-    mesh->setMeshBuffer(rendererBackend->createMeshBuffer());
-    mesh->configure();
-
-    auto shaderExt = rendererBackend->getShaderExtension();
-    auto vertexShader = std::make_unique<ShaderAsset>(materialData.vertexShaderPath + shaderExt,
-                                                      ShaderType::VERTEX);
-    vertexShader->setShaderCompiler(rendererBackend->createShaderCompiler());
-
-    auto fragmentShader = std::make_unique<ShaderAsset>(materialData.fragmentShaderPath + shaderExt,
-                                                        ShaderType::FRAGMENT);
-    fragmentShader->setShaderCompiler(rendererBackend->createShaderCompiler());
-
-    auto material = std::make_unique<Material>();
-    material->setShaderProgram(rendererBackend->createShaderProgram());
-    material->setVertexShader(std::move(vertexShader));
-    material->setFragmentShader(std::move(fragmentShader));
-    material->setBaseColor(materialData.color);
+    // Objetos com o mesmo .obj compartilham a malha; o upload acontece uma vez
+    if (!mesh->getMeshBuffer()) {
+        mesh->setMeshBuffer(rendererBackend->createMeshBuffer());
+        mesh->configure();
+    }
 
-    if (!material->init()) {
-        LOG_ERROR("Material init failed for mesh: " + std::string(meshData.path));
+    std::shared_ptr<Material> material = acquireMaterial(materialData);
+    if (!material) {
+        LOG_ERROR("Material init failed for mesh: %s", meshData.path);
         return;
     }
 
-    auto meshRenderer = std::make_unique<MeshRenderer>();
-    meshRenderer->setMaterial(std::move(material));
+    MeshRenderer* meshRenderer = storage.addMeshRenderer(gameObject);
+    meshRenderer->setMaterial(material);
 
     gameObject->setMesh(std::move(mesh));
-    gameObject->setMeshRenderer(std::move(meshRenderer));
 }
 
-void SceneLoader::loadSpriteRendererComponent(GameObject* gameObject, const ComponentData& comp) {
+void SceneLoader::loadSpriteRendererComponent(SceneStorage& storage, GameObject* gameObject,
+                                              const ComponentData& comp) {
     auto& textureData = comp.spriteRenderer.texture;
     auto& materialData = comp.spriteRenderer.material;
 
     float width = textureData.width * textureData.scaleFactor;
     float height = textureData.height * textureData.scaleFactor;
-    auto sprite = std::make_unique<Sprite>(width, height);
+    SamplerDesc sampler;
+    sampler.filter = static_cast<TextureFilter>(textureData.filterType);
+    sampler.maxAnisotropy = textureData.maxAnisotropy;
+    // Mesmo caminho + sampler reaproveita a textura ja carregada
+    TextureHandle texture;
+    if (TextureManager* textures = rendererBackend->getTextureManager()) {
+        texture = textures->acquire(textureData.path, sampler);
+    } else {
+        LOG_WARN("No texture manager, sprite without texture: %s", textureData.path);
+    }
 
-    unsigned int texID = rendererBackend->loadTexture(textureData.path, textureData.filterType);
-    sprite->setTexture(texID);
+    std::shared_ptr<Material> material = acquireMaterial(materialData);
+    if (!material) {
+        LOG_ERROR("Material init failed for sprite: %s", textureData.path);
+        return;
+    }
+
+    Sprite* sprite = storage.addSprite(gameObject, width, height);
+    sprite->setTexture(std::move(texture));
+    SpriteRenderer* spriteRenderer = storage.addSpriteRenderer(gameObject);
+    spriteRenderer->setMaterial(material);
+}
 
-    auto shaderExt = rendererBackend->getShaderExtension();
-    auto vertexShader = std::make_unique<ShaderAsset>(materialData.vertexShaderPath + shaderExt,
-                                                      ShaderType::VERTEX);
-    vertexShader->setShaderCompiler(rendererBackend->createShaderCompiler());
+std::shared_ptr<Material> SceneLoader::acquireMaterial(const MaterialData& materialData) {
+    // Mesma variante e mesma cor: um programa so para todos os objetos
+    std::string key = materialKey(materialData);
+    auto loaded = loadedMaterials.find(key);
+    if (loaded != loadedMaterials.end()) {
+        return loaded->second;
+    }
 
-    auto fragmentShader = std::make_unique<ShaderAsset>(materialData.fragmentShaderPath + shaderExt,
-                                                        ShaderType::FRAGMENT);
-    fragmentShader->setShaderCompiler(rendererBackend->createShaderCompiler());
+    ShaderCache* shaders = rendererBackend->getShaderCache();
+    if (!shaders) {
+        LOG_ERROR("No shader cache, cannot load %s", materialData.vertexShaderPath);
+        return nullptr;
+    }
 
-    auto material = std::make_unique<Material>();
+    auto material = std::make_shared<Material>();
     material->setShaderProgram(rendererBackend->createShaderProgram());
-    material->setVertexShader(std::move(vertexShader));
-    material->setFragmentShader(std::move(fragmentShader));
+    material->setVertexShader(shaders->acquire(materialData.vertexShaderPath, ShaderType::VERTEX,
+                                               materialData.features));
+    material->setFragmentShader(shaders->acquire(materialData.fragmentShaderPath,
+                                                 ShaderType::FRAGMENT, materialData.features));
     material->setBaseColor(materialData.color);
-
     if (!material->init()) {
-        LOG_ERROR("Material init failed for sprite: " + std::string(textureData.path));
-        return;
+        material = nullptr;
     }
-
-    auto spriteRenderer = std::make_unique<SpriteRenderer>();
-    spriteRenderer->setMaterial(std::move(material));
-
-    gameObject->setSprite(std::move(sprite));
-    gameObject->setSpriteRenderer(std::move(spriteRenderer));
+    loadedMaterials.emplace(std::move(key), material);
+    return material;
 }
 
 std::unique_ptr<Mesh> SceneLoader::loadObjMesh(const std::string& filepath, bool shadeSmooth) {
+    PROFILE_SCOPE("LoadObjMesh");
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
     std::string warn, err;
 
     if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &err, filepath.c_str())) {
-        LOG_ERROR("Unable to load obj: " + filepath);
+        LOG_ERROR("Unable to load obj: %s", filepath.c_str());
         return nullptr;
     }
 
@@ -217,24 +253,21 @@ Camera* SceneLoader::loadCamera(const CompiledScene* scene) {
     
     camera->setOrthographic(cam.orthographic);
     camera->setOrthoSize(cam.orthoSize);
-    LOG_INFO("Camera orthoSize loaded: " + std::to_string(cam.orthoSize));
+    LOG_INFO("Camera orthoSize loaded: %f", cam.orthoSize);
 
     if (cam.hasSkybox) {
         auto skybox = std::make_unique<Skybox>();
 
-        auto shaderExt = rendererBackend->getShaderExtension();
-        auto skyboxVertexShaderPtr = std::make_unique<ShaderAsset>(
-            cam.skybox.material.vertexShaderPath + shaderExt, ShaderType::VERTEX);
-        skyboxVertexShaderPtr->setShaderCompiler(rendererBackend->createShaderCompiler());
-
-        auto skyboxFragmentShaderPtr = std::make_unique<ShaderAsset>(
-            cam.skybox.material.fragmentShaderPath + shaderExt, ShaderType::FRAGMENT);
-        skyboxFragmentShaderPtr->setShaderCompiler(rendererBackend->createShaderCompiler());
-
+        const MaterialData& materialData = cam.skybox.material;
+        ShaderCache* shaders = rendererBackend->getShaderCache();
         auto skyboxMaterial = std::make_unique<Material>();
         skyboxMaterial->setShaderProgram(rendererBackend->createShaderProgram());
-        skyboxMaterial->setVertexShader(std::move(skyboxVertexShaderPtr));
-        skyboxMaterial->setFragmentShader(std::move(skyboxFragmentShaderPtr));
+        if (shaders) {
+            skyboxMaterial->setVertexShader(shaders->acquire(
+                materialData.vertexShaderPath, ShaderType::VERTEX, materialData.features));
+            skyboxMaterial->setFragmentShader(shaders->acquire(
+                materialData.fragmentShaderPath, ShaderType::FRAGMENT, materialData.features));
+        }
         skyboxMaterial->init();
 
         std::vector<std::string> faces;
@@ -252,46 +285,117 @@ Camera* SceneLoader::loadCamera(const CompiledScene* scene) {
     return camera;
 }
 
-std::vector<GameObject*>* SceneLoader::loadGameObjects(const CompiledScene* scene) {
+void SceneLoader::loadGameObjects(const CompiledScene* scene, Scene& target) {
+    PROFILE_SCOPE("LoadGameObjects");
 
-    auto objects = new std::vector<GameObject*>();
+    LOG_INFO("Loading %u game objects", scene->gameObjectCount);
+
+    decodeMeshes(scene);
+
+    size_t meshRendererCount = 0, spriteRendererCount = 0;
+    for (uint32_t i = 0; i < scene->gameObjectCount; i++) {
+        const auto& goData = scene->gameObjects[i];
+        for (uint8_t j = 0; j < goData.componentCount; j++) {
+            ComponentType type = goData.components[j].type;
+            if (type == ComponentType::MESH_RENDERER) meshRendererCount++;
+            if (type == ComponentType::SPRITE_RENDERER) spriteRendererCount++;
+        }
+    }
 
-    LOG_INFO("Loading " + std::to_string(scene->gameObjectCount) + " game objects");
+    SceneStorage& storage = target.getStorage();
+    storage.reserve(scene->gameObjectCount, meshRendererCount, spriteRendererCount);
+    auto objects = new std::vector<GameObject*>();
+    objects->reserve(scene->gameObjectCount);
+    target.setGameObjects(objects);
 
     for (uint32_t i = 0; i < scene->gameObjectCount; i++) {
         auto& goData = scene->gameObjects[i];
-        auto gameObject = new GameObject();
+        GameObject* gameObject = target.createGameObject();
 
         for (uint8_t j = 0; j < goData.componentCount; j++) {
             auto& comp = goData.components[j];
 
             if (comp.type == ComponentType::MESH_RENDERER) {
                 LOG_INFO("Loading mesh renderer component");
-                loadMeshRendererComponent(gameObject, comp);
+                loadMeshRendererComponent(storage, gameObject, comp);
             } else if (comp.type == ComponentType::TRANSFORM) {
-                loadTransformComponent(gameObject, comp);
+                loadTransformComponent(storage, gameObject, comp);
             } else if (comp.type == ComponentType::SPRITE_RENDERER) {
-                loadSpriteRendererComponent(gameObject, comp);
+                loadSpriteRendererComponent(storage, gameObject, comp);
+            }
+        }
+    }
+
+    decodedMeshes.clear();
+    loadedMaterials.clear();
+}
+
+void SceneLoader::decodeMeshes(const CompiledScene* scene) {
+    PROFILE_SCOPE("DecodeMeshes");
+
+    struct Request {
+        std::string key;
+        const char* path;
+        bool shadeSmooth;
+        std::shared_ptr<Mesh> mesh;
+    };
+    std::vector<Request> requests;
+    std::unordered_set<std::string> seen;
+
+    for (uint32_t i = 0; i < scene->gameObjectCount; i++) {
+        auto& goData = scene->gameObjects[i];
+        for (uint8_t j = 0; j < goData.componentCount; j++) {
+            auto& comp = goData.components[j];
+            if (comp.type != ComponentType::MESH_RENDERER) continue;
+
+            auto& meshData = comp.meshRenderer.mesh;
+            std::string key = meshKey(meshData.path, meshData.shadeSmooth);
+            if (seen.insert(key).second) {
+                requests.push_back({std::move(key), meshData.path, meshData.shadeSmooth, nullptr});
             }
         }
+    }
 
-        objects->push_back(gameObject);
+    // Parse do .obj e montagem dos vertices so tocam CPU; cada arquivo vira um job
+    auto decode = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            requests[i].mesh = loadObjMesh(requests[i].path, requests[i].shadeSmooth);
+        }
+    };
+    Yume::JobSystem* jobs = rendererBackend ? rendererBackend->getJobSystem() : nullptr;
+    if (jobs) {
+        jobs->parallelFor(requests.size(), 1, decode);
+    } else {
+        decode(0, requests.size());
     }
 
-    return objects;
+    for (auto& request : requests) {
+        decodedMeshes[request.key] = std::move(request.mesh);
+    }
 }
 
 std::vector<Light>* SceneLoader::loadLights(const CompiledScene* scene) {
 
     auto lights = new std::vector<Light>();
 
-    for (uint32_t i = 0; i < scene->lightCount; i++) {
+    uint32_t count = std::min(scene->lightCount, MAX_SCENE_LIGHTS);
+    lights->reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
         Light light;
         light.type = static_cast<LightType>(scene->lights[i].type);
         light.direction = scene->lights[i].direction;
         light.color = {scene->lights[i].color[0], scene->lights[i].color[1],
                        scene->lights[i].color[2], scene->lights[i].color[3]};
         light.intensity = scene->lights[i].intensity;
+        light.position = scene->lights[i].position;
+        light.range = scene->lights[i].range;
+        light.innerAngle = scene->lights[i].innerAngle;
+        light.outerAngle = scene->lights[i].outerAngle;
+        light.castShadows = scene->lights[i].castShadows != 0;
+        light.shadowCascades = scene->lights[i].shadowCascades;
+        light.shadowDistance = scene->lights[i].shadowDistance;
+        light.shadowSplitLambda = scene->lights[i].shadowSplitLambda;
+        light.shadowBias = scene->lights[i].shadowBias;
         lights->push_back(light);
     }
 
@@ -301,7 +405,7 @@ std::vector<Light>* SceneLoader::loadLights(const CompiledScene* scene) {
 bool SceneLoader::validateSceneFile(const std::string& filepath) {
     std::ifstream file(filepath, std::ios::binary);
     if (!file.good()) {
-        LOG_ERROR("Scene file does not exist: " + filepath);
+        LOG_ERROR("Scene file does not exist: %s", filepath.c_str());
         return false;
     }
     return true;
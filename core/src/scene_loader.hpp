@@ -4,21 +4,33 @@
 #include "camera.hpp"
 #include "game_object.hpp"
 #include "light.hpp"
+#include "material.hpp"
 #include "mesh.hpp"
 #include "renderer/renderer_backend.hpp"
+#include "scene.hpp"
 #include "scene_format.hpp"
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class SceneLoader {
   private:
     RendererBackend* rendererBackend = nullptr;
+    // .obj ja decodificados por decodeMeshes(), por caminho + shadeSmooth
+    std::unordered_map<std::string, std::shared_ptr<Mesh>> decodedMeshes;
+    // Materiais iguais (variante e cor) criados nesta carga, ligados uma vez
+    std::unordered_map<std::string, std::shared_ptr<Material>> loadedMaterials;
 
     std::unique_ptr<Mesh> loadObjMesh(const std::string& filepath, bool shadeSmooth);
-    void loadTransformComponent(GameObject* gameObject, const ComponentData& comp);
-    void loadMeshRendererComponent(GameObject* gameObject, const ComponentData& comp);
-    void loadSpriteRendererComponent(GameObject* gameObject, const ComponentData& comp);
+    void decodeMeshes(const CompiledScene* scene);
+    std::shared_ptr<Material> acquireMaterial(const MaterialData& materialData);
+    void loadTransformComponent(SceneStorage& storage, GameObject* gameObject,
+                                const ComponentData& comp);
+    void loadMeshRendererComponent(SceneStorage& storage, GameObject* gameObject,
+                                   const ComponentData& comp);
+    void loadSpriteRendererComponent(SceneStorage& storage, GameObject* gameObject,
+                                     const ComponentData& comp);
 
   public:
     SceneLoader();
@@ -27,7 +39,8 @@ class SceneLoader {
     CompiledScene* loadCompiledScene(const std::string& filepath);
 
     Camera* loadCamera(const CompiledScene* scene);
-    std::vector<GameObject*>* loadGameObjects(const CompiledScene* scene);
+    // Cria os objetos no storage de `target`, em ordem, e os lista na cena
+    void loadGameObjects(const CompiledScene* scene, Scene& target);
     std::vector<Light>* loadLights(const CompiledScene* scene);
 };
 
@@ -1,6 +1,7 @@
 #define CLASS_NAME "SceneManager"
 #include "scene_manager.hpp"
 #include "log_macros.hpp"
+#include "profiler.hpp"
 #include "renderer/renderer_backend.hpp"
 #include "scene_loader.hpp"
 
@@ -19,9 +20,10 @@ Scene* SceneManager::getActiveScene() const { return activeScene; }
 
 // TODO: revisar esse delete
 void SceneManager::loadScene(const std::string& name) {
+    PROFILE_SCOPE("LoadScene");
     auto it = sceneRegistry.find(name);
     if (it == sceneRegistry.end()) {
-        LOG_WARN("Scene not found: " + name);
+        LOG_WARN("Scene not found: %s", name.c_str());
         return;
     }
 
@@ -37,11 +39,21 @@ void SceneManager::loadScene(const std::string& name) {
     
     activeScene->setCamera(sceneLoader.loadCamera(compiledScene));
     activeScene->setLights(sceneLoader.loadLights(compiledScene));
-    activeScene->setGameObjects(sceneLoader.loadGameObjects(compiledScene));
+    sceneLoader.loadGameObjects(compiledScene, *activeScene);
 
     delete compiledScene;
+
+    // A cena antiga ja soltou os handles; o que a nova nao reaproveitou sai da GPU
+    if (rendererBackend && rendererBackend->getTextureManager()) {
+        rendererBackend->getTextureManager()->purgeUnused();
+    }
+    // Idem para as variantes de shader: as que as duas cenas usam nao recompilam
+    if (rendererBackend && rendererBackend->getShaderCache()) {
+        rendererBackend->getShaderCache()->purgeUnused();
+    }
 }
 
 void SceneManager::setRendererBackend(RendererBackend& rendererBackend) {
+    this->rendererBackend = &rendererBackend;
     sceneLoader.setRendererBackend(rendererBackend);
 }
\ No newline at end of file
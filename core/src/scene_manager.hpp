@@ -13,6 +13,7 @@ class SceneManager {
     std::string activeSceneName;
     Scene* activeScene = nullptr;
     SceneLoader sceneLoader;
+    RendererBackend* rendererBackend = nullptr;
 
   public:
     ~SceneManager();
@@ -0,0 +1,80 @@
+#include "scene_storage.hpp"
+
+namespace {
+
+template <typename T> void release(ObjectPool<T>& pool, T* component) {
+    if (component) pool.destroy(pool.getHandle(component));
+}
+
+} // namespace
+
+SceneStorage::~SceneStorage() { clear(); }
+
+void SceneStorage::reserve(size_t objectCount, size_t meshRendererCount,
+                           size_t spriteRendererCount) {
+    gameObjects.reserve(objectCount);
+    transforms.reserve(objectCount);
+    meshRenderers.reserve(meshRendererCount);
+    sprites.reserve(spriteRendererCount);
+    spriteRenderers.reserve(spriteRendererCount);
+}
+
+GameObjectHandle SceneStorage::createGameObject() { return gameObjects.create(); }
+
+GameObject* SceneStorage::getGameObject(GameObjectHandle handle) const {
+    return gameObjects.get(handle);
+}
+
+void SceneStorage::destroyGameObject(GameObjectHandle handle) {
+    GameObject* gameObject = gameObjects.get(handle);
+    if (!gameObject) return;
+
+    release(transforms, gameObject->getTransform());
+    release(meshRenderers, gameObject->getMeshRenderer());
+    release(sprites, gameObject->getSprite());
+    release(spriteRenderers, gameObject->getSpriteRenderer());
+    gameObjects.destroy(handle);
+}
+
+Transform* SceneStorage::addTransform(GameObject* gameObject) {
+    release(transforms, gameObject->getTransform());
+    Transform* t = transforms.get(transforms.create());
+    gameObject->setTransform(t);
+    return t;
+}
+
+MeshRenderer* SceneStorage::addMeshRenderer(GameObject* gameObject) {
+    release(meshRenderers, gameObject->getMeshRenderer());
+    MeshRenderer* mr = meshRenderers.get(meshRenderers.create());
+    gameObject->setMeshRenderer(mr);
+    return mr;
+}
+
+Sprite* SceneStorage::addSprite(GameObject* gameObject, float width, float height) {
+    release(sprites, gameObject->getSprite());
+    Sprite* s = sprites.get(sprites.create(width, height));
+    gameObject->setSprite(s);
+    return s;
+}
+
+SpriteRenderer* SceneStorage::addSpriteRenderer(GameObject* gameObject) {
+    release(spriteRenderers, gameObject->getSpriteRenderer());
+    SpriteRenderer* sr = spriteRenderers.get(spriteRenderers.create());
+    gameObject->setSpriteRenderer(sr);
+    return sr;
+}
+
+void SceneStorage::clear() {
+    // Objetos primeiro: ainda apontam para os componentes, mas nao os usam ao morrer
+    gameObjects.clear();
+    transforms.clear();
+    meshRenderers.clear();
+    sprites.clear();
+    spriteRenderers.clear();
+}
+
+size_t SceneStorage::getSlabCount() const {
+    return gameObjects.getSlabCount() + transforms.getSlabCount() +
+           meshRenderers.getSlabCount() + sprites.getSlabCount() +
+           spriteRenderers.getSlabCount();
+}
@@ -0,0 +1,50 @@
+#ifndef SCENE_STORAGE_HPP
+#define SCENE_STORAGE_HPP
+
+#include "game_object.hpp"
+#include "mesh_renderer.hpp"
+#include "object_pool.hpp"
+#include "sprite.hpp"
+#include "sprite_renderer.hpp"
+#include "transform.hpp"
+
+using GameObjectHandle = PoolHandle<GameObject>;
+
+// Owns every GameObject and component of one scene, each type in its own pool,
+// so a loaded scene sits in a few contiguous slabs in load order and unloading
+// it frees slabs instead of individual objects. The add* helpers create the
+// component and attach it to the object in one step.
+class SceneStorage {
+  private:
+    ObjectPool<GameObject> gameObjects;
+    ObjectPool<Transform> transforms;
+    ObjectPool<MeshRenderer> meshRenderers;
+    ObjectPool<Sprite> sprites;
+    ObjectPool<SpriteRenderer> spriteRenderers;
+
+  public:
+    ~SceneStorage();
+
+    // Chamar antes do load com as contagens do arquivo de cena; cada objeto tem
+    // no maximo um componente de cada tipo
+    void reserve(size_t objectCount, size_t meshRendererCount, size_t spriteRendererCount);
+
+    GameObjectHandle createGameObject();
+    GameObject* getGameObject(GameObjectHandle handle) const;
+    // Destroi o objeto e os componentes dele; handles antigos passam a dar null
+    void destroyGameObject(GameObjectHandle handle);
+
+    // Um componente de cada tipo por objeto: repetir o add devolve o anterior ao pool
+    Transform* addTransform(GameObject* gameObject);
+    MeshRenderer* addMeshRenderer(GameObject* gameObject);
+    Sprite* addSprite(GameObject* gameObject, float width, float height);
+    SpriteRenderer* addSpriteRenderer(GameObject* gameObject);
+
+    // Libera tudo de uma vez (descarregar a cena)
+    void clear();
+
+    size_t getGameObjectCount() const { return gameObjects.size(); }
+    size_t getSlabCount() const;
+};
+
+#endif // SCENE_STORAGE_HPP
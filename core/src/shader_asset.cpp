@@ -15,7 +15,7 @@ bool ShaderAsset::load() {
         return true;
     }
 
-    LOG_ERROR("Shader compilation failed for: " + getPath());
+    LOG_ERROR("Shader compilation failed for: %s", getPath().c_str());
     return false;
 }
 
@@ -3,6 +3,7 @@
 
 #include "asset.hpp"
 #include "shader_compiler.hpp"
+#include "shader_reflection.hpp"
 #include <memory>
 
 
@@ -12,6 +13,7 @@ class ShaderAsset : public Asset {
     void* shaderHandle = nullptr;
     bool isCompiled = false;
     std::unique_ptr<ShaderCompiler> compiler;
+    ShaderReflection reflection;
 
   public:
     ShaderAsset(const std::string& path, ShaderType type);
@@ -24,6 +26,12 @@ class ShaderAsset : public Asset {
     ShaderType getType() const { return shaderType; }
 
     void setShaderCompiler(std::unique_ptr<ShaderCompiler>);
+
+    // Vazia quando nao ha .spv do shader (null, DXIL)
+    void setReflection(ShaderReflection shaderReflection) {
+        reflection = std::move(shaderReflection);
+    }
+    const ShaderReflection& getReflection() const { return reflection; }
 };
 
 #endif // SHADERASSET_HPP
@@ -0,0 +1,51 @@
+#define CLASS_NAME "ShaderCache"
+#include "log_macros.hpp"
+
+#include "renderer/renderer_backend.hpp"
+#include "shader_cache.hpp"
+
+std::shared_ptr<ShaderAsset> ShaderCache::acquire(const std::string& path, ShaderType type,
+                                                  ShaderKey key) {
+    if (!backend) {
+        LOG_ERROR("No renderer backend, cannot compile %s", path.c_str());
+        return nullptr;
+    }
+
+    std::string file = shaderVariantPath(path, key) + backend->getShaderExtension();
+    std::string lookup = file + '#' + std::to_string((int)type);
+    auto it = shaders.find(lookup);
+    if (it != shaders.end()) {
+        return it->second;
+    }
+
+    // A falha tambem fica no cache: a variante que o build nao gerou loga uma
+    // vez, nao uma por material
+    auto shader = std::make_shared<ShaderAsset>(file, type);
+    shader->setShaderCompiler(backend->createShaderCompiler());
+    if (!shader->load()) {
+        if (key) {
+            LOG_ERROR("Shader variant %s not built, list it in %s.variants", file.c_str(),
+                      path.c_str());
+        }
+        shader = nullptr;
+    } else {
+        // O build sempre deixa o .spv ao lado do .glsl; e dele que saem os
+        // bindings e tamanhos dos uniform blocks
+        ShaderReflection reflection;
+        if (reflection.loadFile(shaderVariantPath(path, key) + ".spv", type)) {
+            shader->setReflection(std::move(reflection));
+        }
+    }
+    shaders.emplace(lookup, shader);
+    return shader;
+}
+
+void ShaderCache::purgeUnused() {
+    for (auto it = shaders.begin(); it != shaders.end();) {
+        if (!it->second || it->second.use_count() == 1) {
+            it = shaders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
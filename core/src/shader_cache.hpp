@@ -0,0 +1,44 @@
+#ifndef SHADER_CACHE_HPP
+#define SHADER_CACHE_HPP
+
+#include "shader_asset.hpp"
+#include "shader_features.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class RendererBackend;
+
+// Compiles each shader variant once and shares it between materials. A variant
+// is (source path, stage, ShaderKey): the key selects the file the build
+// generated for that feature set, and the backend shader extension is added
+// here, so callers pass the same names as the scene ("default.vxs").
+//
+// Programs stay per material: MaterialData lives in the program, so sharing one
+// would share the color. Only the compile is skipped.
+class ShaderCache {
+  private:
+    RendererBackend* backend = nullptr;
+    // Arquivo da variante + estagio -> shader compilado
+    std::unordered_map<std::string, std::shared_ptr<ShaderAsset>> shaders;
+
+  public:
+    ShaderCache() = default;
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    void setRendererBackend(RendererBackend* rendererBackend) { backend = rendererBackend; }
+
+    // Ja carregado; nullptr quando a variante nao existe ou nao compila
+    std::shared_ptr<ShaderAsset> acquire(const std::string& path, ShaderType type,
+                                         ShaderKey key = 0);
+
+    // Solta as variantes que nenhum material usa mais
+    void purgeUnused();
+    // Precisa vir antes da destruicao do backend que compilou os shaders
+    void clear() { shaders.clear(); }
+    size_t size() const { return shaders.size(); }
+};
+
+#endif // SHADER_CACHE_HPP
@@ -1,5 +1,8 @@
 #include "shader_compiler_factory.hpp"
 
+#include "renderer/backends/null/null_shader_compiler.hpp"
+#include "renderer/backends/null/null_renderer_backend.hpp"
+
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_shader_compiler.hpp"
 #else
@@ -25,6 +28,8 @@ std::unique_ptr<ShaderCompiler> ShaderCompilerFactory::create(GraphicsAPI api, v
         return std::make_unique<D3D12ShaderCompiler>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NULL_BACKEND:
+        return std::make_unique<NullShaderCompiler>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
@@ -0,0 +1,45 @@
+#ifndef SHADER_FEATURES_HPP
+#define SHADER_FEATURES_HPP
+
+#include <cstdint>
+#include <string>
+
+// Compile-time shader features. A material asks for a set of them as a key, and
+// the build compiles one variant of the HLSL per key listed in the shader's
+// `.variants` file, with `FEATURE_<NAME>` defined for each set bit. Shaders
+// branch with #ifdef instead of at runtime. Both stages of a material use the
+// same key, so it has to be listed for the vertex and the fragment shader.
+//
+// The bit order is also in SHADER_FEATURES in CMakeLists.txt; keep both in sync.
+using ShaderKey = uint32_t;
+
+namespace ShaderFeature {
+
+enum : ShaderKey {
+    LIT = 1u << 0,        // luzes da cena, clusters e sombra
+    TEXTURED = 1u << 1,   // cor vem de textura
+    INSTANCED = 1u << 2,  // matriz do modelo por instancia
+    SKINNED = 1u << 3,    // ossos no vertex shader
+    ALPHA_TEST = 1u << 4, // discard abaixo do corte
+};
+
+constexpr uint32_t COUNT = 5;
+constexpr const char* NAMES[COUNT] = {"LIT", "TEXTURED", "INSTANCED", "SKINNED", "ALPHA_TEST"};
+
+// Bit do nome, como escrito nos .variants e na cena; 0 se nao existir
+inline ShaderKey fromName(const std::string& name) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+        if (name == NAMES[i]) return 1u << i;
+    }
+    return 0;
+}
+
+} // namespace ShaderFeature
+
+// "default.vxs" com a chave 5 -> "default.vxs.k5", o mesmo nome que o build da
+// a variante. A chave 0 e o proprio shader.
+inline std::string shaderVariantPath(const std::string& path, ShaderKey key) {
+    return key ? path + ".k" + std::to_string(key) : path;
+}
+
+#endif // SHADER_FEATURES_HPP
@@ -1,11 +1,16 @@
 #ifndef SHADER_PROGRAM_HPP
 #define SHADER_PROGRAM_HPP
 
+#include "shader_reflection.hpp"
 #include <cstddef>
 
 class ShaderAsset;
 
 class ShaderProgram {
+  protected:
+    // Blocos de todos os estagios anexados; vazio quando nenhum trouxe .spv
+    ShaderReflection reflection;
+
   public:
     virtual ~ShaderProgram() = default;
     virtual bool attachShader(const ShaderAsset& shader) = 0;
@@ -14,6 +19,8 @@ class ShaderProgram {
     virtual void setUniformBuffer(const char* name, const void* data, size_t size) = 0;
     virtual void* getHandle() const = 0;
     virtual bool isValid() const = 0;
+
+    const ShaderReflection& getReflection() const { return reflection; }
 };
 
 #endif // SHADERPROGRAM_HPP
\ No newline at end of file
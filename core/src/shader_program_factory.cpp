@@ -1,5 +1,8 @@
 #include "shader_program_factory.hpp"
 
+#include "renderer/backends/null/null_shader_program.hpp"
+#include "renderer/backends/null/null_renderer_backend.hpp"
+
 #ifdef PLATFORM_WEBGL
 #include "renderer/backends/webgl/web_gl_shader_program.hpp"
 #else
@@ -25,6 +28,8 @@ std::unique_ptr<ShaderProgram> ShaderProgramFactory::create(GraphicsAPI api, voi
         return std::make_unique<D3D12ShaderProgram>(static_cast<D3D12RendererBackend*>(context));
 #endif
 #endif
+    case GraphicsAPI::NULL_BACKEND:
+        return std::make_unique<NullShaderProgram>(static_cast<NullRendererBackend*>(context));
     default:
         return nullptr;
     }
@@ -0,0 +1,287 @@
+#define CLASS_NAME "ShaderReflection"
+#include "log_macros.hpp"
+
+#include "shader_reflection.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// So o pedaco da especificacao SPIR-V que descreve uniform blocks
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+enum Op : uint32_t {
+    OP_NAME = 5,
+    OP_MEMBER_NAME = 6,
+    OP_TYPE_INT = 21,
+    OP_TYPE_FLOAT = 22,
+    OP_TYPE_VECTOR = 23,
+    OP_TYPE_MATRIX = 24,
+    OP_TYPE_ARRAY = 28,
+    OP_TYPE_STRUCT = 30,
+    OP_TYPE_POINTER = 32,
+    OP_CONSTANT = 43,
+    OP_VARIABLE = 59,
+    OP_DECORATE = 71,
+    OP_MEMBER_DECORATE = 72,
+};
+
+enum Decoration : uint32_t {
+    DECORATION_BLOCK = 2,
+    DECORATION_ROW_MAJOR = 4,
+    DECORATION_ARRAY_STRIDE = 6,
+    DECORATION_MATRIX_STRIDE = 7,
+    DECORATION_BINDING = 33,
+    DECORATION_DESCRIPTOR_SET = 34,
+    DECORATION_OFFSET = 35,
+};
+
+constexpr uint32_t STORAGE_CLASS_UNIFORM = 2;
+
+struct Member {
+    std::string name;
+    uint32_t offset = 0;
+    uint32_t matrixStride = 0;
+    bool rowMajor = false;
+};
+
+// Tudo o que o modulo diz sobre um id
+struct Id {
+    uint32_t op = 0;
+    std::string name;
+    uint32_t words[3] = {}; // operandos do tipo: largura, componente, contagem...
+    std::vector<uint32_t> members; // tipos dos membros de um struct
+    std::vector<Member> memberInfo;
+    uint32_t constant = 0;
+    uint32_t binding = 0;
+    uint32_t set = 0;
+    uint32_t arrayStride = 0;
+    bool block = false;
+};
+
+std::string readString(const uint32_t* words, size_t count) {
+    const char* text = reinterpret_cast<const char*>(words);
+    return std::string(text, strnlen(text, count * sizeof(uint32_t)));
+}
+
+class Parser {
+  public:
+    std::vector<Id> ids;
+
+    // depth corta tipos ciclicos de um arquivo corrompido
+    uint32_t typeSize(uint32_t type, const Member* member, int depth = 0) const {
+        if (type >= ids.size() || depth > 16) return 0;
+        const Id& id = ids[type];
+        switch (id.op) {
+        case OP_TYPE_INT:
+        case OP_TYPE_FLOAT:
+            return id.words[0] / 8;
+        case OP_TYPE_VECTOR:
+            return typeSize(id.words[0], nullptr, depth + 1) * id.words[1];
+        case OP_TYPE_MATRIX: {
+            // A stride vem do membro; linhas ou colunas conforme a ordem
+            uint32_t columns = id.words[1];
+            uint32_t rows = id.words[0] < ids.size() ? ids[id.words[0]].words[1] : 0;
+            uint32_t stride = member && member->matrixStride ? member->matrixStride : 16;
+            return stride * (member && member->rowMajor ? rows : columns);
+        }
+        case OP_TYPE_ARRAY: {
+            uint32_t length = id.words[1] < ids.size() ? ids[id.words[1]].constant : 0;
+            uint32_t stride =
+                id.arrayStride ? id.arrayStride : typeSize(id.words[0], member, depth + 1);
+            return stride * length;
+        }
+        case OP_TYPE_STRUCT: {
+            uint32_t end = 0;
+            for (size_t i = 0; i < id.members.size(); i++) {
+                const Member& info = id.memberInfo[i];
+                end = std::max(end, info.offset + typeSize(id.members[i], &info, depth + 1));
+            }
+            return end;
+        }
+        default:
+            return 0;
+        }
+    }
+};
+
+} // namespace
+
+bool ShaderReflection::parse(const uint32_t* words, size_t wordCount, ShaderType type) {
+    blocks.clear();
+    if (wordCount < 5 || words[0] != SPIRV_MAGIC) {
+        return false;
+    }
+
+    Parser parser;
+    const uint32_t bound = words[3];
+    if (bound > wordCount * 4) return false; // id bound absurdo: arquivo corrompido
+    parser.ids.resize(bound);
+    auto id = [&](uint32_t index) -> Id* { return index < bound ? &parser.ids[index] : nullptr; };
+    auto member = [&](Id* type, uint32_t index) -> Member* {
+        if (!type || index >= 1024) return nullptr;
+        if (type->memberInfo.size() <= index) type->memberInfo.resize(index + 1);
+        return &type->memberInfo[index];
+    };
+
+    std::vector<uint32_t> variables;
+    for (size_t pos = 5; pos < wordCount;) {
+        uint32_t count = words[pos] >> 16;
+        uint32_t op = words[pos] & 0xFFFF;
+        if (count == 0 || pos + count > wordCount) {
+            LOG_WARN("Truncated SPIR-V instruction at word %zu", pos);
+            return false;
+        }
+        const uint32_t* operands = words + pos + 1;
+        uint32_t operandCount = count - 1;
+
+        switch (op) {
+        case OP_NAME:
+            if (operandCount >= 2) {
+                if (Id* target = id(operands[0])) {
+                    target->name = readString(operands + 1, operandCount - 1);
+                }
+            }
+            break;
+        case OP_MEMBER_NAME:
+            if (operandCount >= 3) {
+                if (Member* info = member(id(operands[0]), operands[1])) {
+                    info->name = readString(operands + 2, operandCount - 2);
+                }
+            }
+            break;
+        case OP_DECORATE:
+            if (operandCount >= 2) {
+                Id* target = id(operands[0]);
+                if (!target) break;
+                uint32_t value = operandCount >= 3 ? operands[2] : 0;
+                if (operands[1] == DECORATION_BLOCK) target->block = true;
+                if (operands[1] == DECORATION_BINDING) target->binding = value;
+                if (operands[1] == DECORATION_DESCRIPTOR_SET) target->set = value;
+                if (operands[1] == DECORATION_ARRAY_STRIDE) target->arrayStride = value;
+            }
+            break;
+        case OP_MEMBER_DECORATE:
+            if (operandCount >= 3) {
+                Member* info = member(id(operands[0]), operands[1]);
+                if (!info) break;
+                uint32_t value = operandCount >= 4 ? operands[3] : 0;
+                if (operands[2] == DECORATION_OFFSET) info->offset = value;
+                if (operands[2] == DECORATION_MATRIX_STRIDE) info->matrixStride = value;
+                if (operands[2] == DECORATION_ROW_MAJOR) info->rowMajor = true;
+            }
+            break;
+        case OP_TYPE_INT:
+        case OP_TYPE_FLOAT:
+        case OP_TYPE_VECTOR:
+        case OP_TYPE_MATRIX:
+        case OP_TYPE_ARRAY:
+        case OP_TYPE_POINTER:
+            if (Id* target = operandCount ? id(operands[0]) : nullptr) {
+                target->op = op;
+                for (uint32_t i = 1; i < operandCount && i <= 3; i++) {
+                    target->words[i - 1] = operands[i];
+                }
+            }
+            break;
+        case OP_TYPE_STRUCT:
+            if (Id* target = operandCount ? id(operands[0]) : nullptr) {
+                target->op = op;
+                target->members.assign(operands + 1, operands + operandCount);
+                target->memberInfo.resize(target->members.size());
+            }
+            break;
+        case OP_CONSTANT:
+            if (operandCount >= 3) {
+                if (Id* target = id(operands[1])) target->constant = operands[2];
+            }
+            break;
+        case OP_VARIABLE:
+            if (operandCount >= 3 && operands[2] == STORAGE_CLASS_UNIFORM) {
+                if (Id* target = id(operands[1])) {
+                    target->op = op;
+                    target->words[0] = operands[0]; // tipo ponteiro
+                    variables.push_back(operands[1]);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+        pos += count;
+    }
+
+    for (uint32_t index : variables) {
+        const Id& variable = parser.ids[index];
+        const Id* pointer = id(variable.words[0]);
+        if (!pointer || pointer->op != OP_TYPE_POINTER) continue;
+        uint32_t structIndex = pointer->words[1];
+        const Id* blockType = id(structIndex);
+        if (!blockType || blockType->op != OP_TYPE_STRUCT || !blockType->block) continue;
+
+        ShaderBlock block;
+        block.name = variable.name;
+        if (block.name.empty()) {
+            // dxc chama o struct de "type_<cbuffer>"
+            const std::string& typeName = blockType->name;
+            block.name = typeName.compare(0, 5, "type_") == 0 ? typeName.substr(5) : typeName;
+        }
+        block.set = variable.set;
+        block.binding = variable.binding;
+        block.size = (parser.typeSize(structIndex, nullptr) + 15) & ~15u;
+        block.stages = stageBit(type);
+        for (size_t i = 0; i < blockType->members.size(); i++) {
+            const Member& info = blockType->memberInfo[i];
+            block.members.push_back(
+                {info.name, info.offset, parser.typeSize(blockType->members[i], &info)});
+        }
+        blocks.push_back(std::move(block));
+    }
+    return true;
+}
+
+bool ShaderReflection::loadFile(const std::string& path, ShaderType type) {
+    blocks.clear();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamsize bytes = file.tellg();
+    std::vector<uint32_t> words((size_t)std::max<std::streamsize>(bytes, 0) / sizeof(uint32_t));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint32_t))) {
+        return false;
+    }
+    if (!parse(words.data(), words.size(), type)) {
+        LOG_WARN("Not a SPIR-V module: %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ShaderReflection::merge(const ShaderReflection& other) {
+    bool consistent = true;
+    for (const ShaderBlock& block : other.blocks) {
+        auto it = std::find_if(blocks.begin(), blocks.end(),
+                               [&](const ShaderBlock& b) { return b.name == block.name; });
+        if (it == blocks.end()) {
+            blocks.push_back(block);
+            continue;
+        }
+        if (it->binding != block.binding || it->set != block.set || it->size != block.size) {
+            LOG_WARN("Block %s differs between stages (binding %u/%u, %u/%u bytes)",
+                     block.name.c_str(), it->binding, block.binding, it->size, block.size);
+            consistent = false;
+        }
+        it->stages |= block.stages;
+    }
+    return consistent;
+}
+
+const ShaderBlock* ShaderReflection::findBlock(const std::string& name) const {
+    for (const ShaderBlock& block : blocks) {
+        if (block.name == name) return &block;
+    }
+    return nullptr;
+}
@@ -0,0 +1,53 @@
+#ifndef SHADER_REFLECTION_HPP
+#define SHADER_REFLECTION_HPP
+
+#include "shader_type.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ShaderBlockMember {
+    std::string name;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+// Um cbuffer/uniform block como o SPIR-V declara
+struct ShaderBlock {
+    std::string name; // nome do cbuffer no HLSL, sem o "type_" do dxc
+    uint32_t set = 0;
+    uint32_t binding = 0; // register(bN) do HLSL
+    uint32_t size = 0;    // bytes no buffer, arredondado a 16 como no std140
+    uint32_t stages = 0;  // ShaderReflection::stageBit de cada estagio que usa
+    std::vector<ShaderBlockMember> members;
+};
+
+// Uniform blocks read from a SPIR-V module: binding, size and member offsets,
+// straight from the decorations dxc emits. Programs merge the tables of their
+// stages at link time, so backends size buffers and set up bindings from what
+// the shader really declares; nothing is looked up by name while drawing.
+class ShaderReflection {
+  private:
+    std::vector<ShaderBlock> blocks;
+
+  public:
+    static uint32_t stageBit(ShaderType type) { return 1u << (uint32_t)type; }
+
+    // Falha (e fica vazio) se as palavras nao forem um modulo SPIR-V valido
+    bool parse(const uint32_t* words, size_t wordCount, ShaderType type);
+    // O .spv que o build gera ao lado do shader; sem o arquivo fica vazio
+    bool loadFile(const std::string& path, ShaderType type);
+
+    // Junta os blocos de outro estagio; false se o mesmo bloco tem outro
+    // binding ou tamanho
+    bool merge(const ShaderReflection& other);
+    void clear() { blocks.clear(); }
+
+    bool empty() const { return blocks.empty(); }
+    const std::vector<ShaderBlock>& getBlocks() const { return blocks; }
+    // Para o setup; nao usar por draw
+    const ShaderBlock* findBlock(const std::string& name) const;
+};
+
+#endif // SHADER_REFLECTION_HPP
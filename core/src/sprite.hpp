@@ -1,17 +1,21 @@
 #ifndef SPRITE_HPP
 #define SPRITE_HPP
 
+#include "texture_manager.hpp"
+#include <utility>
+
 class Sprite {
   private:
-    unsigned int textureID = 0;
+    TextureHandle texture;
     float width = 1.0f;
     float height = 1.0f;
 
   public:
     Sprite(float w = 1.0f, float h = 1.0f) : width(w), height(h) {}
 
-    void setTexture(unsigned int texID) { textureID = texID; }
-    unsigned int getTexture() const { return textureID; }
+    void setTexture(TextureHandle handle) { texture = std::move(handle); }
+    // Id no TextureManager; o backend resolve para a textura dele ao desenhar
+    unsigned int getTexture() const { return texture.getId(); }
     float getWidth() const { return width; }
     float getHeight() const { return height; }
 };
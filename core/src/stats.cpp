@@ -0,0 +1,108 @@
+#define CLASS_NAME "Stats"
+#include "log_macros.hpp"
+
+#include "stats.hpp"
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+std::array<std::atomic<int64_t>, Stats::COUNT> g_values{};
+// Escritos pelo main thread em endFrame(), lidos pelo overlay no render thread
+std::array<std::atomic<int64_t>, Stats::COUNT> g_lastFrame{};
+std::atomic<double> g_lastFrameMs{0.0};
+uint64_t g_frameIndex = 0;
+
+std::FILE* g_csv = nullptr;
+uint32_t g_csvInterval = 1;
+
+std::atomic<bool> g_overlayVisible{false};
+
+const char* const NAMES[Stats::COUNT] = {
+    "draw_calls",        "triangles",         "program_binds",          "ubo_uploads",
+    "ubo_bytes",         "texture_binds",     "culled_objects",         "gpu_allocations",
+    "frame_arena_bytes", "texture_evictions", "texture_streamed_bytes", "shadow_draws",
+    "asset_queue_depth", "texture_resident_bytes",
+};
+
+size_t index(Stat stat) { return static_cast<size_t>(stat); }
+
+} // namespace
+
+void Stats::add(Stat stat, int64_t value) {
+    g_values[index(stat)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void Stats::set(Stat stat, int64_t value) {
+    g_values[index(stat)].store(value, std::memory_order_relaxed);
+}
+
+int64_t Stats::get(Stat stat) { return g_values[index(stat)].load(std::memory_order_relaxed); }
+
+const char* Stats::getName(Stat stat) { return NAMES[index(stat)]; }
+
+bool Stats::isGauge(Stat stat) { return stat >= Stat::ASSET_QUEUE_DEPTH; }
+
+void Stats::endFrame(double frameMs) {
+    Snapshot snapshot;
+    for (size_t i = 0; i < COUNT; i++) {
+        if (isGauge(static_cast<Stat>(i))) {
+            snapshot[i] = g_values[i].load(std::memory_order_relaxed);
+        } else {
+            snapshot[i] = g_values[i].exchange(0, std::memory_order_relaxed);
+        }
+        g_lastFrame[i].store(snapshot[i], std::memory_order_relaxed);
+    }
+    g_lastFrameMs.store(frameMs, std::memory_order_relaxed);
+
+    if (g_csv && g_frameIndex % g_csvInterval == 0) {
+        std::fprintf(g_csv, "%llu,%.3f", (unsigned long long)g_frameIndex, frameMs);
+        for (int64_t value : snapshot) {
+            std::fprintf(g_csv, ",%lld", (long long)value);
+        }
+        std::fputc('\n', g_csv);
+    }
+    g_frameIndex++;
+}
+
+Stats::Snapshot Stats::getLastFrame() {
+    Snapshot snapshot;
+    for (size_t i = 0; i < COUNT; i++) {
+        snapshot[i] = g_lastFrame[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+double Stats::getLastFrameMs() { return g_lastFrameMs.load(std::memory_order_relaxed); }
+
+uint64_t Stats::getFrameIndex() { return g_frameIndex; }
+
+bool Stats::startCsv(const char* path, uint32_t everyNFrames) {
+    stopCsv();
+
+    g_csv = std::fopen(path, "w");
+    if (!g_csv) {
+        LOG_ERROR("Failed to open %s", path);
+        return false;
+    }
+    g_csvInterval = everyNFrames > 0 ? everyNFrames : 1;
+
+    std::fputs("frame,frame_ms", g_csv);
+    for (const char* name : NAMES) {
+        std::fprintf(g_csv, ",%s", name);
+    }
+    std::fputc('\n', g_csv);
+
+    LOG_INFO("Writing stats to %s every %u frame(s)", path, g_csvInterval);
+    return true;
+}
+
+void Stats::stopCsv() {
+    if (!g_csv) return;
+    std::fclose(g_csv);
+    g_csv = nullptr;
+}
+
+void Stats::setOverlayVisible(bool visible) { g_overlayVisible = visible; }
+
+bool Stats::isOverlayVisible() { return g_overlayVisible.load(std::memory_order_relaxed); }
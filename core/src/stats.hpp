@@ -0,0 +1,57 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class Stat : uint8_t {
+    // Counters: somados durante o frame e zerados em endFrame()
+    DRAW_CALLS,
+    TRIANGLES,
+    PROGRAM_BINDS,
+    UBO_UPLOADS,
+    UBO_BYTES,
+    TEXTURE_BINDS,
+    CULLED_OBJECTS,
+    GPU_ALLOCATIONS,
+    FRAME_ARENA_BYTES,
+    TEXTURE_EVICTIONS,
+    TEXTURE_STREAMED_BYTES,
+    SHADOW_DRAWS, // draws instanciados do passe de sombra, fora de DRAW_CALLS
+    // Gauges: mantem o valor entre frames
+    ASSET_QUEUE_DEPTH,
+    TEXTURE_RESIDENT_BYTES,
+    COUNT
+};
+
+// Process-wide renderer counters. add()/set() are lock-free and may be called
+// from any thread; endFrame() snapshots and resets the counters once per frame
+// on the main thread and optionally appends the snapshot to a CSV file. The
+// last-frame getters are safe to call from the render thread.
+class Stats {
+  public:
+    static constexpr size_t COUNT = static_cast<size_t>(Stat::COUNT);
+    using Snapshot = std::array<int64_t, COUNT>;
+
+    static void add(Stat stat, int64_t value = 1);
+    static void set(Stat stat, int64_t value);
+    static int64_t get(Stat stat); // valor do frame em andamento
+
+    static const char* getName(Stat stat);
+    static bool isGauge(Stat stat);
+
+    static void endFrame(double frameMs);
+    static Snapshot getLastFrame(); // copia; cada valor e lido atomicamente
+    static double getLastFrameMs();
+    static uint64_t getFrameIndex();
+
+    // Writes one row every `everyNFrames` frames until stopCsv().
+    static bool startCsv(const char* path, uint32_t everyNFrames = 1);
+    static void stopCsv();
+
+    static void setOverlayVisible(bool visible);
+    static bool isOverlayVisible();
+};
+
+#endif // STATS_HPP
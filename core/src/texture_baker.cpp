@@ -0,0 +1,284 @@
+#include "texture_baker.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+using Block = uint8_t[16][4];
+
+void fetchBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by,
+                Block& block) {
+    for (uint32_t y = 0; y < 4; y++) {
+        uint32_t sy = std::min(by * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; x++) {
+            uint32_t sx = std::min(bx * 4 + x, width - 1);
+            const uint8_t* src = rgba + ((size_t)sy * width + sx) * 4;
+            std::copy(src, src + 4, block[y * 4 + x]);
+        }
+    }
+}
+
+uint16_t to565(const uint8_t* c) {
+    return (uint16_t)(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 |
+                      ((c[2] * 31 + 127) / 255));
+}
+
+void from565(uint16_t v, int* c) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+void putU16(uint8_t* out, uint16_t v) {
+    out[0] = v & 0xFF;
+    out[1] = v >> 8;
+}
+
+// Extremos ao longo do eixo principal (iteracao de potencia na covariancia),
+// bem melhor que a diagonal da bounding box em gradientes
+void encodeColorBlock(const Block& block, uint8_t* out) {
+    float mean[3] = {0, 0, 0};
+    for (const auto& p : block) {
+        for (int c = 0; c < 3; c++) mean[c] += p[c];
+    }
+    for (float& m : mean) m /= 16.0f;
+
+    float cov[6] = {0, 0, 0, 0, 0, 0}; // rr rg rb gg gb bb
+    for (const auto& p : block) {
+        float r = p[0] - mean[0], g = p[1] - mean[1], b = p[2] - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+    }
+
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int i = 0; i < 4; i++) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = std::max({std::fabs(x), std::fabs(y), std::fabs(z)});
+        if (len < 1e-6f) break; // bloco de cor unica
+        axis[0] = x / len;
+        axis[1] = y / len;
+        axis[2] = z / len;
+    }
+
+    int minIdx = 0, maxIdx = 0;
+    float minDot = INFINITY, maxDot = -INFINITY;
+    for (int i = 0; i < 16; i++) {
+        float d = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+        if (d < minDot) {
+            minDot = d;
+            minIdx = i;
+        }
+        if (d > maxDot) {
+            maxDot = d;
+            maxIdx = i;
+        }
+    }
+
+    uint16_t c0 = to565(block[maxIdx]);
+    uint16_t c1 = to565(block[minIdx]);
+    if (c0 < c1) std::swap(c0, c1);
+    putU16(out, c0);
+    putU16(out + 2, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        // c0 > c1 garante o modo de 4 cores tambem no BC1
+        int palette[4][3];
+        from565(c0, palette[0]);
+        from565(c1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDist = INT32_MAX;
+            for (int k = 0; k < 4; k++) {
+                int dr = block[i][0] - palette[k][0];
+                int dg = block[i][1] - palette[k][1];
+                int db = block[i][2] - palette[k][2];
+                int dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = k;
+                }
+            }
+            indices |= (uint32_t)best << (i * 2);
+        }
+    }
+    for (int i = 0; i < 4; i++) out[4 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+void encodeAlphaBlock(const Block& block, uint8_t* out) {
+    uint8_t a0 = 0, a1 = 255;
+    for (const auto& p : block) {
+        a0 = std::max(a0, p[3]);
+        a1 = std::min(a1, p[3]);
+    }
+    out[0] = a0;
+    out[1] = a1;
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        // a0 > a1: modo de 8 niveis (indice 0 = a0, 1 = a1, 2..7 interpolados)
+        int palette[8] = {a0, a1};
+        for (int k = 1; k <= 6; k++) palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDist = INT32_MAX;
+            for (int k = 0; k < 8; k++) {
+                int dist = std::abs(block[i][3] - palette[k]);
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = k;
+                }
+            }
+            indices |= (uint64_t)best << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+// Media 2x2; dimensoes impares repetem a ultima coluna/linha
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& src, uint32_t width, uint32_t height,
+                                uint32_t& outWidth, uint32_t& outHeight) {
+    outWidth = std::max(1u, width / 2);
+    outHeight = std::max(1u, height / 2);
+    std::vector<uint8_t> dst((size_t)outWidth * outHeight * 4);
+
+    for (uint32_t y = 0; y < outHeight; y++) {
+        uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < outWidth; x++) {
+            uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < 4; c++) {
+                int sum = src[((size_t)y0 * width + x0) * 4 + c] +
+                          src[((size_t)y0 * width + x1) * 4 + c] +
+                          src[((size_t)y1 * width + x0) * 4 + c] +
+                          src[((size_t)y1 * width + x1) * 4 + c];
+                dst[((size_t)y * outWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+const char* formatName(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::BC1:
+        return "BC1";
+    case TextureFormat::BC3:
+        return "BC3";
+    default:
+        return "RGBA8";
+    }
+}
+
+} // namespace
+
+namespace TextureBaker {
+
+void encodeBC1(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    size_t base = out.size();
+    out.resize(base + (size_t)blocksX * blocksY * 8);
+
+    Block block;
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            fetchBlock(rgba, width, height, bx, by, block);
+            encodeColorBlock(block, &out[base + ((size_t)by * blocksX + bx) * 8]);
+        }
+    }
+}
+
+void encodeBC3(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    size_t base = out.size();
+    out.resize(base + (size_t)blocksX * blocksY * 16);
+
+    Block block;
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            fetchBlock(rgba, width, height, bx, by, block);
+            uint8_t* dst = &out[base + ((size_t)by * blocksX + bx) * 16];
+            encodeAlphaBlock(block, dst);
+            encodeColorBlock(block, dst + 8);
+        }
+    }
+}
+
+bool bake(const std::string& sourcePath, const std::string& outputPath,
+          const BakeOptions& options) {
+    int w, h, channels;
+    unsigned char* pixels = stbi_load(sourcePath.c_str(), &w, &h, &channels, 4);
+    if (!pixels) {
+        std::cerr << "Failed to load texture for baking: " << sourcePath << std::endl;
+        return false;
+    }
+
+    uint32_t width = (uint32_t)w, height = (uint32_t)h;
+    std::vector<uint8_t> level(pixels, pixels + (size_t)width * height * 4);
+    stbi_image_free(pixels);
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < level.size() && !hasAlpha; i += 4) hasAlpha = level[i] != 255;
+
+    TextureFileHeader header;
+    header.format = !options.compress ? TextureFormat::RGBA8
+                    : hasAlpha        ? TextureFormat::BC3
+                                      : TextureFormat::BC1;
+    header.width = width;
+    header.height = height;
+
+    std::vector<TextureMipEntry> mips;
+    std::vector<uint8_t> payload;
+    uint32_t mipWidth = width, mipHeight = height;
+    while (mips.size() < TEXTURE_MAX_MIPS) {
+        TextureMipEntry mip;
+        mip.offset = (uint32_t)payload.size();
+        mip.width = mipWidth;
+        mip.height = mipHeight;
+
+        if (header.format == TextureFormat::BC1) {
+            encodeBC1(level.data(), mipWidth, mipHeight, payload);
+        } else if (header.format == TextureFormat::BC3) {
+            encodeBC3(level.data(), mipWidth, mipHeight, payload);
+        } else {
+            payload.insert(payload.end(), level.begin(), level.end());
+        }
+        mip.size = (uint32_t)payload.size() - mip.offset;
+        mips.push_back(mip);
+
+        if (!options.mipmaps || (mipWidth == 1 && mipHeight == 1)) break;
+        level = downsample(level, mipWidth, mipHeight, mipWidth, mipHeight);
+    }
+    header.mipCount = (uint32_t)mips.size();
+
+    // Offsets relativos ao payload viram absolutos
+    uint32_t dataStart = sizeof(TextureFileHeader) + header.mipCount * sizeof(TextureMipEntry);
+    for (auto& mip : mips) mip.offset += dataStart;
+
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output) {
+        std::cerr << "Failed to write baked texture: " << outputPath << std::endl;
+        return false;
+    }
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(mips.data()), mips.size() * sizeof(TextureMipEntry));
+    output.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+    std::cout << "Baked " << sourcePath << " -> " << outputPath << " (" << formatName(header.format)
+              << ", " << width << "x" << height << ", " << header.mipCount << " mips, "
+              << payload.size() / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+} // namespace TextureBaker
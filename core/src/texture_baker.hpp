@@ -0,0 +1,30 @@
+#ifndef TEXTURE_BAKER_HPP
+#define TEXTURE_BAKER_HPP
+
+#include "texture_format.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Offline side of the .ytex pipeline, linked only into scene_compiler. Decodes
+// the source image once, builds the full box-filtered mip chain and encodes
+// every level to BC1 (opaque) or BC3 (with alpha) on the CPU, so the runtime
+// only has to read the file and hand each level to the driver.
+namespace TextureBaker {
+
+struct BakeOptions {
+    bool compress = true; // false grava RGBA8 (fallback sem compressao)
+    bool mipmaps = true;
+};
+
+// Le sourcePath (qualquer formato do stb_image) e grava o .ytex em outputPath
+bool bake(const std::string& sourcePath, const std::string& outputPath,
+          const BakeOptions& options = BakeOptions());
+
+// Blocos 4x4 em ordem de linha; bordas parciais repetem o ultimo pixel
+void encodeBC1(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out);
+void encodeBC3(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out);
+
+} // namespace TextureBaker
+
+#endif // TEXTURE_BAKER_HPP
@@ -0,0 +1,53 @@
+#ifndef TEXTURE_FORMAT_HPP
+#define TEXTURE_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+
+// Layout do .ytex gerado pelo scene_compiler: cabecalho, tabela de mips e os
+// payloads em seguida, prontos para subir direto na GPU (mip 0 primeiro).
+enum class TextureFormat : uint32_t {
+    RGBA8 = 0, // fallback sem compressao
+    BC1 = 1,   // RGB, 8 bytes por bloco 4x4
+    BC3 = 2,   // RGBA, 16 bytes por bloco 4x4
+};
+
+constexpr uint32_t TEXTURE_FILE_MAGIC = 0x58455459; // "YTEX"
+constexpr uint32_t TEXTURE_FILE_VERSION = 1;
+constexpr uint32_t TEXTURE_MAX_MIPS = 16;
+
+struct TextureFileHeader {
+    uint32_t magic = TEXTURE_FILE_MAGIC;
+    uint32_t version = TEXTURE_FILE_VERSION;
+    TextureFormat format = TextureFormat::RGBA8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipCount = 0;
+};
+
+struct TextureMipEntry {
+    uint32_t offset; // a partir do inicio do arquivo
+    uint32_t size;
+    uint32_t width;
+    uint32_t height;
+};
+
+inline bool isBlockCompressed(TextureFormat format) { return format != TextureFormat::RGBA8; }
+
+inline uint32_t textureMipSize(TextureFormat format, uint32_t width, uint32_t height) {
+    if (!isBlockCompressed(format)) return width * height * 4;
+    uint32_t blocks = ((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == TextureFormat::BC1 ? 8 : 16);
+}
+
+// "textures/foo.png" -> "textures/foo.ytex"
+inline std::string bakedTexturePath(const std::string& sourcePath) {
+    size_t dot = sourcePath.find_last_of('.');
+    size_t slash = sourcePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".ytex";
+    }
+    return sourcePath.substr(0, dot) + ".ytex";
+}
+
+#endif // TEXTURE_FORMAT_HPP
@@ -0,0 +1,184 @@
+#define CLASS_NAME "TextureManager"
+#include "log_macros.hpp"
+
+#include "renderer/renderer_backend.hpp"
+#include "stats.hpp"
+#include "texture_manager.hpp"
+#include <utility>
+
+TextureHandle::TextureHandle(TextureManager* manager, uint32_t id) : manager(manager), id(id) {
+    if (manager && id) manager->addRef(id);
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other)
+    : TextureHandle(other.manager, other.id) {}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+    : manager(other.manager), id(other.id) {
+    other.manager = nullptr;
+    other.id = 0;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle other) noexcept {
+    std::swap(manager, other.manager);
+    std::swap(id, other.id);
+    return *this;
+}
+
+TextureHandle::~TextureHandle() { reset(); }
+
+void TextureHandle::reset() {
+    if (manager && id) manager->release(id);
+    manager = nullptr;
+    id = 0;
+}
+
+TextureManager::~TextureManager() { clear(); }
+
+std::string TextureManager::makeKey(const std::string& path, const SamplerDesc& sampler) {
+    return path + '#' + std::to_string(sampler.key());
+}
+
+TextureHandle TextureManager::acquire(const std::string& path, const SamplerDesc& sampler) {
+    std::string key = makeKey(path, sampler);
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        return TextureHandle(this, it->second);
+    }
+
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        entries.emplace_back();
+        id = (uint32_t)entries.size();
+    }
+
+    Entry& entry = entries[id - 1];
+    entry = Entry();
+    entry.path = path;
+    entry.sampler = sampler;
+    entry.inUse = true;
+    lookup.emplace(std::move(key), id);
+
+    makeResident(id);
+    return TextureHandle(this, id);
+}
+
+unsigned int TextureManager::resolve(uint32_t id) {
+    if (id == 0 || id > entries.size() || !entries[id - 1].inUse) return 0;
+
+    Entry& entry = entries[id - 1];
+    if (!entry.backendTexture && !entry.failed) {
+        LOG_DEBUG("Reloading evicted texture: %s", entry.path.c_str());
+        makeResident(id);
+    }
+    entry.lastUse = ++useClock;
+    return entry.backendTexture;
+}
+
+void TextureManager::makeResident(uint32_t id) {
+    Entry& entry = entries[id - 1];
+    if (!backend || entry.backendTexture) return;
+
+    entry.backendTexture = backend->loadTexture(entry.path, entry.sampler);
+    entry.failed = entry.backendTexture == 0;
+    entry.bytes = entry.backendTexture ? backend->getTextureBytes(entry.backendTexture) : 0;
+    entry.lastUse = ++useClock;
+    residentBytes += entry.bytes;
+
+    enforceBudget(id);
+    publishStats();
+}
+
+void TextureManager::evict(Entry& entry) {
+    if (!entry.backendTexture) return;
+    if (backend) backend->deleteTexture(entry.backendTexture);
+    residentBytes -= entry.bytes;
+    entry.backendTexture = 0;
+    entry.bytes = 0;
+}
+
+void TextureManager::destroy(uint32_t id) {
+    Entry& entry = entries[id - 1];
+    evict(entry);
+    lookup.erase(makeKey(entry.path, entry.sampler));
+    entry = Entry();
+    freeIds.push_back(id);
+}
+
+void TextureManager::enforceBudget(uint32_t keepId) {
+    while (budget > 0 && residentBytes > budget) {
+        // Menor lastUse vence; sem referencias tem prioridade sobre as em uso
+        Entry* victim = nullptr;
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            Entry& entry = entries[i];
+            if (i + 1 == keepId || !entry.backendTexture) continue;
+            bool unused = entry.refCount == 0;
+            bool victimUnused = victim && victim->refCount == 0;
+            if (!victim || unused > victimUnused ||
+                (unused == victimUnused && entry.lastUse < victim->lastUse)) {
+                victim = &entry;
+            }
+        }
+        if (!victim) {
+            LOG_WARN("Texture budget of %zu bytes exceeded by a single texture (%zu bytes)",
+                     budget, residentBytes);
+            break;
+        }
+
+        LOG_DEBUG("Evicting texture %s (%zu bytes)", victim->path.c_str(), victim->bytes);
+        evict(*victim);
+        Stats::add(Stat::TEXTURE_EVICTIONS);
+    }
+}
+
+void TextureManager::addRef(uint32_t id) {
+    if (id <= entries.size()) entries[id - 1].refCount++;
+}
+
+void TextureManager::release(uint32_t id) {
+    if (id <= entries.size() && entries[id - 1].refCount > 0) entries[id - 1].refCount--;
+}
+
+void TextureManager::purgeUnused() {
+    size_t before = residentBytes;
+    for (uint32_t id = 1; id <= entries.size(); id++) {
+        if (entries[id - 1].inUse && entries[id - 1].refCount == 0) destroy(id);
+    }
+    if (before != residentBytes) {
+        LOG_INFO("Purged unused textures: %zu -> %zu bytes resident", before, residentBytes);
+    }
+    publishStats();
+}
+
+void TextureManager::clear() {
+    for (auto& entry : entries) evict(entry);
+    backend = nullptr; // nada mais recarrega depois daqui
+    publishStats();
+}
+
+void TextureManager::updateTextureBytes(unsigned int backendTexture, size_t bytes) {
+    if (!backendTexture) return;
+    for (uint32_t id = 1; id <= entries.size(); id++) {
+        Entry& entry = entries[id - 1];
+        if (entry.backendTexture != backendTexture) continue;
+
+        residentBytes = residentBytes - entry.bytes + bytes;
+        entry.bytes = bytes;
+        enforceBudget(id);
+        publishStats();
+        return;
+    }
+}
+
+void TextureManager::setBudget(size_t bytes) {
+    budget = bytes;
+    enforceBudget(0);
+    publishStats();
+}
+
+void TextureManager::publishStats() const {
+    Stats::set(Stat::TEXTURE_RESIDENT_BYTES, (int64_t)residentBytes);
+}
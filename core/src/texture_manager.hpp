@@ -0,0 +1,104 @@
+#ifndef TEXTURE_MANAGER_HPP
+#define TEXTURE_MANAGER_HPP
+
+#include "renderer/sampler_desc.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RendererBackend;
+class TextureManager;
+
+// Counted reference to a TextureManager entry. Copies share the entry; the last
+// one to go away makes it unused, and purgeUnused() frees it on the GPU.
+class TextureHandle {
+  private:
+    TextureManager* manager = nullptr;
+    uint32_t id = 0;
+
+    friend class TextureManager;
+    TextureHandle(TextureManager* manager, uint32_t id); // soma uma referencia
+
+  public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(TextureHandle other) noexcept;
+    ~TextureHandle();
+
+    void reset();
+    // Estavel enquanto houver referencia; o backend troca por resolve() no draw
+    uint32_t getId() const { return id; }
+    explicit operator bool() const { return id != 0; }
+};
+
+// Loads each (path, sampler) pair once and hands out counted handles to it.
+// Resident textures are tracked against a byte budget: when a load would go
+// over it, the least recently drawn textures are deleted from the GPU (unused
+// ones first) and transparently reloaded by resolve() the next time they are
+// drawn. Not thread-safe: acquire/release run during scene load and resolve
+// during drawing, which the render thread never overlaps.
+class TextureManager {
+  private:
+    struct Entry {
+        std::string path;
+        SamplerDesc sampler;
+        unsigned int backendTexture = 0; // 0 = despejada
+        size_t bytes = 0;
+        uint32_t refCount = 0;
+        uint64_t lastUse = 0;
+        bool inUse = false; // slot ocupado (vivo ou so sem referencias)
+        bool failed = false; // o backend nao carregou; resolve() nao tenta de novo
+    };
+
+    RendererBackend* backend = nullptr;
+    std::vector<Entry> entries; // id = indice + 1
+    std::unordered_map<std::string, uint32_t> lookup;
+    std::vector<uint32_t> freeIds;
+    size_t residentBytes = 0;
+    size_t budget = 0; // 0 = sem limite
+    uint64_t useClock = 0;
+
+    friend class TextureHandle;
+    void addRef(uint32_t id);
+    void release(uint32_t id);
+
+    static std::string makeKey(const std::string& path, const SamplerDesc& sampler);
+    void makeResident(uint32_t id);
+    void evict(Entry& entry);
+    void destroy(uint32_t id);
+    void enforceBudget(uint32_t keepId);
+    void publishStats() const;
+
+  public:
+    TextureManager() = default;
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+    ~TextureManager();
+
+    void setRendererBackend(RendererBackend* rendererBackend) { backend = rendererBackend; }
+
+    // Carrega na hora se ainda nao existe; repete o mesmo handle para o mesmo par
+    TextureHandle acquire(const std::string& path, const SamplerDesc& sampler = SamplerDesc());
+    // Textura do backend para o id, recarregando se foi despejada (0 = sem textura)
+    unsigned int resolve(uint32_t id);
+
+    // Libera da GPU tudo que nao tem mais handles (chamar depois de trocar de cena)
+    void purgeUnused();
+    // Apaga todas as texturas do backend; handles vivos passam a resolver para 0
+    void clear();
+
+    // Textura do backend cresceu (mips chegando por streaming); reaplica o orcamento
+    void updateTextureBytes(unsigned int backendTexture, size_t bytes);
+    // Se mais `bytes` cabem sem despejar nada
+    bool hasBudgetFor(size_t bytes) const { return budget == 0 || residentBytes + bytes <= budget; }
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return budget; }
+    size_t getResidentBytes() const { return residentBytes; }
+    size_t getTextureCount() const { return lookup.size(); }
+};
+
+#endif // TEXTURE_MANAGER_HPP
@@ -0,0 +1,140 @@
+#define CLASS_NAME "TextureStreamer"
+#include "log_macros.hpp"
+
+#include "stats.hpp"
+#include "texture_manager.hpp"
+#include "texture_streamer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+TextureStreamer::~TextureStreamer() {
+    // O JobSystem pode ja ter sido destruido; o shutdown dele roda a fila ate o fim
+    while (!jobs.isDone()) {
+        std::this_thread::yield();
+    }
+}
+
+void TextureStreamer::read(Request* request) {
+    request->faces.resize(request->paths.size());
+    request->ok = true;
+    for (size_t i = 0; i < request->paths.size() && request->ok; i++) {
+        request->ok = request->faces[i].loadLevels(request->paths[i], request->first, request->end);
+    }
+
+    TextureStreamer* streamer = request->streamer;
+    std::lock_guard<std::mutex> lock(streamer->completedMutex);
+    streamer->completed.push_back(request);
+}
+
+void TextureStreamer::track(unsigned int texture, const std::vector<std::string>& bakedPaths,
+                            const BakedTexture* tails, size_t faceCount) {
+    if (!texture || faceCount == 0) return;
+
+    State state;
+    state.paths = bakedPaths;
+    state.width = tails[0].width;
+    state.height = tails[0].height;
+    state.levelBytes.assign(tails[0].mips.size(), 0);
+    for (size_t face = 0; face < faceCount; face++) {
+        for (size_t level = 0; level < tails[face].mips.size(); level++) {
+            state.levelBytes[level] += tails[face].mips[level].size;
+        }
+    }
+    state.residentLevel = tails[0].firstLevel;
+    states[texture] = std::move(state);
+}
+
+void TextureStreamer::forget(unsigned int texture) {
+    auto it = states.find(texture);
+    if (it == states.end()) return;
+    if (it->second.pending) pendingBytes -= it->second.pending->bytes;
+    states.erase(it);
+}
+
+void TextureStreamer::request(unsigned int texture, float screenSize) {
+    auto it = states.find(texture);
+    if (it == states.end() || screenSize <= 0.0f) return;
+    State& state = it->second;
+    if (state.pending || state.residentLevel == 0) return;
+
+    // Um texel por pixel: cada mip abaixo da metade do tamanho na tela sobra
+    float texels = (float)std::max(state.width, state.height);
+    int wanted = (int)std::floor(std::log2(texels / screenSize));
+    uint32_t first = (uint32_t)std::max(wanted, 0);
+    if (first >= state.residentLevel) return;
+
+    // Sem espaco no orcamento para tudo, fica com o que couber
+    size_t bytes = 0;
+    for (uint32_t level = first; level < state.residentLevel; level++) {
+        bytes += state.levelBytes[level];
+    }
+    while (first < state.residentLevel && textureManager &&
+           !textureManager->hasBudgetFor(pendingBytes + bytes)) {
+        bytes -= state.levelBytes[first++];
+    }
+    if (first >= state.residentLevel) return;
+
+    auto owned = std::make_unique<Request>();
+    Request* request = owned.get();
+    request->texture = texture;
+    request->paths = state.paths;
+    request->first = first;
+    request->end = state.residentLevel;
+    request->bytes = bytes;
+    request->streamer = this;
+    inFlight.push_back(std::move(owned));
+    state.pending = request;
+    pendingBytes += bytes;
+
+    LOG_DEBUG("Streaming mips %u-%u of texture %u (%zu bytes)", request->first, request->end - 1,
+              texture, bytes);
+    if (jobSystem) {
+        jobSystem->run([request]() { read(request); }, &jobs);
+    } else {
+        read(request);
+    }
+}
+
+void TextureStreamer::poll(std::vector<Levels>& out) {
+    std::vector<Request*> done;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        done.swap(completed);
+    }
+
+    for (Request* request : done) {
+        auto it = states.find(request->texture);
+        if (it != states.end() && it->second.pending == request) {
+            State& state = it->second;
+            state.pending = nullptr;
+            pendingBytes -= request->bytes;
+
+            // O arquivo pode ter sido rebakeado desde o load
+            bool ok = request->ok;
+            for (const auto& face : request->faces) {
+                ok = ok && face.width == state.width && face.height == state.height &&
+                     face.mips.size() == state.levelBytes.size();
+            }
+
+            if (ok) {
+                state.residentLevel = request->first;
+                Levels levels;
+                levels.texture = request->texture;
+                levels.firstLevel = request->first;
+                levels.faces = std::move(request->faces);
+                out.push_back(std::move(levels));
+                Stats::add(Stat::TEXTURE_STREAMED_BYTES, (int64_t)request->bytes);
+            } else {
+                // Para de tentar; fica com os mips que ja estao na GPU
+                LOG_WARN("Failed to stream mips of %s", request->paths[0].c_str());
+                states.erase(it);
+            }
+        }
+
+        inFlight.erase(std::find_if(inFlight.begin(), inFlight.end(),
+                                    [request](const std::unique_ptr<Request>& owned) {
+                                        return owned.get() == request;
+                                    }));
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef TEXTURE_STREAMER_HPP
+#define TEXTURE_STREAMER_HPP
+
+#include "baked_texture.hpp"
+#include "job_system.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureManager;
+
+// Streams the fine mips of baked textures in the background. A backend creates
+// the texture from the small tail of its .ytex (see BakedTexture::loadTail),
+// registers it with track() and clamps sampling to the resident levels. While
+// drawing it reports how many pixels the texture covers on screen; request()
+// turns that into a mip level and reads the missing levels on the job system,
+// and poll() hands them back on the thread that owns the graphics context so
+// they can be uploaded and the clamp lowered. Reads are trimmed to fit the
+// TextureManager budget, so a full budget keeps textures blurry instead of
+// evicting others.
+class TextureStreamer {
+  public:
+    static constexpr uint32_t TAIL_SIZE = 64; // mips carregados na hora: ate 64x64
+
+    // Niveis [firstLevel, faces[i].levelEnd) lidos para uma textura
+    struct Levels {
+        unsigned int texture = 0;
+        uint32_t firstLevel = 0;
+        std::vector<BakedTexture> faces;
+    };
+
+  private:
+    struct Request {
+        unsigned int texture = 0;
+        std::vector<std::string> paths;
+        uint32_t first = 0;
+        uint32_t end = 0;
+        size_t bytes = 0;
+        std::vector<BakedTexture> faces;
+        bool ok = false;
+        TextureStreamer* streamer = nullptr;
+    };
+
+    struct State {
+        std::vector<std::string> paths; // .ytex de cada face (1 para 2D, 6 para cubemap)
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<size_t> levelBytes; // por nivel, somando as faces
+        uint32_t residentLevel = 0;     // mip mais fino ja na GPU
+        Request* pending = nullptr;
+    };
+
+    Yume::JobSystem* jobSystem = nullptr;
+    TextureManager* textureManager = nullptr;
+    std::unordered_map<unsigned int, State> states;
+    std::vector<std::unique_ptr<Request>> inFlight; // o job so guarda o ponteiro
+    size_t pendingBytes = 0;
+
+    std::mutex completedMutex;
+    std::vector<Request*> completed;
+    Yume::JobCounter jobs;
+
+    static void read(Request* request);
+    void track(unsigned int texture, const std::vector<std::string>& bakedPaths,
+               const BakedTexture* tails, size_t faceCount);
+
+  public:
+    TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    ~TextureStreamer();
+
+    // Sem job system as leituras rodam na hora, dentro de request()
+    void setJobSystem(Yume::JobSystem* jobs) { jobSystem = jobs; }
+    void setTextureManager(TextureManager* textures) { textureManager = textures; }
+
+    // `tail` e o que ja foi enviado para a GPU; o cubemap passa uma cauda por
+    // face, todas com a mesma cadeia
+    void track(unsigned int texture, const std::string& bakedPath, const BakedTexture& tail) {
+        track(texture, {bakedPath}, &tail, 1);
+    }
+    void track(unsigned int texture, const std::vector<std::string>& bakedPaths,
+               const std::vector<BakedTexture>& tails) {
+        track(texture, bakedPaths, tails.data(), tails.size());
+    }
+    // Textura apagada; uma leitura em andamento e descartada quando terminar
+    void forget(unsigned int texture);
+    bool isTracked(unsigned int texture) const { return states.count(texture) != 0; }
+
+    // A textura cobre ~screenSize pixels no maior lado; agenda os mips que faltam
+    void request(unsigned int texture, float screenSize);
+    // Thread da GPU: leituras concluidas desde a ultima chamada, ja contadas
+    // como residentes. O chamador sobe os niveis e baixa o BASE_LEVEL/minLod.
+    void poll(std::vector<Levels>& out);
+
+    size_t getPendingCount() const { return inFlight.size(); }
+};
+
+#endif // TEXTURE_STREAMER_HPP
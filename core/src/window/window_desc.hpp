@@ -1,6 +1,7 @@
 #ifndef WINDOW_DESC_HPP
 #define WINDOW_DESC_HPP
 
+#include "../present_mode.hpp"
 #include <string>
 
 struct WindowDesc {
@@ -8,6 +9,9 @@ struct WindowDesc {
     int width  = 800;
     int height = 600;
     unsigned int extraFlags = 0;
+    PresentMode presentMode = PresentMode::FIFO;
+    unsigned int swapchainImageCount = 0; // 0 = deixa o backend escolher
+    bool headless = false;                // sem janela, width x height offscreen
 };
 
 #endif
\ No newline at end of file
@@ -33,6 +33,16 @@ bool WindowManager::init(const WindowDesc& desc) {
         return false;
     }
 
+    renderer->getRendererBackend()->setPresentMode(desc.presentMode, desc.swapchainImageCount);
+
+    if (desc.headless) {
+        if (!renderer->initHeadless(desc.width, desc.height)) {
+            LOG_ERROR("Failed to initialize headless renderer!");
+            return false;
+        }
+        return true;
+    }
+
     unsigned int flags = SDL_WINDOW_SHOWN | desc.extraFlags |
                          renderer->getRendererBackend()->getRequiredWindowFlags();
 
@@ -0,0 +1,122 @@
+// Estresse do JobSystem: muito mais jobs que JOB_POOL_SIZE enquanto os outros
+// workers roubam, submetidos do main thread e de dentro de jobs (fan-out
+// aninhado). Cada job marca o proprio indice; no fim todos tem que ter rodado
+// exatamente uma vez.
+//
+// Uso: job_system_test [--workers N] [--jobs N] [--rounds N]
+#define CLASS_NAME "JobSystemTest"
+#include "log_macros.hpp"
+
+#include "job_system.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+struct Run {
+    std::unique_ptr<std::atomic<int>[]> hits;
+    size_t count = 0;
+
+    explicit Run(size_t jobCount) : hits(new std::atomic<int>[jobCount]), count(jobCount) {
+        for (size_t i = 0; i < count; i++) hits[i].store(0, std::memory_order_relaxed);
+    }
+
+    size_t countWrong() const {
+        size_t wrong = 0;
+        for (size_t i = 0; i < count; i++) {
+            int n = hits[i].load(std::memory_order_relaxed);
+            if (n != 1) {
+                if (wrong < 8) std::printf("  job %zu ran %d time(s)\n", i, n);
+                wrong++;
+            }
+        }
+        return wrong;
+    }
+};
+
+// Um pouco de trabalho para o dono nao esvaziar o deque antes dos ladroes
+void spin(size_t i) {
+    volatile size_t x = i;
+    for (int k = 0; k < 16; k++) x = x * 31 + 7;
+}
+
+size_t flatFanOut(Yume::JobSystem& jobs, size_t jobCount) {
+    Run run(jobCount);
+    Yume::JobCounter counter;
+    std::atomic<int>* hits = run.hits.get();
+    for (size_t i = 0; i < jobCount; i++) {
+        jobs.run([hits, i]() {
+            spin(i);
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }, &counter);
+    }
+    jobs.wait(counter);
+    return run.countWrong();
+}
+
+// Cada job de fora gera `inner` jobs no deque do worker que o executa
+size_t nestedFanOut(Yume::JobSystem& jobs, size_t jobCount) {
+    const size_t inner = 512;
+    size_t outer = (jobCount + inner - 1) / inner;
+    Run run(outer * inner);
+
+    struct Context {
+        Yume::JobSystem* jobs;
+        std::atomic<int>* hits;
+        Yume::JobCounter counter;
+    } context{&jobs, run.hits.get(), {}};
+
+    Context* ctx = &context;
+    for (size_t o = 0; o < outer; o++) {
+        jobs.run([ctx, o, inner]() {
+            for (size_t j = 0; j < inner; j++) {
+                size_t i = o * inner + j;
+                ctx->jobs->run([ctx, i]() {
+                    spin(i);
+                    ctx->hits[i].fetch_add(1, std::memory_order_relaxed);
+                }, &ctx->counter);
+            }
+        }, &context.counter);
+    }
+    jobs.wait(context.counter);
+    return run.countWrong();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t workerCount = 4;
+    size_t jobCount = 200000;
+    int rounds = 5;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workerCount = (size_t)std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobCount = (size_t)std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        }
+    }
+
+    Yume::JobSystem jobs;
+    jobs.init(workerCount);
+
+    size_t failures = 0;
+    for (int r = 0; r < rounds; r++) {
+        size_t flat = flatFanOut(jobs, jobCount);
+        size_t nested = nestedFanOut(jobs, jobCount);
+        std::printf("round %d: flat %zu wrong, nested %zu wrong\n", r, flat, nested);
+        failures += flat + nested;
+    }
+
+    jobs.shutdown();
+    if (failures > 0) {
+        std::printf("FAILED: %zu job(s) did not run exactly once\n", failures);
+        return 1;
+    }
+    std::printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Todas as luzes da cena (LightBuffer no CPU), enviadas uma vez por frame.
+// Direcionais vem primeiro: LightCounts.y delas, depois point e spot.
+#ifndef SCENE_LIGHTS_HLSLI
+#define SCENE_LIGHTS_HLSLI
+
+// LightBuffer::MAX_LIGHTS; o limite do arquivo de cena (MAX_SCENE_LIGHTS) e outro
+#define LIGHT_BUFFER_MAX_LIGHTS 128
+#define MAX_SHADOW_CASCADES 4
+
+struct SceneLight {
+    float4 directionType; // direcao (mundo), tipo: 0 direcional, 1 point, 2 spot
+    float4 color;         // rgb, intensidade
+    float4 positionRange; // posicao (mundo), alcance
+    float4 cone;          // cos interno, cos externo
+};
+
+cbuffer LightData : register(b2) {
+    uint4 LightCounts; // total, direcionais
+    float4x4 ShadowMatrices[MAX_SHADOW_CASCADES]; // view-projection da luz, por cascata
+    float4 CascadeSplits; // profundidade (view space) onde cada cascata termina
+    float4 ShadowParams;  // cascatas, bias, 1 / tamanho do mapa, indice da luz
+    SceneLight Lights[LIGHT_BUFFER_MAX_LIGHTS];
+};
+
+// Uma camada por cascata (ShadowCascades no CPU)
+Texture2DArray ShadowMap : register(t7);
+SamplerComparisonState ShadowSampler : register(s7);
+
+// 1 = iluminado, 0 = na sombra de Lights[ShadowParams.w]. viewDepth e a
+// profundidade positiva em view space; as matrizes seguem a convencao GL.
+float CascadedShadow(float3 worldPosition, float viewDepth) {
+    uint count = (uint)ShadowParams.x;
+    if (count == 0 || viewDepth > CascadeSplits[count - 1]) return 1.0;
+
+    uint cascade = 0;
+    while (cascade + 1 < count && viewDepth > CascadeSplits[cascade]) cascade++;
+
+    float4 clip = mul(ShadowMatrices[cascade], float4(worldPosition, 1.0));
+    float3 ndc = clip.xyz / clip.w;
+    float2 uv = ndc.xy * 0.5 + 0.5;
+    float depth = ndc.z * 0.5 + 0.5 - ShadowParams.y;
+
+    // PCF 3x3 por cima do 2x2 que o sampler de comparacao ja faz
+    float lit = 0.0;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            float2 offset = float2(x, y) * ShadowParams.z;
+            lit += ShadowMap.SampleCmpLevelZero(ShadowSampler, float3(uv + offset, cascade), depth);
+        }
+    }
+    return lit / 9.0;
+}
+
+// Lambert de todas as direcionais, com a sombra na que projeta; point e spot
+// vem de ClusteredLighting
+float3 DirectionalLighting(float3 worldNormal, float3 worldPosition, float viewDepth) {
+    float3 normal = normalize(worldNormal);
+    float3 result = float3(0.0, 0.0, 0.0);
+    for (uint i = 0; i < LightCounts.y; i++) {
+        SceneLight light = Lights[i];
+        float diffuse = saturate(dot(normal, -normalize(light.directionType.xyz)));
+        if ((float)i == ShadowParams.w) diffuse *= CascadedShadow(worldPosition, viewDepth);
+        result += light.color.rgb * light.color.w * diffuse;
+    }
+    return result;
+}
+
+#endif // SCENE_LIGHTS_HLSLI